@@ -0,0 +1,79 @@
+// Times GeometryHelpers::packTriangleAdjacency on grid meshes of increasing size. The edge hash build should keep the
+// time per triangle roughly flat as the triangle count grows.
+
+#include "GeometryHelpers.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr int NumRepeats = 3;
+
+/// Grid of size x size quads split into two triangles each, vertices are shared between neighboring quads
+void CreateGrid(const uint32_t &size, std::vector<star::Vertex> &verts, std::vector<uint32_t> &indices)
+{
+    const uint32_t rowLength = size + 1;
+
+    verts.clear();
+    verts.reserve(rowLength * rowLength);
+    for (uint32_t y = 0; y < rowLength; y++)
+    {
+        for (uint32_t x = 0; x < rowLength; x++)
+        {
+            star::Vertex vertex;
+            vertex.pos = glm::vec3{static_cast<float>(x), static_cast<float>(y), 0.0f};
+            verts.push_back(vertex);
+        }
+    }
+
+    indices.clear();
+    indices.reserve(size * size * 6);
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            const uint32_t corner = y * rowLength + x;
+            indices.insert(indices.end(), {corner, corner + 1, corner + rowLength});
+            indices.insert(indices.end(), {corner + 1, corner + rowLength + 1, corner + rowLength});
+        }
+    }
+}
+} // namespace
+
+int main()
+{
+    std::cout << std::setw(12) << "triangles" << std::setw(14) << "best ms" << std::setw(16) << "ns/triangle"
+              << std::endl;
+
+    std::vector<star::Vertex> verts;
+    std::vector<uint32_t> source;
+    std::vector<uint32_t> indices;
+    for (uint32_t size = 32; size <= 1024; size *= 2)
+    {
+        CreateGrid(size, verts, source);
+        const size_t numTriangles = source.size() / 3;
+
+        double bestMs = 0.0;
+        for (int repeat = 0; repeat < NumRepeats; repeat++)
+        {
+            indices = source;
+
+            const auto start = std::chrono::steady_clock::now();
+            star::GeometryHelpers::packTriangleAdjacency(verts, indices);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            bestMs = repeat == 0 ? elapsed.count() : std::min(bestMs, elapsed.count());
+        }
+
+        std::cout << std::setw(12) << numTriangles << std::setw(14) << std::fixed << std::setprecision(3) << bestMs
+                  << std::setw(16) << std::setprecision(1) << bestMs * 1.0e6 / static_cast<double>(numTriangles)
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Measures the bytes staged per frame for the instance model and normal buffers as a growing share of the instances
+// moves each frame. Staged bytes should follow the number of moved instances rather than the size of the buffers.
+
+#include "TransferRequest_InstanceModelInfo.hpp"
+#include "TransferRequest_InstanceNormalInfo.hpp"
+#include "data_structure/InstanceSlotTracker.hpp"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr size_t NumInstances = 100000;
+constexpr int NumFrames = 16;
+
+struct Scenario
+{
+    const char *name;
+    size_t numMoved;
+    bool isScattered;
+};
+
+/// Average bytes staged per frame for both instance buffers when numMoved instances change every frame
+double MeasureStagedBytesPerFrame(const Scenario &scenario, std::vector<star::StarEntity> &instances,
+                                  const std::vector<uint32_t> &visibleInstances)
+{
+    star::data_structure::InstanceSlotTracker slots;
+    slots.resize(1);
+
+    // first upload writes everything, it is not part of the measurement
+    slots.takeDirtySlots(0, visibleInstances);
+
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<size_t> pickInstance(0, instances.size() - 1);
+
+    size_t totalBytes = 0;
+    for (int frame = 0; frame < NumFrames; frame++)
+    {
+        for (size_t i = 0; i < scenario.numMoved; i++)
+        {
+            const size_t index = scenario.isScattered ? pickInstance(random) : i;
+            instances[index].moveRelative(glm::vec3{0.0f, 0.01f, 0.0f});
+            slots.markInstanceDirty(index);
+        }
+
+        if (!slots.needsUpload(0, visibleInstances))
+        {
+            continue;
+        }
+
+        const auto dirtySlots = slots.takeDirtySlots(0, visibleInstances);
+        const star::TransferRequest::InstanceModelInfo model(instances, visibleInstances, 0, dirtySlots);
+        const star::TransferRequest::InstanceNormalInfo normal(instances, visibleInstances, 0, dirtySlots);
+        totalBytes += model.getStagingLayout()->size + normal.getStagingLayout()->size;
+    }
+
+    return static_cast<double>(totalBytes) / NumFrames;
+}
+} // namespace
+
+int main()
+{
+    std::vector<star::StarEntity> instances(NumInstances);
+    std::vector<uint32_t> visibleInstances(NumInstances);
+    std::iota(visibleInstances.begin(), visibleInstances.end(), 0);
+
+    const double fullBytes = 2.0 * NumInstances * sizeof(glm::mat3x4);
+
+    const Scenario scenarios[] = {{"1 instance", 1, false},
+                                  {"1% contiguous", NumInstances / 100, false},
+                                  {"1% scattered", NumInstances / 100, true},
+                                  {"10% scattered", NumInstances / 10, true},
+                                  {"100%", NumInstances, false}};
+
+    std::cout << std::setw(16) << "moved" << std::setw(16) << "bytes/frame" << std::setw(14) << "% of full"
+              << std::endl;
+
+    for (const auto &scenario : scenarios)
+    {
+        const double bytes = MeasureStagedBytesPerFrame(scenario, instances, visibleInstances);
+        std::cout << std::setw(16) << scenario.name << std::setw(16) << std::fixed << std::setprecision(0) << bytes
+                  << std::setw(14) << std::setprecision(2) << 100.0 * bytes / fullBytes << std::endl;
+    }
+
+    return 0;
+}
@@ -77,7 +77,8 @@ template <InitLike TEngineInitPolicy, LoopLike TMainLoopPolicy, ExitLike TEngine
             }
         }
 
-        std::set<Rendering_Device_Features> renderingFeatures{Rendering_Device_Features::timeline_semaphores};
+        std::set<Rendering_Device_Features> renderingFeatures{Rendering_Device_Features::timeline_semaphores,
+                                                             Rendering_Device_Features::draw_indirect_count};
 
         {
             uint8_t framesInFlight;
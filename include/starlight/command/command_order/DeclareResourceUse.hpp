@@ -0,0 +1,53 @@
+#pragma once
+
+#include "starlight/service/detail/command_order/ResourceUse.hpp"
+
+#include <star_common/Handle.hpp>
+#include <star_common/IServiceCommand.hpp>
+
+#include <string_view>
+
+namespace star::command_order
+{
+namespace declare_resource_use
+{
+inline constexpr const char *GetDeclareResourceUseCommandTypeName()
+{
+    return "coDecRes";
+}
+} // namespace declare_resource_use
+
+/// Declare an image or buffer read or written by a pass that was declared beforehand
+class DeclareResourceUse : public common::IServiceCommand
+{
+  public:
+    static inline constexpr std::string_view GetUniqueTypeName()
+    {
+        return declare_resource_use::GetDeclareResourceUseCommandTypeName();
+    }
+
+    DeclareResourceUse(Handle passHandle, star::service::command_order::ResourceUse use)
+        : m_passHandle(std::move(passHandle)), m_use(std::move(use))
+    {
+    }
+
+    DeclareResourceUse(uint16_t type, Handle passHandle, star::service::command_order::ResourceUse use)
+        : common::IServiceCommand(std::move(type)), m_passHandle(std::move(passHandle)), m_use(std::move(use))
+    {
+    }
+
+    const Handle &getPassHandle() const
+    {
+        return m_passHandle;
+    }
+
+    const star::service::command_order::ResourceUse &getUse() const
+    {
+        return m_use;
+    }
+
+  private:
+    Handle m_passHandle;
+    star::service::command_order::ResourceUse m_use;
+};
+} // namespace star::command_order
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "starlight/service/detail/command_order/EdgeDescription.hpp"
+#include "starlight/service/detail/command_order/ResourceUse.hpp"
 
 #include <star_common/Handle.hpp>
 #include <star_common/IServiceCommandWithReply.hpp>
@@ -27,6 +28,15 @@ struct GatheredPassInfo
     const uint32_t *queueFamilyIndex = nullptr;
     const std::vector<bool> *wasProcessedOnLastFrame = nullptr;
     const std::vector<star::service::command_order::EdgeDescription> *edges = nullptr;
+
+    /// Position of the pass in the compiled graph, which matches the order the command buffers are submitted in
+    uint32_t orderIndex{0};
+    /// None of the outputs of the pass are used, it does not need to be recorded or submitted
+    bool isCulled = false;
+    /// Barriers to record before the work of the pass
+    const std::vector<star::service::command_order::ResourceTransition> *acquireTransitions = nullptr;
+    /// Queue family releases to record after the work of the pass, for consumers on another queue family
+    const std::vector<star::service::command_order::ResourceTransition> *releaseTransitions = nullptr;
 };
 } // namespace get_pass_info
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "common/helpers/FileHelpers.hpp"
+#include "enums/Enums.hpp"
 #include "shaderc/shaderc.hpp"
 
 #include <exception>
@@ -24,10 +25,29 @@ class Compiler
     {
     }
 
+    const std::string &getPrecompilerMacros() const
+    {
+        return m_precompilerMacros;
+    }
+
     // compile provided shader to spirv
-    std::vector<uint32_t> compile(const std::string &pathToFile, bool optimize);
+    std::vector<uint32_t> compile(const std::string &pathToFile, const Shader_Optimization &optimization);
+
+    // resolve includes and macros of the provided shader
+    std::string preprocess(const std::string &pathToFile);
+
+    // compile the output of preprocess for the provided shader to spirv
+    std::vector<uint32_t> compilePreprocessed(const std::string &pathToFile, const std::string &preprocessed,
+                                              const Shader_Optimization &optimization);
+
+    /// Key of the compiled code in a ShaderCache. Covers the preprocessed source, and with it every include, along with
+    /// each option which changes the compiled code.
+    std::string getCacheKey(const std::string &pathToFile, const std::string &preprocessed,
+                            const Shader_Optimization &optimization) const;
 
   private:
+    static constexpr shaderc_env_version TargetEnvironmentVersion = shaderc_env_version_vulkan_1_3;
+    static constexpr shaderc_spirv_version TargetSpirvVersion = shaderc_spirv_version_1_6;
     static bool compileDebug;
     std::string m_precompilerMacros;
 
@@ -38,7 +58,10 @@ class Compiler
     std::string preprocessShader(shaderc::Compiler &compiler, shaderc::CompileOptions options,
                                  const std::string &sourceName, shaderc_shader_kind stage, const std::string &source);
 
-    shaderc::CompileOptions getCompileOptions(const std::string &filePath);
+    shaderc::CompileOptions getCompileOptions(const std::string &filePath, const Shader_Optimization &optimization);
+
+    // run the spirv-opt pipeline over compiled code, the code is left as it was if the optimizer fails
+    static void runOptimizerPasses(const std::string &sourceName, std::vector<uint32_t> &code);
 };
 
 } // namespace star
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace star
+{
+/// Compiled SPIR-V kept on disk between runs. Entries are named by a hash of everything which decides the compiled
+/// code, so a changed source, include, macro or option simply misses and is never invalidated explicitly.
+///
+/// Entries are written to a temporary file and renamed into place, which lets several processes share one directory.
+/// Once the directory grows past its limit the entries used longest ago are removed. Failures to read or write are
+/// logged and treated as a miss, the cache never fails a compile.
+class ShaderCache
+{
+  public:
+    /// A limit of zero disables the cache
+    ShaderCache(std::filesystem::path directory, const uintmax_t &maxSizeBytes);
+
+    /// Cache shared by the engine, configured by shader_cache_dir and shader_cache_max_mb
+    static ShaderCache &Default();
+
+    /// Hash the provided parts into the name of an entry
+    static std::string CreateKey(const std::vector<std::string_view> &parts);
+
+    bool isEnabled() const
+    {
+        return m_maxSizeBytes != 0;
+    }
+
+    std::optional<std::vector<uint32_t>> load(const std::string &key) const;
+
+    void store(const std::string &key, const std::vector<uint32_t> &code);
+
+  private:
+    std::filesystem::path m_directory;
+    uintmax_t m_maxSizeBytes = 0;
+    std::mutex m_evictionMutex;
+
+    std::filesystem::path getEntryPath(const std::string &key) const;
+
+    void evict();
+};
+} // namespace star
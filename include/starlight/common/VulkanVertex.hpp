@@ -1,9 +1,12 @@
 #pragma once 
+#include "CompactVertex.hpp"
+#include "Enums.hpp"
 #include "Vertex.hpp"
 
 #include <vulkan/vulkan.hpp>
 
 #include <array> 
+#include <vector>
 namespace star {
     struct VulkanVertex {
         Vertex vertex;
@@ -111,4 +114,83 @@ namespace star {
             return attributeDescriptions;
         }
     };
+    /// <summary>
+    /// Vertex input description for star::Vertex_Layout::compact. Binding 0 holds CompactVertex entries, binding 1
+    /// holds a single VertexMaterialConstants entry placed after the vertices which every vertex reads (stride 0).
+    /// Locations match VulkanVertex.
+    /// </summary>
+    struct VulkanCompactVertex {
+        CompactVertex vertex;
+
+        static std::array<vk::VertexInputBindingDescription, 2> getBindingDescriptions() {
+            std::array<vk::VertexInputBindingDescription, 2> bindingDescriptions{};
+
+            bindingDescriptions[0].binding = 0;
+            bindingDescriptions[0].stride = sizeof(CompactVertex);
+            bindingDescriptions[0].inputRate = vk::VertexInputRate::eVertex;
+
+            //stride of 0 makes every vertex read the same material entry
+            bindingDescriptions[1].binding = 1;
+            bindingDescriptions[1].stride = 0;
+            bindingDescriptions[1].inputRate = vk::VertexInputRate::eVertex;
+
+            return bindingDescriptions;
+        }
+
+        static std::array<vk::VertexInputAttributeDescription, 10> getAttributeDescriptions() {
+            std::array<vk::VertexInputAttributeDescription, 10> attributeDescriptions{};
+
+            attributeDescriptions[0] = vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat, offsetof(CompactVertex, pos));
+            attributeDescriptions[1] = vk::VertexInputAttributeDescription(1, 0, vk::Format::eR16G16B16A16Snorm, offsetof(CompactVertex, normal));
+            attributeDescriptions[2] = vk::VertexInputAttributeDescription(2, 0, vk::Format::eR8G8B8A8Unorm, offsetof(CompactVertex, color));
+            attributeDescriptions[3] = vk::VertexInputAttributeDescription(3, 0, vk::Format::eR16G16Sfloat, offsetof(CompactVertex, texCoord));
+            attributeDescriptions[4] = vk::VertexInputAttributeDescription(4, 0, vk::Format::eR8G8B8A8Snorm, offsetof(CompactVertex, aTangent));
+            attributeDescriptions[5] = vk::VertexInputAttributeDescription(5, 0, vk::Format::eR8G8B8A8Snorm, offsetof(CompactVertex, aBitangent));
+
+            //material bindings
+            attributeDescriptions[6] = vk::VertexInputAttributeDescription(6, 1, vk::Format::eR32G32B32Sfloat, offsetof(VertexMaterialConstants, matAmbient));
+            attributeDescriptions[7] = vk::VertexInputAttributeDescription(7, 1, vk::Format::eR32G32B32Sfloat, offsetof(VertexMaterialConstants, matDiffuse));
+            attributeDescriptions[8] = vk::VertexInputAttributeDescription(8, 1, vk::Format::eR32G32B32Sfloat, offsetof(VertexMaterialConstants, matSpecular));
+            attributeDescriptions[9] = vk::VertexInputAttributeDescription(9, 1, vk::Format::eR32Sfloat, offsetof(VertexMaterialConstants, matShininess));
+            return attributeDescriptions;
+        }
+    };
+
+    /// <summary>
+    /// Complete vertex input state for one of the supported vertex layouts
+    /// </summary>
+    struct VertexInputDescription {
+        std::vector<vk::VertexInputBindingDescription> bindings;
+        std::vector<vk::VertexInputAttributeDescription> attributes;
+
+        static VertexInputDescription FromLayout(const Vertex_Layout& layout) {
+            if (layout == Vertex_Layout::compact) {
+                const auto bindings = VulkanCompactVertex::getBindingDescriptions();
+                const auto attributes = VulkanCompactVertex::getAttributeDescriptions();
+                return VertexInputDescription{ { bindings.begin(), bindings.end() },
+                                               { attributes.begin(), attributes.end() } };
+            }
+
+            const auto attributes = VulkanVertex::getAttributeDescriptions();
+            return VertexInputDescription{ { VulkanVertex::getBindingDescription() },
+                                           { attributes.begin(), attributes.end() } };
+        }
+
+        /// <summary>
+        /// Number of bytes needed in a vertex buffer holding the provided number of vertices
+        /// </summary>
+        static vk::DeviceSize GetVertexBufferSize(const Vertex_Layout& layout, const size_t& numVertices) {
+            if (layout == Vertex_Layout::compact)
+                return sizeof(CompactVertex) * numVertices + sizeof(VertexMaterialConstants);
+
+            return sizeof(Vertex) * numVertices;
+        }
+
+        /// <summary>
+        /// Offset of the material constants within a compact vertex buffer
+        /// </summary>
+        static vk::DeviceSize GetMaterialConstantsOffset(const size_t& numVertices) {
+            return sizeof(CompactVertex) * numVertices;
+        }
+    };
 }
\ No newline at end of file
@@ -20,6 +20,8 @@ class GlobalInfo : public Buffer
     std::unique_ptr<StarBuffers::Buffer> createStagingBuffer(vk::Device &device,
                                                              VmaAllocator &allocator) const override;
 
+    std::optional<StagingLayout> getStagingLayout() const override;
+
     std::unique_ptr<StarBuffers::Buffer> createFinal(
         vk::Device &device, VmaAllocator &allocator,
         const std::vector<uint32_t> &transferQueueFamilyIndex) const override;
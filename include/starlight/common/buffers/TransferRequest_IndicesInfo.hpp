@@ -9,14 +9,17 @@ namespace star::TransferRequest
 class IndicesInfo : public Buffer
 {
   public:
-    IndicesInfo(const uint32_t &graphicsQueueFamilyIndex, std::vector<uint32_t> indices)
-        : graphicsQueueFamilyIndex(graphicsQueueFamilyIndex), indices(indices)
+    /// @param compactIndices Store the indices as 16 bit values in the final buffer. All indices must fit.
+    IndicesInfo(const uint32_t &graphicsQueueFamilyIndex, std::vector<uint32_t> indices, bool compactIndices = false)
+        : graphicsQueueFamilyIndex(graphicsQueueFamilyIndex), indices(std::move(indices)), compactIndices(compactIndices)
     {
     }
 
     std::unique_ptr<StarBuffers::Buffer> createStagingBuffer(vk::Device &device,
                                                              VmaAllocator &allocator) const override;
 
+    std::optional<StagingLayout> getStagingLayout() const override;
+
     std::unique_ptr<StarBuffers::Buffer> createFinal(
         vk::Device &device, VmaAllocator &allocator,
         const std::vector<uint32_t> &transferQueueFamilyIndex) const override;
@@ -26,5 +29,11 @@ class IndicesInfo : public Buffer
   protected:
     const uint32_t graphicsQueueFamilyIndex;
     const std::vector<uint32_t> indices;
+    const bool compactIndices = false;
+
+    size_t getIndexSize() const
+    {
+        return compactIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
 };
 } // namespace star::TransferRequest
\ No newline at end of file
@@ -2,38 +2,68 @@
 
 #include "starlight/virtual/StarEntity.hpp"
 #include "TransferRequest_Buffer.hpp"
+#include "data_structure/DirtyRangeList.hpp"
 
 #include <glm/glm.hpp>
 
+#include <vector>
+
 namespace star::TransferRequest
 {
+/// Tightly packed storage buffer of per-instance normal matrices. Each instance is stored as the inverse transpose of
+/// the upper 3x3 of its display matrix with padded columns (48 bytes), matching a std430 `mat3 normals[]`.
 class InstanceNormalInfo : public Buffer
 {
   public:
-    InstanceNormalInfo(const std::vector<StarEntity> &objectInstances, const uint32_t &graphicsQueueFamilyIndex,
-                       const vk::DeviceSize &minUniformBufferOffsetAlignment)
-        : graphicsQueueFamilyIndex(graphicsQueueFamilyIndex),
-          minUniformBufferOffsetAlignment(minUniformBufferOffsetAlignment),
-          normalMatrixInfo(std::vector<glm::mat4>(objectInstances.size()))
+    /// @param slotInstances Index of the instance written to each slot of the buffer, in slot order
+    /// @param dirtyRanges Slots which changed since the destination buffer was last written. When empty, every slot is
+    /// uploaded. Only these slots are staged, packed back to back in range order.
+    InstanceNormalInfo(const std::vector<StarEntity> &objectInstances, const std::vector<uint32_t> &slotInstances,
+                       const uint32_t &graphicsQueueFamilyIndex,
+                       std::vector<data_structure::DirtyRangeList::Range> dirtyRanges = {})
+        : graphicsQueueFamilyIndex(graphicsQueueFamilyIndex), m_dirtyRanges(std::move(dirtyRanges)),
+          m_numSlots(slotInstances.size())
     {
-        for (size_t i = 0; i < objectInstances.size(); i++)
+        if (m_dirtyRanges.empty() && !slotInstances.empty())
         {
-            normalMatrixInfo[i] = objectInstances[i].getDisplayMatrix();
+            m_dirtyRanges.push_back(data_structure::DirtyRangeList::Range{.first = 0, .count = slotInstances.size()});
+        }
+
+        size_t numDirty = 0;
+        for (const auto &range : m_dirtyRanges)
+        {
+            numDirty += range.count;
+        }
+        normalMatrixInfo.reserve(numDirty);
+
+        for (const auto &range : m_dirtyRanges)
+        {
+            for (size_t i = range.first; i < range.end(); i++)
+            {
+                normalMatrixInfo.push_back(objectInstances[slotInstances[i]].getDisplayMatrix());
+            }
         }
     }
 
     std::unique_ptr<StarBuffers::Buffer> createStagingBuffer(vk::Device &device,
                                                              VmaAllocator &allocator) const override;
 
+    std::optional<StagingLayout> getStagingLayout() const override;
+
     std::unique_ptr<StarBuffers::Buffer> createFinal(
         vk::Device &device, VmaAllocator &allocator,
         const std::vector<uint32_t> &transferQueueFamilyIndex) const override;
 
     void writeDataToStageBuffer(StarBuffers::Buffer &buffer) const override;
 
+    void copyFromTransferSRCToDST(StarBuffers::Buffer &srcBuffer, StarBuffers::Buffer &dstBuffer,
+                                  vk::CommandBuffer &commandBuffer) const override;
+
   protected:
     const uint32_t graphicsQueueFamilyIndex;
-    const vk::DeviceSize minUniformBufferOffsetAlignment;
+    /// Display matrices of the dirty slots only, in range order
     std::vector<glm::mat4> normalMatrixInfo = std::vector<glm::mat4>();
+    std::vector<data_structure::DirtyRangeList::Range> m_dirtyRanges;
+    size_t m_numSlots = 0;
 };
-} // namespace star::TransferRequest
\ No newline at end of file
+} // namespace star::TransferRequest
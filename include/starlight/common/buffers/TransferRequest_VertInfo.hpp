@@ -2,6 +2,7 @@
 
 #include "TransferRequest_Buffer.hpp"
 
+#include "Enums.hpp"
 #include "Vertex.hpp"
 
 namespace star::TransferRequest
@@ -9,13 +10,18 @@ namespace star::TransferRequest
 class VertInfo : public Buffer
 {
   public:
-    VertInfo(const uint32_t &graphicsQueueIndex, std::vector<Vertex> vertices)
-        : graphicsQueueIndex(graphicsQueueIndex), vertices(std::move(vertices))
+    /// @param layout Format the vertices are packed into before upload. Must match the layout of the pipeline
+    /// used to draw the mesh.
+    VertInfo(const uint32_t &graphicsQueueIndex, std::vector<Vertex> vertices,
+             Vertex_Layout layout = Vertex_Layout::full)
+        : graphicsQueueIndex(graphicsQueueIndex), vertices(std::move(vertices)), layout(layout)
     {
     }
 
     std::unique_ptr<StarBuffers::Buffer> createStagingBuffer(vk::Device &device, VmaAllocator &allocator) const override;
 
+    std::optional<StagingLayout> getStagingLayout() const override;
+
     std::unique_ptr<StarBuffers::Buffer> createFinal(vk::Device &device, VmaAllocator &allocator,
                                             const std::vector<uint32_t> &transferQueueFamilyIndex) const override;
 
@@ -24,5 +30,8 @@ class VertInfo : public Buffer
   protected:
     const uint32_t graphicsQueueIndex;
     std::vector<Vertex> vertices;
+    const Vertex_Layout layout = Vertex_Layout::full;
+
+    void writeCompactVertices(StarBuffers::Buffer &buffer, void *mapped) const;
 };
 } // namespace star::TransferRequest
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ManagerController_RenderResource_Buffer.hpp"
+#include "data_structure/InstanceSlotTracker.hpp"
 #include "starlight/virtual/StarEntity.hpp"
 
 namespace star::ManagerController::RenderResource
@@ -9,7 +10,8 @@ class InstanceModelInfo : public Buffer
 {
   public:
     InstanceModelInfo() = default;
-    InstanceModelInfo(std::vector<StarEntity> *instances);
+    /// @param visibleInstances Instances written to the buffer, in the order they are drawn
+    InstanceModelInfo(std::vector<StarEntity> *instances, const std::vector<uint32_t> *visibleInstances);
 
     virtual ~InstanceModelInfo() = default;
 
@@ -17,6 +19,9 @@ class InstanceModelInfo : public Buffer
 
     void setToUpdate();
 
+    /// Only upload the provided instance on the next update of each frame in flight
+    void setToUpdate(const size_t &instanceIndex);
+
   protected:
     std::unique_ptr<TransferRequest::Buffer> createTransferRequest(core::device::DeviceContext &context,
                                                                    const uint8_t &frameInFlightIndex) override;
@@ -25,6 +30,7 @@ class InstanceModelInfo : public Buffer
 
   private:
     std::vector<StarEntity> *m_instances{nullptr};
-    std::vector<bool> m_needsUpdatedThisFrame;
+    const std::vector<uint32_t> *m_visibleInstances{nullptr};
+    data_structure::InstanceSlotTracker m_slots;
 };
-} // namespace star::ManagerController::RenderResource
\ No newline at end of file
+} // namespace star::ManagerController::RenderResource
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ManagerController_RenderResource_Buffer.hpp"
+#include "data_structure/InstanceSlotTracker.hpp"
 #include "starlight/virtual/StarEntity.hpp"
 #include "TransferRequest_Buffer.hpp"
 
@@ -10,11 +11,16 @@ class InstanceNormalInfo : public ManagerController::RenderResource::Buffer
 {
   public:
     InstanceNormalInfo() = default;
-    InstanceNormalInfo(std::vector<StarEntity> *instances) : m_instances(instances) {};
+    /// @param visibleInstances Instances written to the buffer, in the order they are drawn
+    InstanceNormalInfo(std::vector<StarEntity> *instances, const std::vector<uint32_t> *visibleInstances)
+        : m_instances(instances), m_visibleInstances(visibleInstances) {};
     virtual ~InstanceNormalInfo() = default;
 
     void setForUpdate();
 
+    /// Only upload the provided instance on the next update of each frame in flight
+    void setForUpdate(const size_t &instanceIndex);
+
     void prepRender(core::device::DeviceContext &context, const uint8_t &numFramesInFlight) override;
 
   protected:
@@ -24,6 +30,7 @@ class InstanceNormalInfo : public ManagerController::RenderResource::Buffer
 
   private:
     std::vector<StarEntity> *m_instances{nullptr};
-    std::vector<bool> m_needsUpdatedThisFrame;
+    const std::vector<uint32_t> *m_visibleInstances{nullptr};
+    data_structure::InstanceSlotTracker m_slots;
 };
-} // namespace star::ManagerController::RenderResource
\ No newline at end of file
+} // namespace star::ManagerController::RenderResource
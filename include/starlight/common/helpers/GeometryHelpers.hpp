@@ -4,46 +4,35 @@
 
 #include <vector>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace star {
 	class GeometryHelpers {
 	public:
-		static void packTriangleAdjacency(std::vector<Vertex>& verts, std::vector<uint32_t>& indices);
+		/// Convert a triangle list into a triangle list with adjacency (6 indices per triangle). Neighbors are found
+		/// through a hash of shared edges keyed on vertex position, so vertices are not modified. Edges without exactly
+		/// one neighbor reference the opposite vertex of their own triangle.
+		static void packTriangleAdjacency(const std::vector<Vertex>& verts, std::vector<uint32_t>& indices);
 
 		static void calculateAndApplyVertTangents(std::vector<Vertex>& verts, std::vector<uint32_t>& indices);
 
 		static void calculateAxisAlignedBoundingBox(const glm::vec3 lowerBound, const glm::vec3 upperBound,
 			std::vector<Vertex>& vertList, std::vector<uint32_t>& indicesList,
 			bool lineList = false);
-	private:
-		struct EdgeTracker {
-			std::pair<uint32_t, uint32_t> verts; 
-			EdgeTracker(const uint32_t f, const uint32_t s) 
-				: verts(std::pair<uint32_t, uint32_t>(f, s)) {};
-
-			bool operator==(const EdgeTracker& f) const {
-				return ((this->verts.first == f.verts.first && this->verts.second == f.verts.second)
-					|| (this->verts.first == f.verts.second && this->verts.second == f.verts.first)); 
-			}
-		};
-
-		struct TriangleTracker {
-			EdgeTracker edges[3]; 
-			TriangleTracker* neighbors[3]{ nullptr, nullptr, nullptr };
-
-			TriangleTracker(const EdgeTracker f, const EdgeTracker s, const EdgeTracker t)
-				: edges{ f, s, t } {}; 
-
-			uint32_t getOppositeVertIndex(uint32_t vertIndex) {
-				return 0;
-			}
-
-			void addNeighbor(const int edgeIndex, TriangleTracker& neighbor){
-				assert(edgeIndex < 3 && "An edge index outside of acceptable range requested. A triangle can only have 3 edges");
-				this->neighbors[edgeIndex] = &neighbor; 
-			}
-		};
 
+		/// Merge vertices sharing the same position, normal, texture coordinate and color. Indices are remapped to the
+		/// remaining vertices.
+		/// @return number of vertices removed
+		static size_t deduplicateVertices(std::vector<Vertex>& verts, std::vector<uint32_t>& indices);
+
+		/// Reorder triangles for the post transform vertex cache (Forsyth), then reorder vertices in first use order
+		/// so vertex fetch is sequential. Indices must describe a triangle list.
+		static void optimizeVertexCacheOrder(std::vector<Vertex>& verts, std::vector<uint32_t>& indices);
+
+		/// Check if the indices of a mesh with this many vertices can be stored as 16 bit values
+		static bool canUseCompactIndices(const size_t& numVerts);
+	private:
 		static void calcTangentSpaceVectors(std::array<Vertex*, 3>& triVerts);
 	};
 }
\ No newline at end of file
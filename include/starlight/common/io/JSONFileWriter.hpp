@@ -3,18 +3,27 @@
 
 #include <nlohmann/json.hpp>
 
+#include <filesystem>
+
 namespace star::common::io
 {
 class JSONFileWriter
 {
   public:
-    explicit JSONFileWriter(nlohmann::json jData) : m_jData(std::move(jData))
+    explicit JSONFileWriter(nlohmann::json jData, bool commitThroughTempFile = false)
+        : m_jData(std::move(jData)), m_commitThroughTempFile(commitThroughTempFile)
     {
     }
 
     int operator()(const std::string &path);
 
+    /// Write the json data to the path. When commitThroughTempFile is set, the data is first written to a sibling
+    /// temporary file which is then renamed over the target so readers never observe a partially written file.
+    /// Failures are logged and reported by a non zero result, this runs on the IO worker where nothing catches.
+    static int Write(const nlohmann::json &jData, const std::filesystem::path &path, bool commitThroughTempFile);
+
     private:
     nlohmann::json m_jData; 
+    bool m_commitThroughTempFile = false;
 };
-}
\ No newline at end of file
+}
@@ -5,7 +5,9 @@
 #include "core/Exceptions.hpp"
 #include "device/StarDevice.hpp"
 
-#include <array>
+#include <algorithm>
+#include <deque>
+#include <limits>
 #include <stack>
 #include <star_common/Handle.hpp>
 #include <star_common/helper/CastHelpers.hpp>
@@ -13,7 +15,9 @@
 namespace star::core
 {
 
-template <typename TData, size_t TMaxDataCount> class LinearHandleContainer : public HandleContainer<TData>
+/// Records are stored in order of their handle ids. Storage starts with TInitialDataCount slots and doubles once they
+/// are all in use, existing records never move so pointers to them stay valid while it grows.
+template <typename TData, size_t TInitialDataCount> class LinearHandleContainer : public HandleContainer<TData>
 {
   public:
     LinearHandleContainer(std::string_view handleTypeName) : HandleContainer<TData>(handleTypeName)
@@ -24,14 +28,14 @@ template <typename TData, size_t TMaxDataCount> class LinearHandleContainer : pu
     }
     virtual ~LinearHandleContainer() = default;
 
-    std::array<TData, TMaxDataCount> &getData()
+    std::deque<TData> &getData()
     {
         return m_records;
     }
 
   protected:
     std::stack<uint32_t> m_skippedSpaces = std::stack<uint32_t>();
-    std::array<TData, TMaxDataCount> m_records = std::array<TData, TMaxDataCount>();
+    std::deque<TData> m_records = std::deque<TData>(TInitialDataCount);
     uint32_t m_nextSpace = 0;
 
     Handle storeRecord(TData newData) override
@@ -56,7 +60,13 @@ template <typename TData, size_t TMaxDataCount> class LinearHandleContainer : pu
 
         if (m_nextSpace >= m_records.size())
         {
-            STAR_THROW("Storage is full");
+            if (m_nextSpace == std::numeric_limits<uint32_t>::max())
+            {
+                STAR_THROW("Storage is full");
+            }
+
+            // growing at the back of a deque keeps references to the existing records valid
+            m_records.resize(std::max<size_t>(m_records.size() * 2, 1));
         }
 
         return m_nextSpace++;
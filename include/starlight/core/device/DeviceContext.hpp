@@ -228,6 +228,9 @@ class DeviceContext : public star::common::IDeviceContext
     void initWorkers(core::WorkerPool &pool, absl::flat_hash_map<star::Queue_Type, Handle> engineReserved,
                      const uint8_t &numFramesInFlight);
 
+    /// Workers to register for a task type, from a setting where zero means one per executor thread
+    uint32_t getWorkerCount(const Config_Settings &setting);
+
     void shutdownServices();
 
     void logInit(const uint8_t &numFramesInFlight) const;
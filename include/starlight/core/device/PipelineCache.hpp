@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace star::core::device
+{
+/// Driver pipeline cache kept on disk between runs, shared by every pipeline build of a device.
+///
+/// Builds run in parallel on the executor, so each build leases a cache of its own instead of contending on one. The
+/// leased caches are merged into the primary before it is written out, on cleanup and every SaveInterval while builds
+/// keep completing. The file is written after the cache lock is dropped, so builds finishing meanwhile are not held up
+/// by the disk. Data on disk from another driver or device is rejected by checking its header.
+class PipelineCache
+{
+  public:
+    static constexpr std::chrono::seconds SaveInterval{30};
+
+    PipelineCache() = default;
+    PipelineCache(const PipelineCache &) = delete;
+    PipelineCache &operator=(const PipelineCache &) = delete;
+
+    void init(vk::Device device, vk::PhysicalDevice physicalDevice);
+
+    /// Write the cache out and destroy it, no build may be running
+    void cleanupRender();
+
+    /// Cache for the exclusive use of one build until it is released
+    vk::PipelineCache acquire();
+
+    /// Return a cache from acquire along with how long the build using it took
+    void release(vk::PipelineCache cache, const std::chrono::nanoseconds &buildTime);
+
+    /// Merge every cache not in use into the primary and write it to disk
+    void save();
+
+  private:
+    vk::Device m_device{VK_NULL_HANDLE};
+    vk::PhysicalDeviceProperties m_properties;
+    std::filesystem::path m_path;
+    std::vector<uint8_t> m_initialData;
+
+    std::mutex m_mutex;
+    vk::PipelineCache m_primary{VK_NULL_HANDLE};
+    std::vector<vk::PipelineCache> m_leased;
+    std::vector<vk::PipelineCache> m_available;
+    std::chrono::steady_clock::time_point m_lastSave;
+    size_t m_numBuildsSinceSave = 0;
+    size_t m_numBuilds = 0;
+    std::chrono::nanoseconds m_totalBuildTime{0};
+    uint64_t m_numSaves = 0;
+
+    /// Serializes writes of the file, a write older than the last one written is dropped
+    std::mutex m_fileMutex;
+    uint64_t m_lastWrittenSave = 0;
+
+    /// Data to be saved along with the save it belongs to
+    struct SaveData
+    {
+        std::vector<uint8_t> data;
+        uint64_t saveIndex = 0;
+    };
+
+    /// Merge the available caches into the primary and take its data. Expects m_mutex to be held.
+    /// @return nothing when no build completed since the last save
+    std::optional<SaveData> takeSaveDataLocked();
+
+    /// Write the data taken by takeSaveDataLocked to disk, must be called without m_mutex held
+    void writeSaveData(const SaveData &save);
+
+    bool isCompatible(const std::vector<uint8_t> &data) const;
+
+    vk::PipelineCache createCache() const;
+};
+} // namespace star::core::device
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <set>
 #include <unordered_set>
 #include <vector>
 
@@ -105,6 +106,11 @@ class StarDevice : public star::common::IRenderDevice
     {
         return allocator;
     }
+    /// Optional device features are only enabled when the physical device supports them
+    bool isFeatureEnabled(const Rendering_Device_Features &feature) const
+    {
+        return m_enabledFeatures.contains(feature);
+    }
 
     core::SwapChainSupportDetails getSwapchainSupport(vk::SurfaceKHR surface)
     {
@@ -140,6 +146,7 @@ class StarDevice : public star::common::IRenderDevice
     vk::Device vulkanDevice = VK_NULL_HANDLE;
     vk::PhysicalDevice physicalDevice = VK_NULL_HANDLE;
     std::optional<vk::SurfaceKHR> m_renderingSurface{std::nullopt};
+    std::set<Rendering_Device_Features> m_enabledFeatures;
 
     StarDevice(star::Allocator allocator, vk::Device device, vk::PhysicalDevice physicalDevice);
     StarDevice(star::Allocator allocator, vk::Device device, vk::PhysicalDevice physicalDevice,
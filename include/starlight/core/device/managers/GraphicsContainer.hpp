@@ -7,6 +7,7 @@
 #include "Queue.hpp"
 #include "Semaphore.hpp"
 #include "Shader.hpp"
+#include "core/device/PipelineCache.hpp"
 
 #include <memory>
 
@@ -21,7 +22,7 @@ struct GraphicsContainer
         : queueManager(std::move(other.queueManager)), descriptorPoolManager(std::move(other.descriptorPoolManager)),
           semaphoreManager(std::move(other.semaphoreManager)), shaderManager(std::move(other.shaderManager)),
           pipelineManager(std::move(other.pipelineManager)), fenceManager(std::move(other.fenceManager)),
-          imageManager(std::move(other.imageManager)) {};
+          imageManager(std::move(other.imageManager)), pipelineCache(std::move(other.pipelineCache)) {};
     GraphicsContainer &operator=(GraphicsContainer &&other) noexcept
     {
         if (this != &other)
@@ -33,6 +34,7 @@ struct GraphicsContainer
             pipelineManager = std::move(other.pipelineManager);
             fenceManager = std::move(other.fenceManager);
             imageManager = std::move(other.imageManager);
+            pipelineCache = std::move(other.pipelineCache);
         }
         return *this;
     };
@@ -47,10 +49,12 @@ struct GraphicsContainer
         pipelineManager->init(device, bus, taskSystem);
         fenceManager->init(device, bus);
         imageManager.init(device, bus);
+        pipelineCache->init(device->getVulkanDevice(), device->getPhysicalDevice());
     }
 
     void cleanupRender()
     {
+        pipelineCache->cleanupRender();
         queueManager.cleanupRender();
         descriptorPoolManager->cleanupRender();
         fenceManager->cleanupRender();
@@ -67,5 +71,6 @@ struct GraphicsContainer
     std::unique_ptr<Pipeline> pipelineManager = std::make_unique<Pipeline>();
     std::unique_ptr<Fence> fenceManager = std::make_unique<Fence>();
     Image imageManager;
+    std::unique_ptr<PipelineCache> pipelineCache = std::make_unique<PipelineCache>();
 };
 } // namespace star::core::device::manager
\ No newline at end of file
@@ -4,9 +4,11 @@
 #include "core/renderer/RenderingTargetInfo.hpp"
 #include "device/managers/TaskCreatedResourceManager.hpp"
 
+#include <absl/container/flat_hash_map.h>
 #include <vulkan/vulkan.hpp>
 
 #include <memory>
+#include <string>
 
 namespace star::core::device::manager
 {
@@ -43,10 +45,14 @@ struct PipelineRecord
 
     PipelineRequest request = PipelineRequest();
     uint8_t numCompiled = 0;
+    /// Shaders already counted by numCompiled, a shared shader can be announced more than once
+    std::vector<bool> isShaderCompiled;
 };
 
 constexpr std::string_view PipelineCreateEventTypeName = "star::event::pipeline";
 
+/// Requests for a pipeline with the same state key as an earlier request share its handle and build, whether that build
+/// is still waiting on shaders, in flight or done
 class Pipeline : public TaskCreatedResourceManager<PipelineRecord, PipelineRequest, 50>
 {
   public:
@@ -64,10 +70,13 @@ class Pipeline : public TaskCreatedResourceManager<PipelineRecord, PipelineReque
 
     void init(device::StarDevice *device, common::EventBus &bus, job::TaskManager &taskSystem) override;
 
+    Handle submit(PipelineRequest request) override;
+
     virtual void cleanupRender() override;
 
   protected:
     absl::flat_hash_map<uint16_t, Handle> m_subscriberShaderBuildInfo;
+    absl::flat_hash_map<std::string, Handle> m_requestedPipelines;
 
     PipelineRecord createRecord(PipelineRequest &&request) const override
     {
@@ -4,11 +4,14 @@
 #include "StarShader.hpp"
 #include "device/managers/TaskCreatedResourceManager.hpp"
 
+#include <absl/container/flat_hash_map.h>
+
 #include <array>
 #include <memory>
 #include <stack>
 #include <star_common/Handle.hpp>
 #include <star_common/HandleTypeRegistry.hpp>
+#include <string>
 #include <vector>
 
 namespace star::core::device::manager
@@ -30,6 +33,9 @@ struct ShaderRecord
 {
   public:
     ShaderRequest request;
+    /// The compile has been announced again for a duplicate request and that announcement is still queued, further
+    /// duplicates until it runs are covered by it
+    bool isCompletionQueued = false;
 
     ShaderRecord() = default;
     ShaderRecord(ShaderRequest request) : request(std::move(request))
@@ -44,6 +50,7 @@ struct ShaderRecord
     void setCompiledShader(std::shared_ptr<std::vector<uint32_t>> compiledShader)
     {
         m_compiledShader = std::move(compiledShader);
+        isCompletionQueued = false;
     }
 
     void cleanupRender(core::device::StarDevice &device)
@@ -54,18 +61,18 @@ struct ShaderRecord
         }
     }
 
-    std::shared_ptr<std::vector<uint32_t>> giveMeCompiledShader()
+    /// Shared by every pipeline using the shader, the record keeps it so later duplicate requests can reuse it
+    std::shared_ptr<std::vector<uint32_t>> getCompiledShader() const
     {
         assert(m_compiledShader);
-        std::shared_ptr<std::vector<uint32_t>> tmp = m_compiledShader;
-        m_compiledShader = nullptr;
-
-        return tmp;
+        return m_compiledShader;
     }
 
   private:
     std::shared_ptr<std::vector<uint32_t>> m_compiledShader = nullptr;
 };
+/// Requests for a shader which was already requested with the same path, macros and optimization share its handle and
+/// compile, whether that compile is still in flight or done
 class Shader : public TaskCreatedResourceManager<ShaderRecord, ShaderRequest, 50>
 {
   public:
@@ -75,7 +82,15 @@ class Shader : public TaskCreatedResourceManager<ShaderRecord, ShaderRequest, 50
     {
     }
 
+    Handle submit(ShaderRequest request) override;
+
+    void cleanupRender() override;
+
   protected:
+    absl::flat_hash_map<std::string, Handle> m_requestedShaders;
+
+    static std::string CreateRequestKey(const ShaderRequest &request);
+
     ShaderRecord createRecord(ShaderRequest &&request) const override
     {
         return ShaderRecord(std::move(request));
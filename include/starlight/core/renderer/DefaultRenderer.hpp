@@ -10,6 +10,7 @@
 #include "StarShaderInfo.hpp"
 #include "StarTextures/Texture.hpp"
 #include "core/renderer/RendererBase.hpp"
+#include "core/renderer/SecondaryDrawRecorder.hpp"
 #include "starlight/event/DescriptorPoolReady.hpp"
 #include "starlight/object/StarObject.hpp"
 
@@ -119,6 +120,21 @@ class DefaultRenderer : public RendererBase
         return m_infoManagerLightList;
     }
 
+    /// Record draws into secondary command buffers spread across the shared executor instead of directly into the
+    /// primary. Worth it once a frame has thousands of draws. Must be set before prepRender.
+    void setRecordDrawsInParallel(const bool &enabled)
+    {
+        m_recordDrawsInParallel = enabled;
+    }
+
+    /// Submit the commands recorded for a frame in flight again, without recording, while nothing they depend on has
+    /// changed. Objects, pipelines, descriptor sets, graph barriers and render targets are all checked each frame,
+    /// so any change to them records the buffer again.
+    void setReuseRecordedCommands(const bool &enabled)
+    {
+        m_reuseRecordedCommands = enabled;
+    }
+
   protected:
     core::renderer::RenderingContext m_renderingContext;
     std::shared_ptr<ManagerController::RenderResource::Buffer> m_infoManagerLightData, m_infoManagerLightList,
@@ -127,6 +143,9 @@ class DefaultRenderer : public RendererBase
     vk::Format m_colorFormat, m_depthFormat;
     bool ownsRenderResourceControllers = false;
     bool isReady = false;
+    bool m_recordDrawsInParallel = false;
+    bool m_reuseRecordedCommands = false;
+    std::unique_ptr<SecondaryDrawRecorder> m_secondaryRecorder;
 
     void initBuffers(core::device::DeviceContext &context, std::shared_ptr<std::vector<Light>> lights);
 
@@ -164,7 +183,7 @@ class DefaultRenderer : public RendererBase
 
     virtual vk::Format getDepthAttachmentFormat(star::core::device::DeviceContext &context) const;
 
-    virtual void updateDependentData(star::core::device::DeviceContext &context);
+    virtual void updateDependentData(star::core::device::DeviceContext &context) override;
 
     virtual core::device::manager::ManagerCommandBuffer::Request getCommandBufferRequest() override = 0;
 #pragma region helpers
@@ -190,11 +209,8 @@ class DefaultRenderer : public RendererBase
     virtual void recordCommands(vk::CommandBuffer &commandBuffer, const common::FrameTracker &frameTracker,
                                 const uint64_t &frameIndex);
 
-    void recordCommandBufferDependencies(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
-                                         const uint64_t &frameIndex);
-
-    std::vector<vk::BufferMemoryBarrier2> getMemoryBarriersForThisFrame(const uint8_t &frameInFlightIndex,
-                                                                        const uint64_t &frameIndex);
+    /// Everything recordCommands would record for the frame
+    RecordState getRecordState(const common::FrameTracker &frameTracker, const uint64_t &frameIndex);
 
     RenderingTargetInfo getRenderingTargetInfo(core::device::DeviceContext &context) const
     {
@@ -2,40 +2,8 @@
 
 #include <starlight/core/renderer/DefaultRenderer.hpp>
 
-#include <variant>
-
 namespace star::core::renderer
 {
-namespace pre_pass
-{
-struct DoNothing
-{
-};
-struct GetImageFromNeighbor
-{
-    uint32_t myQueueFamilyIndex;
-    uint32_t neighborQueueFamilyIndex;
-    StarTextures::Texture *targetTexture{nullptr};
-
-    vk::ImageMemoryBarrier2 getBarrier() const noexcept;
-};
-} // namespace pre_pass
-
-namespace post_pass
-{
-struct DoNothing
-{
-};
-struct PrepImageForNeighbor
-{
-    uint32_t myQueueFamilyIndex;
-    uint32_t neighborQueueFamilyIndex;
-    StarTextures::Texture *targetTexture{nullptr};
-
-    vk::ImageMemoryBarrier2 getBarrier() const noexcept;
-};
-} // namespace post_pass
-
 class HeadlessRenderer : public star::core::renderer::DefaultRenderer
 {
   public:
@@ -88,15 +56,10 @@ class HeadlessRenderer : public star::core::renderer::DefaultRenderer
 
   private:
     vk::PipelineStageFlags m_waitPoint{vk::PipelineStageFlagBits::eFragmentShader};
-    std::vector<std::variant<pre_pass::DoNothing, pre_pass::GetImageFromNeighbor>> m_prepScheme;
-    std::vector<std::variant<post_pass::DoNothing, post_pass::PrepImageForNeighbor>> m_postScheme;
     std::vector<Handle> m_timelineSemaphores;
     vk::Device m_device{VK_NULL_HANDLE};
-    const star::core::device::manager::Image *m_imgMgr{nullptr};
     const star::core::CommandBus *m_cmdBus{nullptr};
 
-    // void applyPrePipelineBarriers(vk::CommandBuffer commandBuffer, const star::common::FrameTracker &ft) const;
-
     void waitForSemaphore(const common::FrameTracker &Ft) const;
 
     core::device::manager::ManagerCommandBuffer::Request getCommandBufferRequest() override;
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <boost/functional/hash.hpp>
+#include <vulkan/vulkan.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+namespace star::core::renderer
+{
+/// Every input which decides the commands recorded into a command buffer. Two frames which add the same values in the
+/// same order would record the same commands, so a buffer recorded for one can be submitted again for the other.
+///
+/// The values are kept as bytes along with a running hash of them. Comparing the hashes rejects most changed states
+/// without touching the bytes, and comparing the bytes means a hash collision can never reuse the wrong commands.
+class RecordState
+{
+  public:
+    template <typename T> RecordState &add(const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be added to a record state");
+        m_bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        boost::hash_combine(m_seed, std::hash<T>{}(value));
+        return *this;
+    }
+
+    RecordState &add(const vk::BufferMemoryBarrier2 &barrier)
+    {
+        return add(barrier.buffer)
+            .add(barrier.srcStageMask)
+            .add(barrier.srcAccessMask)
+            .add(barrier.dstStageMask)
+            .add(barrier.dstAccessMask)
+            .add(barrier.offset)
+            .add(barrier.size);
+    }
+
+    RecordState &add(const vk::ImageMemoryBarrier2 &barrier)
+    {
+        return add(barrier.image)
+            .add(barrier.srcStageMask)
+            .add(barrier.srcAccessMask)
+            .add(barrier.dstStageMask)
+            .add(barrier.dstAccessMask)
+            .add(barrier.oldLayout)
+            .add(barrier.newLayout)
+            .add(barrier.srcQueueFamilyIndex)
+            .add(barrier.dstQueueFamilyIndex)
+            .add(barrier.subresourceRange.aspectMask);
+    }
+
+    size_t getHash() const
+    {
+        return m_seed;
+    }
+
+    /// Every value added so far, in order
+    const std::string &getBytes() const
+    {
+        return m_bytes;
+    }
+
+    bool operator==(const RecordState &other) const
+    {
+        return m_seed == other.m_seed && m_bytes == other.m_bytes;
+    }
+
+  private:
+    std::string m_bytes;
+    size_t m_seed = 0;
+};
+} // namespace star::core::renderer
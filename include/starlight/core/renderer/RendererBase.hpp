@@ -1,10 +1,16 @@
 #pragma once
 
+#include "StarCamera.hpp"
+#include "core/renderer/RecordState.hpp"
+#include "starlight/service/detail/command_order/ResourceUse.hpp"
+#include "systems/DrawList.hpp"
+#include "systems/Frustum.hpp"
 #include "systems/StarRenderGroup.hpp"
 
 #include <star_common/IDeviceContext.hpp>
 
 #include <memory>
+#include <optional>
 namespace star::core::renderer
 {
 class RendererBase
@@ -15,6 +21,8 @@ class RendererBase
         : m_objects(std::move(objects)) {};
     virtual ~RendererBase() = default;
 
+    /// Overrides of the record functions must also extend hashRecordState with whatever they record, or recorded
+    /// commands are submitted again after they changed
     virtual void recordPreRenderPassCommands(vk::CommandBuffer &commandBuffer, const common::FrameTracker &ft);
     virtual void recordPostRenderingCalls(vk::CommandBuffer &commandBuffer, const common::FrameTracker &ft);
     virtual void recordRenderingCalls(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
@@ -41,6 +49,21 @@ class RendererBase
     {
         return m_renderToDepthImages;
     }
+    /// Camera whose frustum the instances of every object are culled against. Culling is disabled without one.
+    void setCullingCamera(std::shared_ptr<StarCamera> camera)
+    {
+        m_cullingCamera = std::move(camera);
+    }
+    /// Instances tested and drawn during the most recent frame update
+    const CullingStats &getCullingStats() const
+    {
+        return m_cullingStats;
+    }
+    /// Draws recorded and binds skipped while recording the most recent frame
+    const DrawStats &getDrawStats() const
+    {
+        return m_drawStats;
+    }
     std::vector<std::shared_ptr<StarObject>> &getObjects()
     {
         return m_objects;
@@ -51,14 +74,53 @@ class RendererBase
     }
 
   protected:
+    /// Barriers derived by the command order graph for the resources declared by this pass
+    struct GraphBarriers
+    {
+        std::vector<vk::ImageMemoryBarrier2> images;
+        std::vector<vk::BufferMemoryBarrier2> buffers;
+
+        void record(vk::CommandBuffer &commandBuffer) const;
+        void hashRecordState(RecordState &state) const;
+    };
+
     std::vector<std::shared_ptr<StarObject>> m_objects;
     std::vector<Handle> m_renderToImages;
     std::vector<Handle> m_renderToDepthImages;
     std::vector<StarRenderGroup> m_renderGroups;
     Handle m_commandBuffer;
+    std::shared_ptr<StarCamera> m_cullingCamera;
+    CullingStats m_cullingStats;
+    DrawList m_drawList;
+    DrawStats m_drawStats;
+    std::optional<uint64_t> m_drawListFrameIndex = std::nullopt;
+    GraphBarriers m_graphAcquireBarriers;
+    GraphBarriers m_graphReleaseBarriers;
 
     void updateRenderingGroups(core::device::DeviceContext &context, const uint8_t &frameInFlightIndex);
 
+    void cullRenderingGroups();
+
+    /// Submit uploads owned by the renderer itself, after the objects have updated and before the graph barriers of
+    /// the frame are resolved against the buffers they write
+    virtual void updateDependentData(core::device::DeviceContext &context) {};
+
+    /// Declare an image or buffer used by the pass so the command order graph can order it and derive its barriers
+    void declareResourceUse(core::device::DeviceContext &context, service::command_order::ResourceUse use) const;
+
+    /// Declare the resources every object reads or writes while recording into the pass
+    void declareObjectResourceUses(core::device::DeviceContext &context) const;
+
+    /// Resolve the transitions compiled for the pass on this frame in flight into barriers
+    void gatherGraphBarriers(core::device::DeviceContext &context, const uint8_t &frameInFlightIndex);
+
+    /// Gather and sort the draws of every group for the frame into m_drawList, once per frame
+    void prepareDrawList(const uint8_t &frameInFlightIndex, const uint64_t &frameIndex);
+
+    /// Add everything recorded by recordPreRenderPassCommands, recordRenderingCalls and recordPostRenderingCalls for
+    /// the frame
+    virtual void hashRecordState(RecordState &state, const uint8_t &frameInFlightIndex, const uint64_t &frameIndex);
+
     static std::vector<StarRenderGroup> CreateRenderingGroups(core::device::DeviceContext &context,
                                                               std::vector<std::shared_ptr<StarObject>> objects);
 };
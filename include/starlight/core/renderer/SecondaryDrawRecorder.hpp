@@ -0,0 +1,65 @@
+#pragma once
+
+#include "StarCommandPool.hpp"
+#include "core/device/DeviceContext.hpp"
+#include "job/TaskManager.hpp"
+#include "systems/DrawList.hpp"
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+namespace star::core::renderer
+{
+/// Records a sorted draw list into secondary command buffers on the shared executor. The list is split into
+/// contiguous chunks, one per thread, and each chunk is recorded into a secondary buffer allocated from a command
+/// pool that only that chunk touches. The calling thread records the first chunk itself and then executes every
+/// secondary from the primary, which must be inside a beginRendering using
+/// vk::RenderingFlagBits::eContentsSecondaryCommandBuffers.
+///
+/// Must not be called from one of the executor threads, the calling thread blocks until every chunk is recorded.
+class SecondaryDrawRecorder
+{
+  public:
+    /// Fewer draws than this are not worth handing to another thread
+    static constexpr size_t MinDrawsPerChunk = 256;
+
+    void prepRender(core::device::DeviceContext &context, const uint8_t &numFramesInFlight);
+
+    void cleanupRender(core::device::DeviceContext &context);
+
+    /// Record the draw list and execute the results from the primary buffer
+    /// @param renderingInfo Attachment formats of the rendering the secondaries will be executed in
+    /// @param viewport Dynamic state is not inherited by secondary buffers, so it is set again in every chunk
+    DrawStats record(vk::CommandBuffer &primary, const DrawList &drawList,
+                     const vk::CommandBufferInheritanceRenderingInfo &renderingInfo, const vk::Viewport &viewport,
+                     const uint8_t &frameInFlightIndex);
+
+  private:
+    /// Pool and secondary buffer of one chunk for each frame in flight
+    struct Slot
+    {
+        std::vector<StarCommandPool> pools;
+        std::vector<vk::CommandBuffer> buffers;
+    };
+
+    vk::Device m_device{VK_NULL_HANDLE};
+    uint32_t m_queueFamilyIndex = 0;
+    uint8_t m_numFramesInFlight = 0;
+    job::TaskManager *m_taskManager = nullptr;
+    std::vector<Slot> m_slots;
+    std::vector<DrawStats> m_chunkStats;
+    std::vector<std::exception_ptr> m_chunkErrors;
+    std::vector<vk::CommandBuffer> m_toExecute;
+
+    /// Create slots up to the requested count, the executor may start after this recorder is prepared
+    void ensureSlots(const size_t &numSlots);
+
+    void recordChunk(const size_t &slot, const DrawList &drawList, const size_t &first, const size_t &count,
+                     const vk::CommandBufferInheritanceRenderingInfo &renderingInfo, const vk::Viewport &viewport,
+                     const uint8_t &frameInFlightIndex);
+};
+} // namespace star::core::renderer
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace star::data_structure
+{
+/// Sorted list of element ranges which have changed since they were last uploaded. Neighbouring ranges are merged as
+/// they are marked, and once the list grows past its limit the two ranges with the smallest gap are merged so the
+/// number of copy regions stays small.
+class DirtyRangeList
+{
+  public:
+    struct Range
+    {
+        size_t first = 0;
+        size_t count = 0;
+
+        size_t end() const
+        {
+            return first + count;
+        }
+    };
+
+    static constexpr size_t DefaultMaxRanges = 16;
+
+    explicit DirtyRangeList(size_t maxRanges = DefaultMaxRanges);
+
+    void markDirty(const size_t &index);
+
+    void markDirty(const Range &range);
+
+    void clear();
+
+    bool empty() const
+    {
+        return m_ranges.empty();
+    }
+
+    const std::vector<Range> &getRanges() const
+    {
+        return m_ranges;
+    }
+
+    size_t getNumDirtyElements() const;
+
+  private:
+    size_t m_maxRanges = DefaultMaxRanges;
+    std::vector<Range> m_ranges;
+
+    void mergeClosestRanges();
+};
+} // namespace star::data_structure
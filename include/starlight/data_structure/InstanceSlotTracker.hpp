@@ -0,0 +1,40 @@
+#pragma once
+
+#include "data_structure/DirtyRangeList.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace star::data_structure
+{
+/// Tracks which slots of a compacted per-instance buffer need to be rewritten for each frame in flight. A slot is the
+/// position within the buffer, and holds the instance listed at the same position in the visible instance list. Slots
+/// are dirty when a different instance moved into them or when the instance they hold changed.
+class InstanceSlotTracker
+{
+  public:
+    void resize(const uint8_t &numFramesInFlight);
+
+    void markInstanceDirty(const size_t &instanceIndex);
+
+    void markAllDirty();
+
+    /// @return true if the buffer of the frame in flight does not match the visible instances
+    bool needsUpload(const uint8_t &frameInFlightIndex, const std::vector<uint32_t> &visibleInstances) const;
+
+    /// Record the visible instances as written to the buffer of the frame in flight
+    /// @return dirty slot ranges, or an empty list when every slot must be written
+    std::vector<DirtyRangeList::Range> takeDirtySlots(const uint8_t &frameInFlightIndex,
+                                                      const std::vector<uint32_t> &visibleInstances);
+
+  private:
+    std::vector<DirtyRangeList> m_dirtyInstances;
+    std::vector<std::vector<uint32_t>> m_lastWrittenInstances;
+    std::vector<bool> m_allDirty;
+
+    bool isSlotDirty(const uint8_t &frameInFlightIndex, const std::vector<uint32_t> &visibleInstances,
+                     const size_t &slot) const;
+
+    bool isInstanceDirty(const uint8_t &frameInFlightIndex, const size_t &instanceIndex) const;
+};
+} // namespace star::data_structure
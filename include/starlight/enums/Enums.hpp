@@ -28,7 +28,9 @@ enum Rendering_Features
 
 enum class Rendering_Device_Features
 {
-    timeline_semaphores
+    timeline_semaphores,
+    /// optional, dropped with a warning when the device does not support it
+    draw_indirect_count
 };
 
 enum Buffer_Type
@@ -39,6 +41,13 @@ enum Buffer_Type
     geometry_index
 };
 
+/// Memory layout used for the per-vertex data of a mesh. Every layout feeds the same shader input locations.
+enum class Vertex_Layout
+{
+    full,   // star::Vertex, every attribute stored as fp32
+    compact // star::CompactVertex, quantized attributes + one shared set of material constants
+};
+
 enum Queue_Type
 {
     Tgraphics = 0,
@@ -62,6 +71,14 @@ enum class Shader_Stage
     geometry
 };
 
+/// Work spent by the compiler on making a shader fast
+enum class Shader_Optimization
+{
+    none,        // compiled as written
+    performance, // shaderc performance level
+    full         // performance level followed by the spirv-opt pipeline, which also strips debug info
+};
+
 enum Config_Settings
 {
     app_name,
@@ -78,7 +95,16 @@ enum Config_Settings
     max_image_worker_count,
     transfer_high_priority_queue_size,
     transfer_standard_priority_queue_size,
-    transfer_standard_priority_worker_count
+    transfer_standard_priority_worker_count,
+    transfer_staging_ring_size_mb,
+    transfer_batch_max_requests,
+    transfer_batch_max_kb,
+    transfer_batch_latency_cap_us,
+    shader_cache_directory,
+    shader_cache_max_mb,
+    shader_compile_worker_count,
+    pipeline_build_worker_count,
+    gpu_culling_validation
 };
 
 enum class TransferQueueCapacity
@@ -9,6 +9,7 @@
 #include <array>
 #include <cassert>
 #include <cstring>
+#include <optional>
 #include <string>
 
 namespace star::event
@@ -30,19 +31,22 @@ class TriggerScreenshot : public star::common::IEvent
     }
 
     TriggerScreenshot(StarTextures::Texture targetTexture, std::string screenshotPath, const Handle &targetCommandBuffer,
-                      Handle &calleeRegistration, const star::Handle *targetTextureReadySemaphore)
+                      Handle &calleeRegistration, const star::Handle *targetTextureReadySemaphore,
+                      std::optional<Handle> targetTextureResource = std::nullopt)
         : common::IEvent(common::HandleTypeRegistry::instance().registerType(GetUniqueTypeName())),
           m_targetTexture(std::move(targetTexture)), m_screenshotPath(std::move(screenshotPath)),
           m_targetTextureReadySemaphore(targetTextureReadySemaphore),
-          m_targetCommandBuffer(targetCommandBuffer), m_calleeRegistration(calleeRegistration)
+          m_targetTextureResource(std::move(targetTextureResource)), m_targetCommandBuffer(targetCommandBuffer),
+          m_calleeRegistration(calleeRegistration)
     {
     }
     TriggerScreenshot(StarTextures::Texture targetTexture, std::string screenshotPath,
-                      const Handle &targetCommandBuffer, Handle &calleeRegistration)
+                      const Handle &targetCommandBuffer, Handle &calleeRegistration,
+                      std::optional<Handle> targetTextureResource = std::nullopt)
         : common::IEvent(common::HandleTypeRegistry::instance().registerType(GetUniqueTypeName())),
           m_targetTexture(std::move(targetTexture)), m_screenshotPath(std::move(screenshotPath)),
-          m_targetTextureReadySemaphore(nullptr), m_targetCommandBuffer(targetCommandBuffer),
-          m_calleeRegistration(calleeRegistration)
+          m_targetTextureReadySemaphore(nullptr), m_targetTextureResource(std::move(targetTextureResource)),
+          m_targetCommandBuffer(targetCommandBuffer), m_calleeRegistration(calleeRegistration)
     {
     }
     virtual ~TriggerScreenshot() = default;
@@ -55,6 +59,11 @@ class TriggerScreenshot : public star::common::IEvent
     {
         return m_targetTextureReadySemaphore;
     }
+    /// Handle the target texture is declared under in the command order graph, if it is declared there
+    const std::optional<Handle> &getTargetTextureResource() const
+    {
+        return m_targetTextureResource;
+    }
     const Handle &getTargetCommandBuffer() const
     {
         return m_targetCommandBuffer;
@@ -72,6 +81,7 @@ class TriggerScreenshot : public star::common::IEvent
     StarTextures::Texture m_targetTexture;
     std::string m_screenshotPath;
     const Handle *m_targetTextureReadySemaphore{nullptr};
+    std::optional<Handle> m_targetTextureResource;
     const Handle &m_targetCommandBuffer;
     Handle &m_calleeRegistration;
 };
@@ -4,6 +4,7 @@
 #include "StarCommandBuffer.hpp"
 #include "device/StarDevice.hpp"
 #include "device/managers/Queue.hpp"
+#include "internals/SubmissionPlanner.hpp"
 
 #include <absl/container/flat_hash_map.h>
 #include <star_common/FrameTracker.hpp>
@@ -99,6 +100,8 @@ class CommandBufferContainer
         bool recordOnce;
         vk::PipelineStageFlags waitStage;
         Command_Buffer_Order order;
+        /// Position of the buffer within its order group, set when the buffer is added to the container
+        Command_Buffer_Order_Index subOrder = Command_Buffer_Order_Index::dont_care;
         std::optional<std::function<void(const int &)>> beforeBufferSubmissionCallback;
         std::optional<
             std::function<vk::Semaphore(StarCommandBuffer &, const common::FrameTracker &, std::vector<vk::Semaphore> *,
@@ -107,6 +110,9 @@ class CommandBufferContainer
             overrideBufferSubmissionCallback;
         SemaphoreInfo oneTimeWaitSemaphoreInfo;
         PerFrameScratchData scratch;
+        /// Set by the command order graph when nothing uses the results of the buffer, it is then neither recorded nor
+        /// submitted. Ignored for the main graphics buffer.
+        bool isCulled = false;
 
         CompleteRequest(
             std::function<void(StarCommandBuffer &, const common::FrameTracker &, const uint64_t &)>
@@ -121,8 +127,11 @@ class CommandBufferContainer
                                                       std::vector<std::optional<uint64_t>> &, star::StarQueue &)>>
                 overrideBufferSubmissionCallback = std::nullopt);
 
+        /// Hand the buffer to the planner, or submit it directly through the override callback after flushing the
+        /// planner. The returned semaphore is signaled once the planner has been flushed.
         vk::Semaphore submitCommandBuffer(core::device::StarDevice &device, const common::FrameTracker &frameTracker,
                                           absl::flat_hash_map<star::Queue_Type, StarQueue *> &queues,
+                                          SubmissionPlanner &planner,
                                           std::vector<vk::Semaphore> *beforeSemaphores = nullptr);
     };
 
@@ -135,6 +144,24 @@ class CommandBufferContainer
                                        absl::flat_hash_map<star::Queue_Type, StarQueue *> &queues,
                                        std::vector<vk::Semaphore> *waitSemaphores = nullptr);
 
+    /// Run the callbacks of a single request and queue its submission
+    vk::Semaphore submitRequest(core::device::StarDevice &device, CompleteRequest &request,
+                                const common::FrameTracker &frameTracker, const uint64_t &currentFrameIndex,
+                                absl::flat_hash_map<star::Queue_Type, StarQueue *> &queues,
+                                std::vector<vk::Semaphore> *waitSemaphores = nullptr);
+
+    /// Start collecting the submissions of a new frame
+    void beginFrame(const common::FrameTracker &frameTracker)
+    {
+        m_planner.beginFrame(frameTracker.getCurrent().getFrameInFlightIndex());
+    }
+
+    /// Submit every buffer collected since the last flush
+    void flushSubmissions()
+    {
+        m_planner.flush();
+    }
+
     star::Handle add(std::shared_ptr<CompleteRequest> newRequest, const bool &willBeSubmittedEachFrame,
                      const star::Queue_Type &type, const star::Command_Buffer_Order &order,
                      const star::Command_Buffer_Order_Index &subOrder);
@@ -231,6 +258,8 @@ class CommandBufferContainer
     // Indicates if all semaphores are updated with the proper order of execution
     bool subOrderSemaphoresUpToDate = false;
 
+    SubmissionPlanner m_planner;
+
     void updateSemaphores();
 };
 } // namespace star
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "StarCommandBuffer.hpp"
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace star
+{
+/// Collects the command buffers submitted during a frame and hands consecutive buffers bound for the same queue to
+/// vulkan in one submission. Every buffer keeps its own submit info, and with it the semaphores it waits on and
+/// signals, so the order between passes is unchanged. Only the number of calls into the driver shrinks.
+///
+/// A queue submission can only signal one fence, so the planner owns a fence for each submission it makes in a frame
+/// in flight and the buffers of that submission wait on it in place of their own.
+class SubmissionPlanner
+{
+  public:
+    SubmissionPlanner() = default;
+    SubmissionPlanner(const SubmissionPlanner &) = delete;
+    SubmissionPlanner &operator=(const SubmissionPlanner &) = delete;
+
+    void prepRender(vk::Device device, const uint8_t &numFramesInFlight);
+
+    void cleanupRender();
+
+    /// Start collecting the submissions of a frame in flight, anything still pending is submitted first
+    void beginFrame(const uint8_t &frameInFlightIndex);
+
+    /// Queue the buffer for submission. Buffers are submitted in the order they are added, a change of queue submits
+    /// whatever was collected for the previous one.
+    void add(vk::Queue queue, StarCommandBuffer &commandBuffer,
+             const std::vector<std::pair<vk::Semaphore, vk::PipelineStageFlags>> *additionalWaits = nullptr,
+             const std::vector<std::optional<uint64_t>> *additionalWaitsSignaledValues = nullptr);
+
+    /// Submit everything collected so far. Must be called before anything else submits to the queue or waits on a
+    /// semaphore signaled by a collected buffer.
+    void flush();
+
+  private:
+    struct Entry
+    {
+        StarCommandBuffer *commandBuffer = nullptr;
+        uint32_t waitOffset = 0;
+        uint32_t waitCount = 0;
+        uint32_t signalOffset = 0;
+        uint32_t signalCount = 0;
+    };
+
+    /// Fence of one submission along with the buffers it was signaled for
+    struct FenceSlot
+    {
+        vk::Fence fence{VK_NULL_HANDLE};
+        std::vector<StarCommandBuffer *> commandBuffers;
+    };
+
+    vk::Device m_device{VK_NULL_HANDLE};
+    uint8_t m_frameInFlightIndex = 0;
+    vk::Queue m_queue{VK_NULL_HANDLE};
+    size_t m_numSubmissions = 0;
+    std::vector<std::vector<FenceSlot>> m_fences;
+
+    // kept between frames so a steady frame does not allocate
+    std::vector<Entry> m_entries;
+    std::vector<vk::SemaphoreSubmitInfo> m_waits;
+    std::vector<vk::SemaphoreSubmitInfo> m_signals;
+    std::vector<vk::CommandBufferSubmitInfo> m_commandBufferInfos;
+    std::vector<vk::SubmitInfo2> m_submitInfos;
+
+    FenceSlot &acquireFence();
+};
+} // namespace star
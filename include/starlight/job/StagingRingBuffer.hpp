@@ -0,0 +1,67 @@
+#pragma once
+
+#include "StarBuffers/Buffer.hpp"
+#include "TransferRequest_Buffer.hpp"
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.hpp>
+
+#include <deque>
+#include <memory>
+#include <optional>
+
+namespace star::job
+{
+/// Persistently mapped staging memory owned by a single transfer worker. Regions are handed out in submission order and
+/// returned once the GPU work reading from them has completed. Requests which do not fit are expected to fall back to a
+/// dedicated staging allocation.
+class StagingRingBuffer
+{
+  public:
+    struct Region
+    {
+        vk::DeviceSize offset = 0;
+        vk::DeviceSize size = 0;
+    };
+
+    StagingRingBuffer(VmaAllocator &allocator, const vk::DeviceSize &capacity);
+    StagingRingBuffer(const StagingRingBuffer &) = delete;
+    StagingRingBuffer &operator=(const StagingRingBuffer &) = delete;
+    ~StagingRingBuffer() = default;
+
+    /// Suballocate space for the provided staging layout
+    /// @return view into the ring along with the region to release once the GPU is done with it, or std::nullopt if
+    /// the ring does not currently have enough free space
+    std::optional<std::pair<std::unique_ptr<StarBuffers::Buffer>, Region>> allocate(
+        const TransferRequest::StagingLayout &layout);
+
+    /// Return a region previously provided by allocate. Regions may be released in any order, space is reclaimed once
+    /// every older region has also been released.
+    void release(const Region &region);
+
+    void cleanupRender(vk::Device &device);
+
+    const vk::DeviceSize &getCapacity() const
+    {
+        return m_capacity;
+    }
+
+  private:
+    struct InFlightRegion
+    {
+        Region region;
+        bool released = false;
+    };
+
+    static constexpr vk::DeviceSize MinRegionAlignment = 16;
+
+    vk::DeviceSize m_capacity = 0;
+    vk::DeviceSize m_head = 0;
+    std::unique_ptr<StarBuffers::Buffer> m_buffer = nullptr;
+    std::deque<InFlightRegion> m_inFlight;
+
+    std::optional<vk::DeviceSize> findSpace(const vk::DeviceSize &size, const vk::DeviceSize &alignment) const;
+
+    static vk::DeviceSize AlignUp(const vk::DeviceSize &value, const vk::DeviceSize &alignment);
+};
+} // namespace star::job
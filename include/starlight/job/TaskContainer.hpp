@@ -3,15 +3,15 @@
 #include "job/tasks/Task.hpp"
 #include "logging/LoggingFactory.hpp"
 
-#include <boost/atomic/atomic.hpp>
-#include <boost/lockfree/queue.hpp>
-
 #include <atomic>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <optional>
-#include <sstream>
+#include <string>
 #include <thread>
-#include <vector>
 
 namespace star::job
 {
@@ -20,12 +20,21 @@ concept TTaskLike = requires(TTask t) {
     { t.reset() } -> std::same_as<void>;
 };
 
-template <TTaskLike TTask, size_t TMaxSize> class TaskContainer
+/// Bounded multi-producer multi-consumer queue of tasks. Capacity is chosen at construction. Producers which find
+/// the container full sleep on the pending count through atomic wait and are woken as consumers free up space.
+template <TTaskLike TTask> class TaskContainer
 {
   public:
-    TaskContainer() : m_tasks(TMaxSize)
+    static constexpr size_t DefaultCapacity = 64;
+
+    explicit TaskContainer(size_t capacity = DefaultCapacity)
+        : m_capacity(CheckCapacity(capacity)), m_numCells(RoundUpToPowerOfTwo(capacity)),
+          m_cellMask(m_numCells - 1), m_cells(std::make_unique<Cell[]>(m_numCells))
     {
-        initAvailableSpaces(TMaxSize);
+        for (size_t i = 0; i < m_numCells; i++)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
     }
     TaskContainer(const TaskContainer &other) = delete;
     TaskContainer &operator=(const TaskContainer &) = delete;
@@ -40,92 +49,56 @@ template <TTaskLike TTask, size_t TMaxSize> class TaskContainer
         static_assert(std::is_nothrow_move_assignable_v<TTask> && std::is_nothrow_move_constructible_v<TTask>,
                       "TTask must be noexcept moveable for lock-free placement.");
 
-        auto maybeSpace = tryGetNextAvailableSpace();
-        if (!maybeSpace.has_value())
+        if (!tryReserveSpace())
             return false;
 
-        const uint32_t newSpace = maybeSpace.value();
-        m_tasks[newSpace] = std::move(newTask);
-
-        m_pending.fetch_add(1, std::memory_order_release);
-
-        bool printedMessage = false;
-        int pushTryCounter = 0;
-        while (!m_queuedTasks.push(newSpace))
-        {
-            if (!printedMessage)
-            {
-                star::core::logging::warning("Failed to push queued task. Entering try loop");
-                printedMessage = true;
-            }
-
-            pushTryCounter++;
-            if (pushTryCounter % 50 == 0)
-            {
-                std::this_thread::yield();
-            }
-        }
-
+        push(std::move(newTask));
         return true;
     }
 
-    /// Blocking variant. Busy-waits for an available slot if the container is full.
+    /// Blocking variant. Sleeps until a consumer frees a slot if the container is full.
     void queueTaskBlocking(TTask &&newTask)
     {
         static_assert(std::is_nothrow_move_assignable_v<TTask> && std::is_nothrow_move_constructible_v<TTask>,
                       "TTask must be noexcept moveable for lock-free placement.");
 
-        const uint32_t newSpace = getNextAvailableSpace();
-        m_tasks[newSpace] = std::move(newTask);
+        reserveSpace();
+        push(std::move(newTask));
+    }
 
-        m_pending.fetch_add(1, std::memory_order_release);
+    std::optional<TTask> getQueuedTask()
+    {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
 
-        bool printedMessage = false;
-        int pushTryCounter = 0;
-        while (!m_queuedTasks.push(newSpace))
+        while (true)
         {
-            if (!printedMessage)
+            cell = &m_cells[pos & m_cellMask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0)
             {
-                star::core::logging::warning("Failed to push queued task. Entering try loop");
-                printedMessage = true;
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
             }
-
-            pushTryCounter++;
-            if (pushTryCounter % 50 == 0)
+            else if (diff < 0)
             {
-                std::this_thread::yield();
+                return std::nullopt;
             }
-        }
-    }
-
-    std::optional<TTask> getQueuedTask()
-    {
-        uint32_t queuedIndex = 0;
-        if (!m_queuedTasks.pop(queuedIndex))
-        {
-            return std::nullopt;
-        }
-
-        assert(queuedIndex < TMaxSize && "Popped queued task is beyond available range");
-
-        auto tmp = std::make_optional<TTask>(std::move(m_tasks[queuedIndex]));
-
-        int pushTryCounter = 0;
-        bool printedMessage = false;
-        while (!m_availableSpaces.push(queuedIndex))
-        {
-            if (!printedMessage)
+            else
             {
-                star::core::logging::warning("Failed to push available space. Entering try loop");
-                if (pushTryCounter % 50 == 0)
-                {
-                    std::this_thread::yield();
-                }
-                printedMessage = true;
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
             }
         }
 
+        auto tmp = std::make_optional<TTask>(std::move(cell->task));
+        cell->sequence.store(pos + m_numCells, std::memory_order_release);
+
+        // the slot is only handed back once the cell is reusable, producers waiting on a full container wake here
         m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        m_pending.notify_one();
+
         return tmp;
     }
 
@@ -136,35 +109,58 @@ template <TTaskLike TTask, size_t TMaxSize> class TaskContainer
 
     bool isFull() const noexcept
     {
-        return m_pending.load(std::memory_order_relaxed) == TMaxSize;
+        return m_pending.load(std::memory_order_relaxed) >= m_capacity;
     }
 
-  private:
-    std::vector<TTask> m_tasks;
-    boost::lockfree::queue<uint32_t, boost::lockfree::capacity<TMaxSize>> m_availableSpaces =
-        boost::lockfree::queue<uint32_t, boost::lockfree::capacity<TMaxSize>>();
-    boost::lockfree::queue<uint32_t, boost::lockfree::capacity<TMaxSize>> m_queuedTasks =
-        boost::lockfree::queue<uint32_t, boost::lockfree::capacity<TMaxSize>>();
-    std::atomic<uint32_t> m_pending{0};
-
-    /// Non-blocking attempt to grab an available slot. Returns std::nullopt if full.
-    std::optional<uint32_t> tryGetNextAvailableSpace() noexcept
+    size_t getCapacity() const noexcept
     {
-        uint32_t nextSpace = 0;
-        if (!m_availableSpaces.pop(nextSpace))
-            return std::nullopt;
-        return nextSpace;
+        return m_capacity;
     }
 
-    /// Blocking variant. Busy-waits (with yield) until a slot is available.
-    uint32_t getNextAvailableSpace()
+  private:
+    struct Cell
     {
-        uint32_t nextSpace = 0;
+        std::atomic<size_t> sequence{0};
+        TTask task;
+    };
+
+    const uint32_t m_capacity;
+    const size_t m_numCells;
+    const size_t m_cellMask;
+    std::unique_ptr<Cell[]> m_cells;
 
-        int sleepCounter = 0;
+    // number of slots claimed by producers and not yet released by consumers
+    alignas(64) std::atomic<uint32_t> m_pending{0};
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<size_t> m_dequeuePos{0};
+
+    bool tryReserveSpace() noexcept
+    {
+        uint32_t pending = m_pending.load(std::memory_order_relaxed);
+        while (pending < m_capacity)
+        {
+            if (m_pending.compare_exchange_weak(pending, pending + 1, std::memory_order_acq_rel))
+                return true;
+        }
+
+        return false;
+    }
+
+    /// Blocking variant. Sleeps on the pending count until a slot is available.
+    void reserveSpace()
+    {
         bool hasPrintedWarning = false;
-        while (!m_availableSpaces.pop(nextSpace))
+
+        uint32_t pending = m_pending.load(std::memory_order_relaxed);
+        while (true)
         {
+            if (pending < m_capacity)
+            {
+                if (m_pending.compare_exchange_weak(pending, pending + 1, std::memory_order_acq_rel))
+                    break;
+                continue;
+            }
+
             if (!hasPrintedWarning)
             {
                 core::logging::log(boost::log::trivial::warning,
@@ -172,37 +168,53 @@ template <TTaskLike TTask, size_t TMaxSize> class TaskContainer
                 hasPrintedWarning = true;
             }
 
-            if (sleepCounter % 50 == 0){
-                std::this_thread::yield();
-            }
-
-            sleepCounter++;
+            m_pending.wait(pending, std::memory_order_acquire);
+            pending = m_pending.load(std::memory_order_relaxed);
         }
 
         if (hasPrintedWarning)
         {
-            std::ostringstream oss;
-            oss << "Waiting done. Sleep looper counter: " << sleepCounter;
-            core::logging::log(boost::log::trivial::info, oss.str());
+            core::logging::log(boost::log::trivial::info, "Waiting done. Task container has space available.");
         }
+    }
 
-        return nextSpace;
+    /// Place a task into the ring. Caller must already hold a slot from tryReserveSpace or reserveSpace.
+    void push(TTask &&newTask) noexcept
+    {
+        const size_t pos = m_enqueuePos.fetch_add(1, std::memory_order_relaxed);
+        Cell &cell = m_cells[pos & m_cellMask];
+
+        // holding a slot guarantees the cell has been emptied, a consumer may still be publishing that though
+        while (cell.sequence.load(std::memory_order_acquire) != pos)
+        {
+            std::this_thread::yield();
+        }
+
+        cell.task = std::move(newTask);
+        cell.sequence.store(pos + 1, std::memory_order_release);
     }
 
-    void initAvailableSpaces(const uint32_t &size)
+    /// The pending count is 32 bits so producers can sleep on it through atomic wait, capacities it cannot count
+    /// up to are rejected rather than truncated
+    static uint32_t CheckCapacity(size_t capacity)
     {
-        for (uint32_t i = 0; i < size; i++)
+        if (capacity == 0)
+            STAR_THROW("Task container requires a non-zero capacity");
+        if (capacity > std::numeric_limits<uint32_t>::max())
+            STAR_THROW("Task container capacity exceeds the maximum of " +
+                       std::to_string(std::numeric_limits<uint32_t>::max()));
+
+        return static_cast<uint32_t>(capacity);
+    }
+
+    static size_t RoundUpToPowerOfTwo(size_t value) noexcept
+    {
+        size_t result = 1;
+        while (result < value)
         {
-            int tryCounter = 0;
-            while (!m_availableSpaces.push(i))
-            {
-                tryCounter++;
-                if (tryCounter == 25)
-                {
-                    STAR_THROW("Failed to initialize space");
-                }
-            }
+            result <<= 1;
         }
+        return result;
     }
 };
-} // namespace star::job
\ No newline at end of file
+} // namespace star::job
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FrameScheduler.hpp"
+#include "WorkStealingExecutor.hpp"
 #include "complete_tasks/CompleteTask.hpp"
 #include "job/worker/Worker.hpp"
 
@@ -19,7 +20,11 @@ namespace star::job
 class TaskManager
 {
   public:
-    TaskManager() : m_completeTasks(std::make_unique<job::TaskContainer<job::complete_tasks::CompleteTask, 128>>()){};
+    static constexpr size_t CompleteMessageCapacity = 128;
+
+    TaskManager()
+        : m_completeTasks(
+              std::make_unique<job::TaskContainer<job::complete_tasks::CompleteTask>>(CompleteMessageCapacity)){};
     TaskManager(const TaskManager &) = delete;
     TaskManager &operator=(const TaskManager &) = delete;
     TaskManager(TaskManager &&) = default;
@@ -37,6 +42,16 @@ class TaskManager
 
     size_t getNumOfWorkersForType(const Handle &registeredTaskType) const noexcept;
 
+    /// Start the shared executor which workers using ExecutorTaskHandlingPolicy submit to
+    void initExecutor(size_t numThreads);
+
+    bool hasExecutor() const noexcept
+    {
+        return m_executor != nullptr;
+    }
+
+    WorkStealingExecutor &getExecutor();
+
     /// <summary>
     /// Submit a task to one of the workers for the provided handle type. Blocking
     /// false if the targeted worker's queue is full, true on success.
@@ -108,7 +123,7 @@ class TaskManager
         worker->queueTask(static_cast<void *>(&newTask));
     }
 
-    job::TaskContainer<job::complete_tasks::CompleteTask, 128> *getCompleteMessages() noexcept
+    job::TaskContainer<job::complete_tasks::CompleteTask> *getCompleteMessages() noexcept
     {
         return m_completeTasks.get();
     }
@@ -121,7 +136,8 @@ class TaskManager
   private:
     absl::flat_hash_map<uint16_t, std::vector<worker::Worker>> m_workers;
 
-    std::unique_ptr<job::TaskContainer<job::complete_tasks::CompleteTask, 128>> m_completeTasks = nullptr;
+    std::unique_ptr<job::TaskContainer<job::complete_tasks::CompleteTask>> m_completeTasks = nullptr;
+    std::unique_ptr<WorkStealingExecutor> m_executor = nullptr;
 
     absl::flat_hash_map<uint16_t, size_t> m_nextWorkerIndex;
 
@@ -6,6 +6,7 @@
 #include "StarCommandPool.hpp"
 #include "StarQueueFamily.hpp"
 #include "StarTextures/Texture.hpp"
+#include "StagingRingBuffer.hpp"
 #include "TransferRequest_Buffer.hpp"
 #include "TransferRequest_Texture.hpp"
 #include "core/graphics/GPUWorkSyncInfo.hpp"
@@ -89,37 +90,84 @@ class TransferManagerThread
                            std::unique_ptr<StarCommandBuffer> commandBuffer)
             : commandPool(std::move(commandPool)), commandBuffer(std::move(commandBuffer)) {};
 
+        /// Keep a staging buffer alive until the command buffer reading from it has completed. A batched submission
+        /// records several requests into the same command buffer, so more than one source buffer can be held.
         void setInProcessDeps(std::unique_ptr<StarBuffers::Buffer> nInProcessTransferSrcBuffer)
         {
-            this->inProcessTransferSrcBuffer = std::move(nInProcessTransferSrcBuffer);
+            this->inProcessDeps.push_back(InProcessDep{.transferSrcBuffer = std::move(nInProcessTransferSrcBuffer)});
+        }
+
+        /// Same as above but the source buffer is a region of the worker's staging ring which is returned to the ring
+        /// once the transfer has completed
+        void setInProcessDeps(std::unique_ptr<StarBuffers::Buffer> nInProcessTransferSrcBuffer,
+                              StagingRingBuffer *stagingRing, const StagingRingBuffer::Region &stagingRegion)
+        {
+            this->inProcessDeps.push_back(InProcessDep{.transferSrcBuffer = std::move(nInProcessTransferSrcBuffer),
+                                                       .stagingRing = stagingRing,
+                                                       .stagingRegion = stagingRegion});
         }
 
         void markAsAvailable(vk::Device device)
         {
-            if (inProcessTransferSrcBuffer)
+            for (auto &dep : this->inProcessDeps)
             {
-                inProcessTransferSrcBuffer->cleanupRender(device);
+                if (dep.transferSrcBuffer)
+                {
+                    dep.transferSrcBuffer->cleanupRender(device);
+                }
+
+                if (dep.stagingRing != nullptr && dep.stagingRegion.has_value())
+                {
+                    dep.stagingRing->release(dep.stagingRegion.value());
+                }
             }
 
-            this->inProcessTransferSrcBuffer.reset();
-            this->inProcessTransferSrcBuffer = nullptr;
+            this->inProcessDeps.clear();
         }
 
         bool isMarkedAsAvailable() const
         {
-            return this->inProcessTransferSrcBuffer == nullptr;
+            return this->inProcessDeps.empty();
         }
 
       private:
-        std::unique_ptr<StarBuffers::Buffer> inProcessTransferSrcBuffer = nullptr;
+        struct InProcessDep
+        {
+            std::unique_ptr<StarBuffers::Buffer> transferSrcBuffer = nullptr;
+            StagingRingBuffer *stagingRing = nullptr;
+            std::optional<StagingRingBuffer::Region> stagingRegion = std::nullopt;
+        };
+
+        std::vector<InProcessDep> inProcessDeps;
     };
 
+    /// Record the upload of a buffer request into the command buffer of processInfo without ending or submitting it
+    /// @return number of bytes staged for the request
+    static vk::DeviceSize RecordBuffer(vk::Device device, VmaAllocator allocator,
+                                       const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
+                                       ProcessRequestInfo &processInfo, TransferRequest::Buffer *newBufferRequest,
+                                       std::unique_ptr<StarBuffers::Buffer> *resultingBuffer,
+                                       StagingRingBuffer *stagingRing = nullptr);
+
+    /// Record the upload of a texture request into the command buffer of processInfo without ending or submitting it
+    /// @return number of bytes staged for the request
+    static vk::DeviceSize RecordTexture(vk::Device device, VmaAllocator allocator,
+                                        const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
+                                        ProcessRequestInfo &processInfo, TransferRequest::Texture *newTextureRequest,
+                                        std::unique_ptr<StarTextures::Texture> *resultingTexture);
+
+    /// End the command buffer of processInfo and submit it once. Every wait and signal of the provided sync infos is
+    /// attached to the submission, semaphores which appear more than once only keep their highest value.
+    static void Submit(StarQueue &queue, ProcessRequestInfo &processInfo,
+                       const std::vector<const core::graphics::GPUWorkSyncInfo *> &syncInfos);
+
     static void CreateBuffer(vk::Device device, VmaAllocator allocator, StarQueue &queue,
                              const vk::PhysicalDeviceProperties &deviceProperties,
                              const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
                              ProcessRequestInfo &processInfo, TransferRequest::Buffer *newBufferRequest,
                              std::unique_ptr<StarBuffers::Buffer> *resultingBuffer,
-                             boost::atomic<bool> *gpuDoneSignalMain, core::graphics::GPUWorkSyncInfo &syncInfo);
+                             boost::atomic<bool> *gpuDoneSignalMain, core::graphics::GPUWorkSyncInfo &syncInfo,
+                             StagingRingBuffer *stagingRing = nullptr);
 
     static void CreateTexture(vk::Device device, VmaAllocator allocator, StarQueue &queue,
                               const vk::PhysicalDeviceProperties &deviceProperties,
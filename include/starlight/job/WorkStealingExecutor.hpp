@@ -0,0 +1,123 @@
+#pragma once
+
+#include <boost/thread.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace star::job
+{
+/// Fixed set of threads shared by every task type which is registered against it. Each thread owns one deque per
+/// priority. Threads run their own work newest first and, once empty, steal the oldest work from the other threads.
+/// Idle threads sleep on an atomic wait until new work is submitted.
+class WorkStealingExecutor
+{
+  public:
+    enum class Priority : uint8_t
+    {
+        High = 0,
+        Normal = 1,
+        Background = 2
+    };
+    static constexpr size_t NumPriorities = 3;
+
+    /// Move only, type erased unit of work
+    class Job
+    {
+      public:
+        Job() = default;
+        template <typename TCallable>
+            requires(!std::is_same_v<std::decay_t<TCallable>, Job>)
+        explicit Job(TCallable &&callable)
+            : m_impl(std::make_unique<Model<std::decay_t<TCallable>>>(std::forward<TCallable>(callable)))
+        {
+        }
+
+        void operator()()
+        {
+            m_impl->execute();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_impl != nullptr;
+        }
+
+      private:
+        struct Concept
+        {
+            virtual ~Concept() = default;
+            virtual void execute() = 0;
+        };
+
+        template <typename T> struct Model : public Concept
+        {
+            T callable;
+            explicit Model(T &&callable) : callable(std::move(callable))
+            {
+            }
+            void execute() override
+            {
+                callable();
+            }
+        };
+
+        std::unique_ptr<Concept> m_impl = nullptr;
+    };
+
+    explicit WorkStealingExecutor(size_t numThreads);
+    WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+    WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+    WorkStealingExecutor(WorkStealingExecutor &&) = delete;
+    WorkStealingExecutor &operator=(WorkStealingExecutor &&) = delete;
+    ~WorkStealingExecutor();
+
+    /// Queue work on the executor. Work submitted from one of the executor threads stays on that thread's deque,
+    /// otherwise it is placed on the deque of the thread given by affinity.
+    /// @param affinity Preferred thread, usually obtained from reserveAffinity so work of one type shares a cache
+    void submit(Job job, Priority priority = Priority::Normal, std::optional<size_t> affinity = std::nullopt);
+
+    /// Hand out home threads round robin, so task types registered one after another land on different cores
+    size_t reserveAffinity() noexcept;
+
+    size_t getNumThreads() const noexcept
+    {
+        return m_queues.size();
+    }
+
+    /// Finish all queued work and join the threads. Safe to call more than once.
+    void shutdown();
+
+  private:
+    struct alignas(64) ThreadQueues
+    {
+        std::mutex mutex;
+        std::array<std::deque<Job>, NumPriorities> jobs;
+    };
+
+    std::vector<std::unique_ptr<ThreadQueues>> m_queues;
+    std::vector<boost::thread> m_threads;
+    std::atomic<bool> m_shouldRun{true};
+    std::atomic<size_t> m_nextAffinity{0};
+    alignas(64) std::atomic<uint32_t> m_numQueued{0};
+    alignas(64) std::atomic<uint32_t> m_workEpoch{0};
+
+    static thread_local const WorkStealingExecutor *s_currentExecutor;
+    static thread_local size_t s_currentThreadIndex;
+
+    void threadFunction(size_t index);
+
+    std::optional<Job> findWork(size_t index);
+
+    std::optional<Job> popNewest(size_t index, size_t priority);
+
+    std::optional<Job> stealOldest(size_t victim, size_t priority);
+};
+} // namespace star::job
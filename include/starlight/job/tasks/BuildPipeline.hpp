@@ -1,6 +1,7 @@
 #pragma once
 
 #include "StarPipeline.hpp"
+#include "core/device/PipelineCache.hpp"
 #include "job/tasks/Task.hpp"
 
 #include <vulkan/vulkan.hpp>
@@ -15,6 +16,7 @@ constexpr std::string_view BuildPipelineTaskName = "star::job::tasks::build_pipe
 struct PipelineBuildPayload
 {
     vk::Device device;
+    core::device::PipelineCache *pipelineCache = nullptr;
     uint32_t handleID;
     std::unique_ptr<star::StarPipeline::RenderResourceDependencies> deps = nullptr;
     std::unique_ptr<star::StarPipeline> pipeline = nullptr;
@@ -26,6 +28,6 @@ void ExecuteBuildPipeline(void *p);
 
 std::optional<star::job::complete_tasks::CompleteTask> CreateBuildComplete(void *p);
 
-BuildPipelineTask CreateBuildPipeline(vk::Device device, Handle handle,
+BuildPipelineTask CreateBuildPipeline(vk::Device device, core::device::PipelineCache *pipelineCache, Handle handle,
                                       star::StarPipeline::RenderResourceDependencies buildDeps, StarPipeline pipeline);
 } // namespace star::job::tasks::build_pipeline
\ No newline at end of file
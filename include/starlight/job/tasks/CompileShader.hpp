@@ -1,6 +1,7 @@
 #pragma once
 
 #include "StarShader.hpp"
+#include "common/ShaderCache.hpp"
 #include "job/complete_tasks/CompleteTask.hpp"
 #include "job/tasks/Task.hpp"
 #include <star_common/Handle.hpp>
@@ -15,8 +16,11 @@ struct CompileShaderPayload
 {
     std::string path;
     star::Shader_Stage stage;
+    star::Shader_Optimization optimization;
     uint32_t handleID;
     std::unique_ptr<Compiler> compiler = nullptr;
+    /// Consulted before compiling, null to always compile
+    ShaderCache *cache = nullptr;
     std::unique_ptr<StarShader> finalizedShaderObject = nullptr;
     std::shared_ptr<std::vector<uint32_t>> compiledShaderCode = nullptr;
 };
@@ -27,7 +31,7 @@ std::optional<star::job::complete_tasks::CompleteTask> CreateComplete(void *p);
 
 void Execute(void *p);
 
-CompileShaderTask Create(const std::string &fileName, const star::Shader_Stage &stage, const Handle &shaderHandle,
-                         Compiler compiler);
+CompileShaderTask Create(const std::string &fileName, const star::Shader_Stage &stage,
+                         const star::Shader_Optimization &optimization, const Handle &shaderHandle, Compiler compiler);
 
 } // namespace star::job::tasks::compile_shader
\ No newline at end of file
@@ -14,7 +14,7 @@ namespace star::job::worker
 template <typename TThreadPolicy>
 concept ThreadFunctionPolicyLike =
     requires(std::string workerName, TThreadPolicy threadPolicy,
-             TaskContainer<complete_tasks::CompleteTask, 128> *completeMessages, void *rawTask) {
+             TaskContainer<complete_tasks::CompleteTask> *completeMessages, void *rawTask) {
         { threadPolicy.init(workerName, completeMessages) } -> std::same_as<void>;
         { threadPolicy.isTaskQueueFull(rawTask) } -> std::same_as<bool>;
         { threadPolicy.queueTask(rawTask) } -> std::same_as<void>;
@@ -49,7 +49,7 @@ template <ThreadFunctionPolicyLike TThreadPolicy> class DefaultWorker
         return m_threadPolicy.isTaskQueueFull(task);
     }
 
-    void setCompleteMessageCommunicationStructure(TaskContainer<complete_tasks::CompleteTask, 128> *completeMessages)
+    void setCompleteMessageCommunicationStructure(TaskContainer<complete_tasks::CompleteTask> *completeMessages)
     {
         m_threadPolicy.init(m_workerName, completeMessages);
     }
@@ -19,7 +19,7 @@ class Worker
         virtual void doCleanup() = 0;
         virtual void doQueueTask(void *task) = 0;
         virtual void doSetCompleteMessageCommunicationStructure(
-            TaskContainer<complete_tasks::CompleteTask, 128> *completeMessages) = 0;
+            TaskContainer<complete_tasks::CompleteTask> *completeMessages) = 0;
     };
 
     template <typename TWorker>
@@ -48,7 +48,7 @@ class Worker
         m_pimpl->doQueueTask(task);
     }
 
-    void setCompleteMessageCommunicationStructure(TaskContainer<complete_tasks::CompleteTask, 128> *completeMessages)
+    void setCompleteMessageCommunicationStructure(TaskContainer<complete_tasks::CompleteTask> *completeMessages)
     {
         m_pimpl->doSetCompleteMessageCommunicationStructure(completeMessages);
     }
@@ -85,7 +85,7 @@ class Worker
         }
 
         void doSetCompleteMessageCommunicationStructure(
-            TaskContainer<complete_tasks::CompleteTask, 128> *completeMessages) override
+            TaskContainer<complete_tasks::CompleteTask> *completeMessages) override
         {
             m_worker.setCompleteMessageCommunicationStructure(completeMessages);
         }
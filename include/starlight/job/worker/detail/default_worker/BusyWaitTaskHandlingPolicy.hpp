@@ -10,7 +10,7 @@
 
 namespace star::job::worker::default_worker
 {
-template <typename TTask, size_t TQueueSize> class BusyWaitTaskHandlingPolicy
+template <typename TTask> class BusyWaitTaskHandlingPolicy
 {
   public:
     BusyWaitTaskHandlingPolicy()
@@ -18,8 +18,10 @@ template <typename TTask, size_t TQueueSize> class BusyWaitTaskHandlingPolicy
     {
     }
 
-    explicit BusyWaitTaskHandlingPolicy(bool waitForWorkToFinishBeforeExiting)
-        : m_waitForWorkToFinishBeforeExiting(waitForWorkToFinishBeforeExiting),
+    /// @param queueSize Number of tasks which can be waiting on the worker before producers are blocked
+    explicit BusyWaitTaskHandlingPolicy(bool waitForWorkToFinishBeforeExiting,
+                                        size_t queueSize = TaskContainer<TTask>::DefaultCapacity)
+        : m_waitForWorkToFinishBeforeExiting(waitForWorkToFinishBeforeExiting), m_queueSize(queueSize),
           m_shouldRun(std::make_shared<boost::atomic<bool>>())
     {
     }
@@ -35,7 +37,7 @@ template <typename TTask, size_t TQueueSize> class BusyWaitTaskHandlingPolicy
         }
     };
 
-    void init(std::string workerName, TaskContainer<complete_tasks::CompleteTask, 128> *completeMessages)
+    void init(std::string workerName, TaskContainer<complete_tasks::CompleteTask> *completeMessages)
     {
         m_workerName = std::move(workerName);
         m_completeMessages = completeMessages;
@@ -71,16 +73,17 @@ template <typename TTask, size_t TQueueSize> class BusyWaitTaskHandlingPolicy
 
   protected:
     bool m_waitForWorkToFinishBeforeExiting = false;
+    size_t m_queueSize = TaskContainer<TTask>::DefaultCapacity;
     std::shared_ptr<boost::atomic<bool>> m_shouldRun = nullptr;
-    std::shared_ptr<job::TaskContainer<TTask, TQueueSize>> m_tasks = nullptr;
-    TaskContainer<complete_tasks::CompleteTask, 128> *m_completeMessages = nullptr;
+    std::shared_ptr<job::TaskContainer<TTask>> m_tasks = nullptr;
+    TaskContainer<complete_tasks::CompleteTask> *m_completeMessages = nullptr;
     boost::thread thread;
     std::string m_workerName;
 
     void startThread()
     {
         m_shouldRun->store(true);
-        m_tasks = std::make_shared<job::TaskContainer<TTask, TQueueSize>>();
+        m_tasks = std::make_shared<job::TaskContainer<TTask>>(m_queueSize);
         thread = boost::thread([this, tasks = m_tasks]() { threadFunction(); });
     }
 
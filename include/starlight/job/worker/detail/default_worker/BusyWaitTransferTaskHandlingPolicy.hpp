@@ -2,6 +2,7 @@
 
 #include "StarCommandBuffer.hpp"
 #include "StarCommandPool.hpp"
+#include "job/StagingRingBuffer.hpp"
 #include "job/TaskContainer.hpp"
 #include "job/TransferWorker.hpp"
 #include "job/complete_tasks/CompleteTask.hpp"
@@ -11,22 +12,42 @@
 #include <boost/atomic/atomic.hpp>
 #include <boost/thread.hpp>
 
+#include <chrono>
 #include <queue>
 #include <sstream>
+#include <vector>
 
 namespace star::job::worker::default_worker
 {
-template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
+/// Limits used when a transfer worker folds several queued tasks into a single queue submission
+struct TransferBatchLimits
+{
+    // maximum number of tasks recorded into one command buffer, 1 submits every task on its own
+    size_t maxRequests = 1;
+    // stop adding tasks once this many bytes have been staged, 0 for no limit
+    vk::DeviceSize maxBytes = 0;
+    // how long the first task of a batch may wait for more tasks to arrive
+    std::chrono::microseconds latencyCap{0};
+};
+
+class BusyWaitTransferTaskHandlingPolicy
 {
   public:
     using TransferTask = job::tasks::transfer::TransferTask;
     using TransferPayload = job::tasks::transfer::TransferPayload;
 
+    /// @param queueSize Number of tasks of each priority which can be waiting on the worker before producers are blocked
+    /// @param stagingRingSize Size in bytes of the persistently mapped staging ring owned by the worker. 0 disables the
+    /// ring and every request receives a dedicated staging buffer.
+    /// @param batchLimits Controls how many queued tasks may share one command buffer and queue submission
     BusyWaitTransferTaskHandlingPolicy(bool waitForWorkToFinishBeforeExiting, core::device::StarDevice &device,
-                                       StarQueue queue, const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse)
+                                       StarQueue queue, const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
+                                       size_t queueSize = TaskContainer<TransferTask>::DefaultCapacity,
+                                       vk::DeviceSize stagingRingSize = 0, TransferBatchLimits batchLimits = {})
         : m_waitForWorkToFinishBeforeExiting(waitForWorkToFinishBeforeExiting), m_device(device), m_queue(queue),
-          m_allTransferQueueFamilyIndicesInUse(allTransferQueueFamilyIndicesInUse),
-          m_shouldRun(std::make_shared<boost::atomic<bool>>())
+          m_allTransferQueueFamilyIndicesInUse(allTransferQueueFamilyIndicesInUse), m_queueSize(queueSize),
+          m_stagingRingSize(stagingRingSize),
+          m_batchLimits(std::move(batchLimits)), m_shouldRun(std::make_shared<boost::atomic<bool>>())
     {
     }
 
@@ -43,7 +64,7 @@ template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
         }
     }
 
-    void init(std::string workerName, TaskContainer<complete_tasks::CompleteTask, 128> *completeMessages)
+    void init(std::string workerName, TaskContainer<complete_tasks::CompleteTask> *completeMessages)
     {
         m_workerName = std::move(workerName);
         m_completeMessages = completeMessages;
@@ -93,22 +114,28 @@ template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
     core::device::StarDevice &m_device;
     StarQueue m_queue;
     std::vector<uint32_t> m_allTransferQueueFamilyIndicesInUse;
+    size_t m_queueSize = TaskContainer<TransferTask>::DefaultCapacity;
+    vk::DeviceSize m_stagingRingSize = 0;
+    TransferBatchLimits m_batchLimits;
 
     std::shared_ptr<boost::atomic<bool>> m_shouldRun = nullptr;
-    std::shared_ptr<job::TaskContainer<TransferTask, TQueueSize>> m_highPriorityTasks = nullptr;
-    std::shared_ptr<job::TaskContainer<TransferTask, TQueueSize>> m_standardTasks = nullptr;
-    TaskContainer<complete_tasks::CompleteTask, 128> *m_completeMessages = nullptr;
+    std::shared_ptr<job::TaskContainer<TransferTask>> m_highPriorityTasks = nullptr;
+    std::shared_ptr<job::TaskContainer<TransferTask>> m_standardTasks = nullptr;
+    TaskContainer<complete_tasks::CompleteTask> *m_completeMessages = nullptr;
     boost::thread thread;
     std::string m_workerName;
 
     std::shared_ptr<StarCommandPool> m_commandPool = nullptr;
     std::queue<std::unique_ptr<job::TransferManagerThread::ProcessRequestInfo>> m_processRequestInfos;
+    std::unique_ptr<job::StagingRingBuffer> m_stagingRing = nullptr;
+    // task pulled while building a batch which could not join it, processed before anything else in the queues
+    std::optional<TransferTask> m_deferredTask = std::nullopt;
 
     void startThread()
     {
         m_shouldRun->store(true);
-        m_highPriorityTasks = std::make_shared<job::TaskContainer<TransferTask, TQueueSize>>();
-        m_standardTasks = std::make_shared<job::TaskContainer<TransferTask, TQueueSize>>();
+        m_highPriorityTasks = std::make_shared<job::TaskContainer<TransferTask>>(m_queueSize);
+        m_standardTasks = std::make_shared<job::TaskContainer<TransferTask>>(m_queueSize);
         thread = boost::thread(
             [this, highPriority = m_highPriorityTasks, standard = m_standardTasks]() { threadFunction(); });
     }
@@ -134,6 +161,11 @@ template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
 
         m_commandPool = std::make_shared<StarCommandPool>(device, m_queue.getParentQueueFamilyIndex(), true);
 
+        if (m_stagingRingSize > 0)
+        {
+            m_stagingRing = std::make_unique<job::StagingRingBuffer>(allocator, m_stagingRingSize);
+        }
+
         for (int i = 0; i < 10; i++)
         {
             m_processRequestInfos.push(std::make_unique<job::TransferManagerThread::ProcessRequestInfo>(
@@ -143,22 +175,26 @@ template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
 
         while (true)
         {
-            std::optional<TransferTask> task = m_highPriorityTasks->getQueuedTask();
+            // staging ring regions go back to the ring as soon as their transfer completes, rather than whenever
+            // the info holding them happens to be reused, so an idle or bursty worker does not keep the ring full
+            CheckForCleanups(device, m_processRequestInfos);
 
-            if (!task.has_value())
-                task = m_standardTasks->getQueuedTask();
+            std::optional<TransferTask> task = getNextTask();
 
             if (task.has_value())
             {
-                TransferPayload &payload = *static_cast<TransferPayload *>(task.value().getPayload());
+                if (m_batchLimits.maxRequests > 1)
+                {
+                    processBatch(std::move(task.value()), device, allocator);
+                }
+                else
+                {
+                    TransferPayload &payload = *static_cast<TransferPayload *>(task.value().getPayload());
 
-                assert(payload.request && "Transfer task payload must contain a request envelope");
-                processRequest(*payload.request, device, allocator);
+                    assert(payload.request && "Transfer task payload must contain a request envelope");
+                    processRequest(*payload.request, device, allocator);
 
-                auto message = task.value().getCompleteMessage();
-                if (message.has_value())
-                {
-                    m_completeMessages->queueTask(std::move(message.value()));
+                    completeTask(task.value());
                 }
             }
             else
@@ -168,7 +204,8 @@ template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
 
             if (!m_shouldRun->load())
             {
-                if (!m_waitForWorkToFinishBeforeExiting || (m_highPriorityTasks->empty() && m_standardTasks->empty()))
+                if (!m_waitForWorkToFinishBeforeExiting ||
+                    (!m_deferredTask.has_value() && m_highPriorityTasks->empty() && m_standardTasks->empty()))
                 {
                     break;
                 }
@@ -190,11 +227,154 @@ template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
 
         CheckForCleanups(device, m_processRequestInfos);
 
+        if (m_stagingRing)
+        {
+            m_stagingRing->cleanupRender(device);
+            m_stagingRing.reset();
+        }
+
         m_commandPool->cleanupRender(device);
 
         logStop(m_workerName);
     }
 
+    std::optional<TransferTask> getNextTask()
+    {
+        if (m_deferredTask.has_value())
+        {
+            std::optional<TransferTask> task = std::move(m_deferredTask);
+            m_deferredTask.reset();
+            return task;
+        }
+
+        std::optional<TransferTask> task = m_highPriorityTasks->getQueuedTask();
+        if (!task.has_value())
+            task = m_standardTasks->getQueuedTask();
+
+        return task;
+    }
+
+    void completeTask(TransferTask &task)
+    {
+        auto message = task.getCompleteMessage();
+        if (message.has_value())
+        {
+            m_completeMessages->queueTask(std::move(message.value()));
+        }
+    }
+
+    /// Record the first task along with any tasks queued behind it into one command buffer and submit it once. Tasks
+    /// are added until the request or byte limit is reached, or the latency cap has passed with nothing else queued.
+    void processBatch(TransferTask firstTask, vk::Device device, VmaAllocator allocator)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + m_batchLimits.latencyCap;
+
+        std::unique_ptr<job::TransferManagerThread::ProcessRequestInfo> workingInfo =
+            std::move(m_processRequestInfos.front());
+        m_processRequestInfos.pop();
+
+        EnsureInfoReady(device, *workingInfo);
+
+        std::vector<TransferTask> batch;
+        batch.reserve(m_batchLimits.maxRequests);
+        std::vector<const core::graphics::GPUWorkSyncInfo *> syncInfos;
+        syncInfos.reserve(m_batchLimits.maxRequests);
+
+        vk::DeviceSize stagedBytes = 0;
+        auto addToBatch = [&](TransferTask task) {
+            auto &request = *static_cast<TransferPayload *>(task.getPayload())->request;
+            stagedBytes += recordRequest(request, *workingInfo, device, allocator);
+            syncInfos.push_back(&request.workSyncInfo);
+            batch.push_back(std::move(task));
+        };
+
+        addToBatch(std::move(firstTask));
+
+        while (batch.size() < m_batchLimits.maxRequests &&
+               (m_batchLimits.maxBytes == 0 || stagedBytes < m_batchLimits.maxBytes))
+        {
+            std::optional<TransferTask> next = getNextTask();
+            if (!next.has_value())
+            {
+                if (!m_shouldRun->load() || std::chrono::steady_clock::now() >= deadline)
+                    break;
+
+                wait();
+                continue;
+            }
+
+            if (WaitsOnBatch(*static_cast<TransferPayload *>(next.value().getPayload())->request, syncInfos))
+            {
+                // waiting on a value signaled by this same submission would never complete
+                m_deferredTask = std::move(next);
+                break;
+            }
+
+            addToBatch(std::move(next.value()));
+        }
+
+        job::TransferManagerThread::Submit(m_queue, *workingInfo, syncInfos);
+
+        m_processRequestInfos.push(std::move(workingInfo));
+
+        for (auto &task : batch)
+        {
+            auto &request = *static_cast<TransferPayload *>(task.getPayload())->request;
+            request.gpuDoneNotificationToMain->store(true);
+            request.gpuDoneNotificationToMain->notify_all();
+
+            completeTask(task);
+        }
+    }
+
+    vk::DeviceSize recordRequest(job::TransferManagerThread::InterThreadRequest &request,
+                                 job::TransferManagerThread::ProcessRequestInfo &workingInfo, vk::Device device,
+                                 VmaAllocator allocator)
+    {
+        if (request.bufferTransferRequest)
+        {
+            assert(request.resultingBuffer.has_value() && request.resultingBuffer.value() != nullptr &&
+                   "Buffer request must contain both a request and a resulting address");
+
+            request.bufferTransferRequest->prep();
+
+            return job::TransferManagerThread::RecordBuffer(device, allocator, m_allTransferQueueFamilyIndicesInUse,
+                                                            workingInfo, request.bufferTransferRequest.get(),
+                                                            request.resultingBuffer.value(), m_stagingRing.get());
+        }
+        else if (request.textureTransferRequest)
+        {
+            assert(request.resultingTexture.has_value() && request.resultingTexture.value() != nullptr &&
+                   "Texture request must contain both a request and a resulting address");
+
+            request.textureTransferRequest->prep();
+
+            core::logging::log(boost::log::trivial::info, "Creating Texture");
+
+            return job::TransferManagerThread::RecordTexture(device, allocator, m_allTransferQueueFamilyIndicesInUse,
+                                                             workingInfo, request.textureTransferRequest.get(),
+                                                             request.resultingTexture.value());
+        }
+
+        return 0;
+    }
+
+    static bool WaitsOnBatch(const job::TransferManagerThread::InterThreadRequest &request,
+                             const std::vector<const core::graphics::GPUWorkSyncInfo *> &batchSyncInfos)
+    {
+        if (!request.workSyncInfo.workWaitOn.has_value())
+            return false;
+
+        const auto &waitSemaphore = request.workSyncInfo.workWaitOn.value().semaphore;
+        for (const auto *syncInfo : batchSyncInfos)
+        {
+            if (syncInfo->workSignalWhenDone.semaphore == waitSemaphore)
+                return true;
+        }
+
+        return false;
+    }
+
     void processRequest(job::TransferManagerThread::InterThreadRequest &request, vk::Device device,
                         VmaAllocator allocator)
     {
@@ -214,7 +394,8 @@ template <size_t TQueueSize> class BusyWaitTransferTaskHandlingPolicy
             job::TransferManagerThread::CreateBuffer(
                 device, allocator, m_queue, m_device.getPhysicalDevice().getProperties(),
                 m_allTransferQueueFamilyIndicesInUse, *workingInfo, request.bufferTransferRequest.get(),
-                request.resultingBuffer.value(), request.gpuDoneNotificationToMain, request.workSyncInfo);
+                request.resultingBuffer.value(), request.gpuDoneNotificationToMain, request.workSyncInfo,
+                m_stagingRing.get());
         }
         else if (request.textureTransferRequest)
         {
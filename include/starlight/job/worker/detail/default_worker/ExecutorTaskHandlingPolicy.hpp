@@ -0,0 +1,72 @@
+#pragma once
+
+#include "TaskContainer.hpp"
+#include "WorkStealingExecutor.hpp"
+#include "complete_tasks/CompleteTask.hpp"
+#include "logging/LoggingFactory.hpp"
+
+#include <optional>
+#include <string>
+
+namespace star::job::worker::default_worker
+{
+/// Does not own a thread. Tasks are forwarded to the shared work stealing executor of the task manager, using one
+/// home thread per registered worker so tasks of the same type tend to stay on the same core.
+template <typename TTask> class ExecutorTaskHandlingPolicy
+{
+  public:
+    explicit ExecutorTaskHandlingPolicy(WorkStealingExecutor &executor,
+                                        WorkStealingExecutor::Priority priority = WorkStealingExecutor::Priority::Normal)
+        : m_executor(&executor), m_priority(priority)
+    {
+    }
+    ExecutorTaskHandlingPolicy(const ExecutorTaskHandlingPolicy &) = delete;
+    ExecutorTaskHandlingPolicy &operator=(const ExecutorTaskHandlingPolicy &) = delete;
+    ExecutorTaskHandlingPolicy(ExecutorTaskHandlingPolicy &&) = default;
+    ExecutorTaskHandlingPolicy &operator=(ExecutorTaskHandlingPolicy &&) = default;
+    ~ExecutorTaskHandlingPolicy() = default;
+
+    void init(std::string workerName, TaskContainer<complete_tasks::CompleteTask> *completeMessages)
+    {
+        m_workerName = std::move(workerName);
+        m_completeMessages = completeMessages;
+        m_affinity = m_executor->reserveAffinity();
+    }
+
+    void queueTask(void *task)
+    {
+        assert(m_completeMessages != nullptr && "Policy must be initialized before tasks are queued");
+
+        TTask *typedTask = static_cast<TTask *>(task);
+        m_executor->submit(WorkStealingExecutor::Job{[task = std::move(*typedTask),
+                                                      completeMessages = m_completeMessages]() mutable {
+                               task.run();
+
+                               auto message = task.getCompleteMessage();
+                               if (message.has_value())
+                               {
+                                   completeMessages->queueTask(std::move(message.value()));
+                               }
+                           }},
+                           m_priority, m_affinity);
+    }
+
+    bool isTaskQueueFull(const void *task) const noexcept
+    {
+        // executor deques are unbounded
+        return false;
+    }
+
+    void cleanup()
+    {
+        // the executor is owned by the task manager and drained when it is cleaned up
+    }
+
+  private:
+    WorkStealingExecutor *m_executor = nullptr;
+    WorkStealingExecutor::Priority m_priority = WorkStealingExecutor::Priority::Normal;
+    std::optional<size_t> m_affinity = std::nullopt;
+    TaskContainer<complete_tasks::CompleteTask> *m_completeMessages = nullptr;
+    std::string m_workerName;
+};
+} // namespace star::job::worker::default_worker
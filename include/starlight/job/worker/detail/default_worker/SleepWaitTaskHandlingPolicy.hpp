@@ -5,11 +5,10 @@
 
 namespace star::job::worker::default_worker
 {
-template <typename TTask, size_t TQueueSize>
-class SleepWaitTaskHandlingPolicy : public BusyWaitTaskHandlingPolicy<TTask, TQueueSize>
+template <typename TTask> class SleepWaitTaskHandlingPolicy : public BusyWaitTaskHandlingPolicy<TTask>
 {
   private:
-    using Parent = BusyWaitTaskHandlingPolicy<TTask, TQueueSize>;
+    using Parent = BusyWaitTaskHandlingPolicy<TTask>;
 
   public:
     SleepWaitTaskHandlingPolicy()
@@ -17,8 +16,9 @@ class SleepWaitTaskHandlingPolicy : public BusyWaitTaskHandlingPolicy<TTask, TQu
           m_hasTask(std::make_unique<boost::condition_variable>())
     {
     }
-    explicit SleepWaitTaskHandlingPolicy(bool waitForWorkToFinishBeforeExiting)
-        : Parent(waitForWorkToFinishBeforeExiting), m_taskMutex(std::make_unique<boost::mutex>()),
+    explicit SleepWaitTaskHandlingPolicy(bool waitForWorkToFinishBeforeExiting,
+                                         size_t queueSize = TaskContainer<TTask>::DefaultCapacity)
+        : Parent(waitForWorkToFinishBeforeExiting, queueSize), m_taskMutex(std::make_unique<boost::mutex>()),
           m_hasTask(std::make_unique<boost::condition_variable>())
     {
     }
@@ -4,17 +4,18 @@
 
 namespace star::job::worker::default_worker
 {
-template <typename TTask, size_t TQueueSize> class SpinWaitTaskHandlingPolicy : public BusyWaitTaskHandlingPolicy<TTask, TQueueSize>
+template <typename TTask> class SpinWaitTaskHandlingPolicy : public BusyWaitTaskHandlingPolicy<TTask>
 {
   private:
-    using Parent = BusyWaitTaskHandlingPolicy<TTask, TQueueSize>;
+    using Parent = BusyWaitTaskHandlingPolicy<TTask>;
 
   public:
     SpinWaitTaskHandlingPolicy() : Parent()
     {
     }
-    explicit SpinWaitTaskHandlingPolicy(bool waitForWorkToFinishBeforeExiting)
-        : Parent(waitForWorkToFinishBeforeExiting)
+    explicit SpinWaitTaskHandlingPolicy(bool waitForWorkToFinishBeforeExiting,
+                                        size_t queueSize = TaskContainer<TTask>::DefaultCapacity)
+        : Parent(waitForWorkToFinishBeforeExiting, queueSize)
     {
     }
     SpinWaitTaskHandlingPolicy(const SpinWaitTaskHandlingPolicy &&) = delete;
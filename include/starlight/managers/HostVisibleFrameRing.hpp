@@ -0,0 +1,76 @@
+#pragma once
+
+#include "StarBuffers/Buffer.hpp"
+#include "TransferRequest_Buffer.hpp"
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace star
+{
+/// Persistently mapped, host visible memory split into one region per frame in flight. Small buffers which change
+/// every frame are placed here so the CPU can write them directly, instead of going through the transfer queue.
+/// Allocations keep the same region until they are released, so descriptors written against them never change.
+class HostVisibleFrameRing
+{
+  public:
+    static constexpr vk::DeviceSize DefaultBytesPerFrame = 4 * 1024 * 1024;
+    /// Anything larger is better served by device local memory and the staging path
+    static constexpr vk::DeviceSize MaxAllocationSize = 256 * 1024;
+
+    HostVisibleFrameRing(VmaAllocator &allocator, const uint8_t &numFramesInFlight,
+                         const vk::DeviceSize &minOffsetAlignment, std::vector<uint32_t> queueFamilyIndices,
+                         const vk::DeviceSize &bytesPerFrame = DefaultBytesPerFrame);
+    HostVisibleFrameRing(const HostVisibleFrameRing &) = delete;
+    HostVisibleFrameRing &operator=(const HostVisibleFrameRing &) = delete;
+    ~HostVisibleFrameRing() = default;
+
+    /// Suballocate space for the layout within the region of a frame in flight
+    /// @return view into the ring, or nullptr if the layout is too large or the region is full
+    std::unique_ptr<StarBuffers::Buffer> allocate(const uint8_t &frameInFlightIndex,
+                                                  const TransferRequest::StagingLayout &layout);
+
+    /// Return the range of a view created by allocate. It is only handed out again once reclaim is called for its
+    /// frame in flight, as the GPU may still be reading it until then.
+    void release(const StarBuffers::Buffer &view);
+
+    /// Make ranges released for the frame in flight available again. Call once the GPU has finished the previous
+    /// submission of that frame in flight.
+    void reclaim(const uint8_t &frameInFlightIndex);
+
+    /// True if the buffer is a view into this ring
+    bool owns(const StarBuffers::Buffer &buffer) const;
+
+    void cleanupRender(vk::Device &device);
+
+    uint8_t getNumFramesInFlight() const
+    {
+        return static_cast<uint8_t>(m_frames.size());
+    }
+
+  private:
+    struct Range
+    {
+        vk::DeviceSize offset = 0;
+        vk::DeviceSize size = 0;
+    };
+
+    /// Ranges are relative to the start of the region of their frame in flight
+    struct FrameRegion
+    {
+        vk::DeviceSize head = 0;
+        std::vector<Range> free;
+        std::vector<Range> released;
+    };
+
+    vk::DeviceSize m_minOffsetAlignment = 1;
+    vk::DeviceSize m_bytesPerFrame = 0;
+    std::vector<FrameRegion> m_frames;
+    std::unique_ptr<StarBuffers::Buffer> m_buffer = nullptr;
+
+    static vk::DeviceSize AlignUp(const vk::DeviceSize &value, const vk::DeviceSize &alignment);
+};
+} // namespace star
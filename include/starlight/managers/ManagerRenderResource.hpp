@@ -9,6 +9,7 @@
 #include "device/StarDevice.hpp"
 #include "job/TaskManager.hpp"
 #include "job/tasks/TransferTask.hpp"
+#include "managers/HostVisibleFrameRing.hpp"
 #include "starlight/core/CommandBus.hpp"
 #include "starlight/wrappers/graphics/StarSemaphore.hpp"
 
@@ -72,7 +73,8 @@ class ManagerRenderResource
         }
     };
 
-    static void init(const Handle &deviceID, core::device::StarDevice *device, star::core::CommandBus &cmdBus);
+    static void init(const Handle &deviceID, core::device::StarDevice *device, star::core::CommandBus &cmdBus,
+                     const uint8_t &numFramesInFlight);
 
     static Handle addRequest(const Handle &deviceID);
 
@@ -84,7 +86,8 @@ class ManagerRenderResource
                              vk::Semaphore *consumingQueueCompleteSemaphore = nullptr,
                              const bool &isHighPriority = false, uint32_t *outTransferQueueFamilyIndex = nullptr);
 
-    /// @brief Submit request to write new data to a buffer already created and associated to a handle
+    /// @brief Submit request to write new data to a buffer already created and associated to a handle. A buffer
+    /// placed in the host visible frame ring is moved to device local memory and its range returned to the ring.
     /// @param newRequest New data request
     /// @param waitInfo GPU synchronization info which transfer worker will wait on before submitting its commands to
     /// the gpu
@@ -94,6 +97,19 @@ class ManagerRenderResource
                               std::optional<core::graphics::SemaphoreInfo> waitInfo = std::nullopt,
                               const bool &isHighPriority = false, uint32_t *outTransferQueueFamilyIndex = nullptr);
 
+    /// @brief Place the data of a request in the host visible memory of a frame in flight and write it directly from
+    /// the CPU. The resulting buffer is ready immediately, consumers need no semaphore wait or transfer barrier.
+    /// @return Handle to the resource, or std::nullopt if the request is too large or the frame ring is full
+    static std::optional<Handle> addHostWrittenRequest(const Handle &deviceID, const uint8_t &frameInFlightIndex,
+                                                       const TransferRequest::Buffer &newRequest);
+
+    /// @brief Write new data into a resource created by addHostWrittenRequest. The caller must ensure the GPU is no
+    /// longer reading the previous contents of the frame in flight.
+    /// @return false if the new data no longer fits in the original allocation. Use updateRequest instead.
+    static bool writeFromHost(const Handle &deviceID, const TransferRequest::Buffer &newRequest, const Handle &handle);
+
+    /// Waits on outstanding high priority requests and lets the frame ring reuse ranges released for this frame in
+    /// flight. Call once the previous submission of the frame in flight has completed.
     static void frameUpdate(const Handle &deviceID, const uint8_t &frameInFlightIndex);
 
     static bool isReady(const Handle &deviceID, const Handle &handle);
@@ -139,6 +155,7 @@ class ManagerRenderResource
 
     static std::unordered_map<Handle, std::set<boost::atomic<bool> *>, star::HandleHash>
         highPriorityRequestCompleteFlags;
+    static std::unordered_map<Handle, std::unique_ptr<HostVisibleFrameRing>, star::HandleHash> frameRings;
 
     static star::core::CommandBus *s_cmdBus;
 };
@@ -1,10 +1,10 @@
 #pragma once
 
 #include "starlight/ShaderResolver.hpp"
+#include "starlight/object/ObjFileCache.hpp"
 #include "starlight/object/StarObject.hpp"
 
-#include <tiny_obj_loader.h>
-
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,16 +19,24 @@ namespace star
 class BasicObject : public StarObject
 {
   public:
-    BasicObject(std::string objFilePath, ShaderResolver &shaderResolver);
-    BasicObject(std::string objFilePath, const std::filesystem::path &materialDir, ShaderResolver &shaderResolver);
+    BasicObject(std::string objFilePath, ShaderResolver &shaderResolver, object::ObjLoadOptions loadOptions = {});
+    BasicObject(std::string objFilePath, const std::filesystem::path &materialDir, ShaderResolver &shaderResolver,
+                object::ObjLoadOptions loadOptions = {});
     virtual ~BasicObject() = default;
 
     static ShaderResolver PrepareResolver(const std::string &objFilePath, core::CommandBus &bus);
     static ShaderResolver PrepareResolver(const std::string &objFilePath, const std::filesystem::path &materialDir,
                                            core::CommandBus &bus);
 
+    Vertex_Layout getVertexLayout() const override
+    {
+        return m_loadOptions.vertexLayout;
+    }
+
   protected:
     std::string m_objFilePath = "";
+    std::filesystem::path m_materialSearchDir;
+    object::ObjLoadOptions m_loadOptions;
 
     Handle primaryVertBuffer, primaryIndbuffer;
 
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Enums.hpp"
+#include "Vertex.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <tiny_obj_loader.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace star::job
+{
+class WorkStealingExecutor;
+}
+
+namespace star::object
+{
+/// Processing applied when generating the vertex and index arrays of an obj file
+struct ObjLoadOptions
+{
+    /// Merge corners of faces which share all vertex attributes
+    bool deduplicateVertices = true;
+    /// Reorder triangles and vertices for the post transform vertex cache. Requires deduplicateVertices to be useful.
+    bool optimizeVertexCache = false;
+    /// Store indices as 16 bit values when a mesh has few enough vertices
+    bool allowCompactIndices = true;
+    /// Store indices as a triangle list with adjacency. Meshes must then be drawn with a pipeline using
+    /// vk::PrimitiveTopology::eTriangleListWithAdjacency.
+    bool packAdjacency = false;
+    /// Format the vertices are uploaded in. Packing happens at upload so this is not part of the cache key.
+    Vertex_Layout vertexLayout = Vertex_Layout::full;
+
+    uint8_t getKey() const noexcept
+    {
+        return (deduplicateVertices ? 1 : 0) | (optimizeVertexCache ? 2 : 0) | (allowCompactIndices ? 4 : 0) |
+               (packAdjacency ? 8 : 0);
+    }
+};
+
+/// Raw tinyobj output for a single obj file
+struct ParsedObjFile
+{
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+};
+
+/// Vertex and index arrays generated from the shapes of a ParsedObjFile, shared between all objects using the file
+struct CookedObjShape
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    /// Indices fit in 16 bits and should be uploaded as such
+    bool compactIndices = false;
+};
+
+struct CookedObjFile
+{
+    std::vector<CookedObjShape> shapes;
+};
+
+/// Process wide cache of parsed obj files. Entries are keyed on the file path and the material search directory and are
+/// reloaded when the modification time of the obj file changes.
+///
+/// The lock only guards the lookup. The first request for a parse or cook stores a future and does the work without
+/// the lock, so lookups of other files are not held up and concurrent requests for the same result wait on the future.
+/// A failed parse or cook is kept like a result and rethrown to every request until the file changes.
+class ObjFileCache
+{
+  public:
+    static std::shared_ptr<const ParsedObjFile> GetParsed(const std::filesystem::path &objFilePath,
+                                                          const std::filesystem::path &materialSearchDir);
+
+    /// @param executor Shapes are cooked on it in parallel with the calling thread when provided
+    static std::shared_ptr<const CookedObjFile> GetCooked(const std::filesystem::path &objFilePath,
+                                                          const std::filesystem::path &materialSearchDir,
+                                                          const ObjLoadOptions &options,
+                                                          job::WorkStealingExecutor *executor = nullptr);
+
+    static void Clear();
+
+  private:
+    using ParsedFuture = std::shared_future<std::shared_ptr<const ParsedObjFile>>;
+    using CookedFuture = std::shared_future<std::shared_ptr<const CookedObjFile>>;
+
+    struct Entry
+    {
+        std::filesystem::file_time_type lastWriteTime;
+        ParsedFuture parsed;
+        std::array<CookedFuture, 16> cooked{};
+    };
+
+    struct ShapeBatch;
+
+    static std::mutex m_lock;
+    static absl::flat_hash_map<std::string, Entry> m_entries;
+
+    /// Expects m_lock to be held
+    static Entry &getEntry(const std::filesystem::path &objFilePath, const std::filesystem::path &materialSearchDir);
+
+    static ParsedFuture getParsedFuture(const std::filesystem::path &objFilePath,
+                                        const std::filesystem::path &materialSearchDir);
+
+    static std::shared_ptr<const ParsedObjFile> Parse(const std::filesystem::path &objFilePath,
+                                                      const std::filesystem::path &materialSearchDir);
+
+    static std::shared_ptr<const CookedObjFile> Cook(const std::filesystem::path &objFilePath,
+                                                     std::shared_ptr<const ParsedObjFile> parsed,
+                                                     const ObjLoadOptions &options,
+                                                     job::WorkStealingExecutor *executor);
+
+    static void CookRemainingShapes(ShapeBatch &batch);
+
+    static CookedObjShape CookShape(const tinyobj::attrib_t &attrib, const tinyobj::shape_t &shape,
+                                    const ObjLoadOptions &options);
+};
+} // namespace star::object
@@ -9,12 +9,17 @@
 #include "StarShaderInfo.hpp"
 #include "core/device/DeviceContext.hpp"
 #include "core/renderer/RenderingContext.hpp"
+#include "starlight/service/detail/command_order/ResourceUse.hpp"
+#include "systems/DrawList.hpp"
+#include "systems/Frustum.hpp"
+#include "systems/GpuCullingPass.hpp"
 
 #include "ManagerController_RenderResource_InstanceModelInfo.hpp"
 #include "ManagerController_RenderResource_InstanceNormalInfo.hpp"
 
 #include <vulkan/vulkan.hpp>
 
+#include <array>
 #include <memory>
 #include <optional>
 #include <string>
@@ -68,21 +73,25 @@ class StarObject
     virtual core::renderer::RenderingContext buildRenderingContext(star::core::device::DeviceContext &context);
 
     /// Function to contain any commands to be submitted before the start of the rendering pass this object is contained
-    /// in begins
+    /// in begins. Overrides must also extend hashRecordState with whatever they record.
     virtual void recordPreRenderPassCommands(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
                                              const uint64_t &frameIndex);
 
-    /// Function to contain any commands to be submitted after the end of the rendering pass this object is contained in
+    /// Function to contain any commands to be submitted after the end of the rendering pass this object is contained
+    /// in. Overrides must also extend hashRecordState with whatever they record.
     virtual void recordPostRenderPassCommands(vk::CommandBuffer &commandBuffer, const int &frameInFlightIndex) {};
 
-    /// <summary>
-    /// Create render call
-    /// </summary>
-    /// <param name="commandBuffer"></param>
-    /// <param name="pipelineLayout"></param>
-    /// <param name="swapChainIndexNum"></param>
-    void recordRenderPassCommands(vk::CommandBuffer &commandBuffer, vk::PipelineLayout &pipelineLayout,
-                                  const uint8_t &swapChainIndexNum, const uint64_t &frameIndex);
+    /// Add everything recordPreRenderPassCommands and recordPostRenderPassCommands would record for the frame, a
+    /// recorded command buffer is submitted again while this state does not change. Draws are covered by the draw list.
+    virtual void hashRecordState(core::renderer::RecordState &state, const uint8_t &frameInFlightIndex,
+                                 const uint64_t &frameIndex);
+
+    /// Add a draw for every mesh of this object, to be sorted and recorded together with the rest of the frame. When
+    /// normals or the bounding box are enabled the object is also added to the debug draws of the list.
+    void collectDraws(DrawList &drawList, const vk::PipelineLayout &pipelineLayout, const uint8_t &frameInFlightIndex);
+
+    /// Record the enabled debug geometry of this object, after every mesh draw of the frame
+    void recordDebugCommands(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex);
 
     /// @brief Create an instance of this object.
     /// @return A reference to the created instance. The object will own the instance.
@@ -95,6 +104,27 @@ class StarObject
                              const Handle &targetCommandBuffer,
                              const star::core::graphics::SemaphoreInfo &transferReuqestSyncInfo);
 
+    /// Test the bounds of every instance against the frustum. Only the instances which pass are written to the
+    /// instance buffers and drawn. Must be called before the frame update it should apply to.
+    CullingStats cullInstances(const Frustum &frustum);
+
+    /// Move culling of this object's instances to a compute pass and draw each mesh indirectly from its results.
+    /// Every instance stays uploaded, so only changed instances are written. Draws are not batched across meshes or
+    /// objects, each mesh still records its own indirect draw. Must be called before the object is added to a
+    /// renderer.
+    /// @param maxInstances Instances the culling buffers start with, when 0 the instance count at prep time is used.
+    /// The buffers grow with the instance count.
+    void enableGpuCulling(const uint32_t &maxInstances = 0);
+
+    bool isGpuCulled() const
+    {
+        return m_gpuCulling != nullptr;
+    }
+
+    /// Buffers this object reads or writes while recording into the pass of its renderer on every frame in flight, to
+    /// be declared to the command order graph. Only valid after prepRender.
+    std::vector<service::command_order::ResourceUse> getResourceUses(const uint8_t &numFramesInFlight) const;
+
     /// @brief Create descriptor set layouts for this object.
     /// @param device
     /// @return
@@ -114,6 +144,11 @@ class StarObject
     {
         return m_fragmentShaderHandle;
     }
+    /// Layout of the vertex buffers of this object's meshes. Objects with different layouts can not share a pipeline.
+    virtual Vertex_Layout getVertexLayout() const
+    {
+        return Vertex_Layout::full;
+    }
 #pragma endregion
 
   protected:
@@ -121,7 +156,8 @@ class StarObject
     {
       public:
         InstanceInfo()
-            : m_instances(), m_infoManagerInstanceModel(&m_instances), m_infoManagerInstanceNormal(&m_instances)
+            : m_instances(), m_visibleInstances(), m_infoManagerInstanceModel(&m_instances, &m_visibleInstances),
+              m_infoManagerInstanceNormal(&m_instances, &m_visibleInstances)
         {
         }
 
@@ -138,6 +174,7 @@ class StarObject
 
         StarEntity &create()
         {
+            m_visibleInstances.push_back(static_cast<uint32_t>(m_instances.size()));
             m_instances.emplace_back();
             return m_instances.back();
         }
@@ -145,7 +182,7 @@ class StarObject
         StarEntity &getInstance(const size_t &index)
         {
             assert(index < m_instances.size());
-            setManagersToUpdate();
+            setManagersToUpdate(index);
 
             return m_instances[index];
         }
@@ -154,24 +191,46 @@ class StarObject
             assert(index < m_instances.size());
             return m_instances[index];
         }
+        const std::vector<StarEntity> &getInstances() const
+        {
+            return m_instances;
+        }
+        /// Instances written to the instance buffers, in draw order
+        std::vector<uint32_t> &getVisibleInstances()
+        {
+            return m_visibleInstances;
+        }
+        size_t getNumVisible() const
+        {
+            return m_visibleInstances.size();
+        }
         ManagerController::RenderResource::InstanceModelInfo &getControllerModel()
         {
             return m_infoManagerInstanceModel;
         }
+        const ManagerController::RenderResource::InstanceModelInfo &getControllerModel() const
+        {
+            return m_infoManagerInstanceModel;
+        }
         ManagerController::RenderResource::InstanceNormalInfo &getControllerNormal()
         {
             return m_infoManagerInstanceNormal;
         }
+        const ManagerController::RenderResource::InstanceNormalInfo &getControllerNormal() const
+        {
+            return m_infoManagerInstanceNormal;
+        }
 
       private:
         std::vector<StarEntity> m_instances;
+        std::vector<uint32_t> m_visibleInstances;
         ManagerController::RenderResource::InstanceModelInfo m_infoManagerInstanceModel;
         ManagerController::RenderResource::InstanceNormalInfo m_infoManagerInstanceNormal;
 
-        void setManagersToUpdate()
+        void setManagersToUpdate(const size_t &index)
         {
-            m_infoManagerInstanceModel.setToUpdate();
-            m_infoManagerInstanceNormal.setForUpdate();
+            m_infoManagerInstanceModel.setToUpdate(index);
+            m_infoManagerInstanceNormal.setForUpdate(index);
         }
     };
     /// pipeline + rendering infos
@@ -215,6 +274,12 @@ class StarObject
     std::vector<std::vector<vk::DescriptorSet>> boundingDescriptors;
     Handle vertBuffer, indBuffer;
     uint32_t boundingBoxIndsCount = 0;
+    glm::vec3 m_localBoundsCenter{0.0f}, m_localBoundsExtent{0.0f};
+    Frustum::BoxBatch m_cullBoxes;
+    std::vector<uint8_t> m_cullResults;
+    std::unique_ptr<GpuCullingPass> m_gpuCulling;
+    /// Distance from the near plane to the closest visible instance, from the last cull
+    float m_sortDepth = 0.0f;
 
     void prepStarObject(core::device::DeviceContext &context);
 
@@ -226,6 +291,9 @@ class StarObject
 
     void calculateBoundingBox(std::vector<Vertex> &verts, std::vector<uint32_t> &inds);
 
+    /// Lower and upper corners of the box enclosing every mesh, in object space
+    std::array<glm::vec3, 2> calculateLocalBounds() const;
+
     void prepareMeshes(star::core::device::DeviceContext &context);
 
     void updateInstanceData(core::device::DeviceContext &context, const uint8_t &frameInFlightIndex,
@@ -234,7 +302,7 @@ class StarObject
 
     bool isKnownToBeReadyForRecordRender(const uint8_t &frameInFlightIndex);
 
-    void recordDependentDataPipelineBarriers(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
-                                             const uint64_t &frameIndex);
+    /// Instances which can be drawn this frame, instances added since the last upload wait for the resized buffers
+    size_t getNumDrawableInstances(const uint8_t &frameInFlightIndex);
 };
 } // namespace star
\ No newline at end of file
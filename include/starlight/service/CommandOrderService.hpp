@@ -2,6 +2,7 @@
 
 #include "starlight/command/command_order/DeclareDependency.hpp"
 #include "starlight/command/command_order/DeclarePass.hpp"
+#include "starlight/command/command_order/DeclareResourceUse.hpp"
 #include "starlight/command/command_order/GetPassInfo.hpp"
 #include "starlight/command/command_order/TriggerPass.hpp"
 #include "starlight/core/WorkerPool.hpp"
@@ -11,6 +12,7 @@
 #include "starlight/policy/event/ListenFor.hpp"
 #include "starlight/service/InitParameters.hpp"
 #include "starlight/service/detail/command_order/EdgeDescription.hpp"
+#include "starlight/service/detail/command_order/ResourceUse.hpp"
 #include "starlight/service/detail/command_order/TriggerDescription.hpp"
 
 #include <star_common/Handle.hpp>
@@ -18,7 +20,9 @@
 
 #include <absl/container/flat_hash_map.h>
 
+#include <optional>
 #include <variant>
+#include <vector>
 
 namespace star::service
 {
@@ -45,6 +49,12 @@ using ListenForDeclarePass =
                                      star::command_order::declare_pass::GetDeclarePassCommandTypeName,
                                      &T::onDeclarePass>;
 
+template <typename T>
+using ListenForDeclareResourceUse =
+    star::policy::command::ListenFor<T, star::command_order::DeclareResourceUse,
+                                     star::command_order::declare_resource_use::GetDeclareResourceUseCommandTypeName,
+                                     &T::onDeclareResourceUse>;
+
 template <typename T>
 using ListenForTriggerPass =
     star::policy::command::ListenFor<T, star::command_order::TriggerPass,
@@ -57,6 +67,10 @@ using ListenForGetPassInfo =
                                      star::command_order::get_pass_info::GetPassInfoTypeName, &T::onGetPassInfo>;
 } // namespace command_order
 
+/// Render graph of the passes submitted each frame. Passes declare the images and buffers they use, and the graph is
+/// compiled once per change into an order checked against the submission slots of the command buffers, the barriers
+/// each pass records around its work, semaphores between passes on different queue families and the set of passes
+/// whose results are never used.
 class CommandOrderService
 {
   public:
@@ -65,6 +79,19 @@ class CommandOrderService
         uint32_t queueFamilyIndex;
 
         std::vector<bool> wasProcessedOnLastFrame;
+
+        /// Order the pass was declared in, breaks ties between passes without a dependency between them
+        uint32_t declarationIndex = 0;
+        std::vector<command_order::ResourceUse> uses = {};
+        std::optional<command_order::TriggerDescription> trigger = std::nullopt;
+
+        // compiled
+        uint32_t orderIndex = 0;
+        bool isCulled = false;
+        std::vector<command_order::ResourceTransition> acquireTransitions = {};
+        /// Acquire transitions without those from the last frame, used until every frame in flight has released them
+        std::vector<command_order::ResourceTransition> firstFramesAcquireTransitions = {};
+        std::vector<command_order::ResourceTransition> releaseTransitions = {};
     };
 
     CommandOrderService();
@@ -88,6 +115,8 @@ class CommandOrderService
 
     void onDeclarePass(star::command_order::DeclarePass &cmd);
 
+    void onDeclareResourceUse(star::command_order::DeclareResourceUse &cmd);
+
     void onStartOfNextFrame(const star::event::StartOfNextFrame &event, bool &keepAlive);
 
     void onTriggerPass(star::command_order::TriggerPass &cmd);
@@ -102,24 +131,31 @@ class CommandOrderService
     };
 
     absl::flat_hash_map<Handle, PassDescription, star::HandleHash> m_passes;
+    /// Declared dependencies along with those derived between queue families, rebuilt by each compile
     absl::flat_hash_map<Handle, std::vector<command_order::EdgeDescription>, star::HandleHash> m_edges;
+    std::vector<command_order::EdgeDescription> m_declaredEdges;
+    std::vector<Handle> m_order;
     // commands
     command_order::ListenForDeclareDependency<CommandOrderService> m_listenForDeclareDependency;
     command_order::ListenForDeclarePass<CommandOrderService> m_listenForDeclarePass;
+    command_order::ListenForDeclareResourceUse<CommandOrderService> m_listenForDeclareResourceUse;
     command_order::ListenForTriggerPass<CommandOrderService> m_listenForTriggerPass;
     command_order::ListenForGetPassInfo<CommandOrderService> m_listenForGetPassInfo;
     // events
     command_order::ListenForInitComplete<CommandOrderService> m_listenForInitPhaseComplete;
     command_order::ListenForStartOfNextFrame<CommandOrderService> m_listenForStartOfNextFrame;
     Phase m_currentPhase = Phase::Record;
-    std::vector<command_order::TriggerDescription> m_triggeredPasses;
-    std::vector<Handle> m_notTriggeredPasses;
+    /// A pass, dependency or resource use was declared since the last compile
+    bool m_isDirty = false;
+    /// First frame recorded from the current graph
+    uint64_t m_compiledOnFrame = 0;
 
     uint8_t m_lastFrameInFlightIndex = 0;
     star::core::CommandBus *m_cmdBus = nullptr;
     common::EventBus *m_evtBus = nullptr;
     const star::common::FrameTracker *m_ft = nullptr;
     star::core::device::manager::Semaphore *m_sem{nullptr};
+    star::core::device::manager::ManagerCommandBuffer *m_cmdBufferManager{nullptr};
 
     void initListeners(core::CommandBus &cmdBus);
 
@@ -131,7 +167,19 @@ class CommandOrderService
 
     void compileOrder();
 
-    void removeElementFromNotTriggeredPasses(const Handle &handle);
+    /// Topologically sort the passes, producers of a resource come before its readers. Throws when the result does
+    /// not match the order the command buffers of the passes are submitted in.
+    void sortPasses(const absl::flat_hash_map<Handle, std::vector<Handle>, star::HandleHash> &producers);
+
+    /// Order group and index the command buffer of the pass is submitted in, passes which are not command buffers
+    /// have no slot
+    std::optional<uint32_t> getSubmissionSlot(const Handle &pass) const;
+
+    /// Mark every pass which does not contribute to an external output
+    void cullPasses(const absl::flat_hash_map<Handle, std::vector<Handle>, star::HandleHash> &producers);
+
+    /// Derive the barriers between consecutive uses of each resource in the compiled order
+    void deriveTransitions();
 
     void addEdgeRecord(const Handle &producer, const Handle &consumer);
 };
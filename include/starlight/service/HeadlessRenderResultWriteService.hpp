@@ -3,6 +3,7 @@
 #include "starlight/command/headless_render_result_write/GetFileNameForFrame.hpp"
 #include "starlight/command/headless_render_result_write/GetSetOutputDir.hpp"
 #include "starlight/core/renderer/RendererBase.hpp"
+#include "starlight/policy/ListenForEnginePhaseCompletePolicy.hpp"
 #include "starlight/policy/ListenForRegisterMainGraphicsRendererPolicy.hpp"
 #include "starlight/policy/ListenForRenderReadyForFinalization.hpp"
 #include "starlight/policy/ListenForStartOfNextFramePolicy.hpp"
@@ -57,6 +58,8 @@ class HeadlessRenderResultWriteService
 
     void onRenderReadyForFinalization(const event::RenderReadyForFinalization &event, bool &keepAlive);
 
+    void onEnginePhaseComplete(const event::EnginePhaseComplete &event, bool &keepAlive);
+
     void onGetFileNameForFrame(headless_render_result_write::GetFileNameForFrame &event) const;
 
     void onGetSetOutputDir(headless_render_result_write::GetSetOutputDir &cmd) noexcept;
@@ -68,6 +71,7 @@ class HeadlessRenderResultWriteService
     std::vector<Handle> m_screenshotRegistrations;
     star::policy::ListenForRenderReadyForFinalization<HeadlessRenderResultWriteService> m_renderReady;
     star::policy::ListenForStartOfNextFramePolicy<HeadlessRenderResultWriteService> m_triggerCapturePolicy;
+    star::policy::ListenForEnginePhaseCompletePolicy<HeadlessRenderResultWriteService> m_listenForLoadComplete;
     ListenForGetFileNameForFrame<HeadlessRenderResultWriteService> m_listenForGetFileNamePolicy;
     ListenForGetSetOutputDir<HeadlessRenderResultWriteService> m_listenForSetOutput;
 
@@ -86,6 +90,9 @@ class HeadlessRenderResultWriteService
 
     void cleanupListeners(core::CommandBus &commandBus);
 
+    /// Declare the read of every color target by the capture copy, so the graph moves the targets to transfer src
+    void declareCaptureResourceUses() const;
+
     std::string getFileName(const common::FrameTracker &ft) const;
 
     static std::filesystem::path GetDefaultImageDirectory();
@@ -65,7 +65,7 @@ class IOService
         {
             wHandle = tm.registerWorker(
                 {star::job::worker::DefaultWorker(
-                    job::worker::default_worker::SleepWaitTaskHandlingPolicy<job::tasks::io::IOTask, 64>{true},
+                    job::worker::default_worker::SleepWaitTaskHandlingPolicy<job::tasks::io::IOTask>{true},
                     workerName)},
                 job::tasks::io::IOTaskName);
         }
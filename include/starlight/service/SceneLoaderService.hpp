@@ -5,6 +5,8 @@
 #include "starlight/policy/command/ListenForCreateObject.hpp"
 #include "starlight/policy/command/ListenForSaveSceneState.hpp"
 #include "starlight/service/InitParameters.hpp"
+#include "starlight/service/detail/scene_loader/SceneDocumentCache.hpp"
+#include "starlight/service/detail/scene_loader/SceneStateWriter.hpp"
 #include "starlight/service/detail/scene_loader/SceneObjectTracker.hpp"
 
 namespace star::service
@@ -12,7 +14,9 @@ namespace star::service
 class SceneLoaderService
 {
   public:
-    explicit SceneLoaderService(std::string sceneFilePath);
+    /// @param onlySaveDirtyEntities When set, objects whose transforms have not changed since the previous save are not
+    /// serialized again
+    explicit SceneLoaderService(std::string sceneFilePath, bool onlySaveDirtyEntities = true);
     SceneLoaderService(const SceneLoaderService &) = delete;
     SceneLoaderService &operator=(const SceneLoaderService &) = delete;
     SceneLoaderService(SceneLoaderService &&other) noexcept;
@@ -38,8 +42,12 @@ class SceneLoaderService
 
   private:
     std::string m_sceneFilePath;
+    scene_loader::SceneDocumentCache m_sceneCache;
     absl::flat_hash_map<std::string, std::shared_ptr<StarObject>> m_objectTracker;
     absl::flat_hash_map<std::string, std::shared_ptr<std::vector<star::Light>>> m_lightTracker;
+    absl::flat_hash_map<std::string, scene_loader::ObjectState> m_lastSavedObjectStates;
+    std::shared_ptr<scene_loader::SceneStateWriter> m_sceneWriter = nullptr;
+    bool m_onlySaveDirtyEntities = true;
     policy::ListenForCreateObject<SceneLoaderService> m_onCreate;
     policy::ListenForSaveSceneState<SceneLoaderService> m_onSceneSave;
     policy::command::ListenForCreateLight<SceneLoaderService> m_onCreateLight;
@@ -48,5 +56,10 @@ class SceneLoaderService
     void initListeners(core::CommandBus &commandBus) noexcept;
 
     void cleanupListeners(core::CommandBus &commandBus) noexcept;
+
+    /// Take the object states of commits which succeeded on the IO worker as the last saved states
+    void applyCommittedObjectStates();
+
+    std::unique_ptr<scene_loader::SceneStateSnapshot> createSnapshot();
 };
 } // namespace star::service
\ No newline at end of file
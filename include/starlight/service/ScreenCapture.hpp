@@ -16,6 +16,7 @@
 #include "starlight/core/waiter/sync_renderer/Factory.hpp"
 #include "starlight/job/worker/DefaultWorker.hpp"
 #include "starlight/job/worker/detail/default_worker/BusyWaitTaskHandlingPolicy.hpp"
+#include "starlight/job/worker/detail/default_worker/ExecutorTaskHandlingPolicy.hpp"
 #include "wrappers/graphics/StarBuffers/Buffer.hpp"
 #include "wrappers/graphics/StarTextures/Texture.hpp"
 
@@ -124,9 +125,10 @@ class ScreenCapture
             STAR_THROW("No workers configured for image capture service");
         }
 
+        // image writers run on the shared executor when one is available and no longer need their own threads
         for (size_t i{0}; i < goal; i++)
         {
-            if (pool.allocateWorker())
+            if (tm.hasExecutor() || pool.allocateWorker())
             {
                 numToCreate++;
             }
@@ -208,11 +210,21 @@ class ScreenCapture
             std::ostringstream oss;
             oss << "Image Writer_" << std::to_string(i);
 
-            auto worker = tm.registerWorker(
-                {job::worker::DefaultWorker{job::worker::default_worker::BusyWaitTaskHandlingPolicy<
-                                                job::tasks::write_image_to_disk::WriteImageTask, 500>{true},
-                                            oss.str()}},
-                job::tasks::write_image_to_disk::WriteImageTypeName);
+            using WriteImageTask = job::tasks::write_image_to_disk::WriteImageTask;
+
+            auto worker =
+                tm.hasExecutor()
+                    ? tm.registerWorker(
+                          {job::worker::DefaultWorker{
+                              job::worker::default_worker::ExecutorTaskHandlingPolicy<WriteImageTask>{
+                                  tm.getExecutor(), job::WorkStealingExecutor::Priority::Background},
+                              oss.str()}},
+                          job::tasks::write_image_to_disk::WriteImageTypeName)
+                    : tm.registerWorker(
+                          {job::worker::DefaultWorker{
+                              job::worker::default_worker::BusyWaitTaskHandlingPolicy<WriteImageTask>{true, 500},
+                              oss.str()}},
+                          job::tasks::write_image_to_disk::WriteImageTypeName);
 
             auto *newWorker = tm.getWorker(worker);
             assert(newWorker != nullptr && "Worker was not properly created");
@@ -252,6 +264,7 @@ class ScreenCapture
         auto copyPlan = m_actionRouter.decide(m_calleeDependencyTracker.get(screenEvent.getCalleeRegistration()),
                                               screenEvent.getCalleeRegistration(),
                                               m_deviceInfo.flightTracker->getCurrent().getFinalTargetImageIndex());
+        copyPlan.targetTextureResource = screenEvent.getTargetTextureResource();
 
         // need way to wait for commands to be submitted BEFORE telling worker to start?
         detail::screen_capture::GPUSynchronizationInfo syncInfo = m_copyPolicy.triggerSubmission(copyPlan);
@@ -20,6 +20,7 @@
 
 #include <sstream>
 #include <array>
+#include <chrono>
 #include <vector>
 
 namespace star::service
@@ -74,7 +75,6 @@ class TransferService
 
     void selectQueueFamiliesToUse();
 
-    template <typename THighPriorityWorkerPolicy, typename TStandardPriorityWorkerPolicy>
     void createAndRegisterTransferWorkers()
     {
         core::logging::log(boost::log::trivial::info, "Initializing transfer workers");
@@ -119,6 +119,11 @@ class TransferService
         }
         m_workerQueueFamilyIndices = std::move(workerQueueFamilyIndices);
 
+        const job::worker::default_worker::TransferBatchLimits batchLimits{
+            .maxRequests = m_config.batchMaxRequests,
+            .maxBytes = m_config.getBatchMaxBytes(),
+            .latencyCap = std::chrono::microseconds(m_config.batchLatencyCapUs)};
+
         for (size_t i{0}; i < transferWorkerQueues.size(); i++)
         {
             const auto *queue = transferWorkerQueues[i];
@@ -148,14 +153,18 @@ class TransferService
             if (i == 0)
             {
                 job::worker::Worker transferWorker{job::worker::DefaultWorker{
-                    THighPriorityWorkerPolicy{true, *m_device, *queue, allTransferQueueFamilyIndicesInUse},
+                    job::worker::default_worker::BusyWaitTransferTaskHandlingPolicy{
+                        true, *m_device, *queue, allTransferQueueFamilyIndicesInUse, m_config.highPriorityQueueSize,
+                        m_config.getStagingRingSize(), batchLimits},
                     "TransferWorker"}};
                 m_taskManager->registerWorker(std::move(transferWorker), job::tasks::transfer::TransferTaskName);
             }
             else
             {
                 job::worker::Worker transferWorker{job::worker::DefaultWorker{
-                    TStandardPriorityWorkerPolicy{true, *m_device, *queue, allTransferQueueFamilyIndicesInUse},
+                    job::worker::default_worker::BusyWaitTransferTaskHandlingPolicy{
+                        true, *m_device, *queue, allTransferQueueFamilyIndicesInUse, m_config.standardPriorityQueueSize,
+                        m_config.getStagingRingSize(), batchLimits},
                     "TransferWorker"}};
                 m_taskManager->registerWorker(std::move(transferWorker), job::tasks::transfer::TransferTaskName);
             }
@@ -175,15 +184,6 @@ class TransferService
         m_nextStandardWorker = 0;
     }
 
-    template <size_t THighSize, size_t TStandardSize> void dispatchCreateWorkers()
-    {
-        createAndRegisterTransferWorkers<
-            job::worker::default_worker::BusyWaitTransferTaskHandlingPolicy<THighSize>,
-            job::worker::default_worker::BusyWaitTransferTaskHandlingPolicy<TStandardSize>>();
-    }
-
-    void dispatchCreateWorkersFromConfig();
-
     void cleanupListeners(star::core::CommandBus &cmdBus);
 
     void initListeners(star::core::CommandBus &cmdBus);
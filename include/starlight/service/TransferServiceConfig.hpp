@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -12,9 +13,18 @@ namespace star::service
 {
 struct TransferServiceConfig
 {
-    star::TransferQueueCapacity highPrioritySize{star::TransferQueueCapacity::Low};
-    star::TransferQueueCapacity standardPrioritySize{star::TransferQueueCapacity::Low};
+    // number of tasks each worker queue can hold before producers block
+    size_t highPriorityQueueSize{capacityToSize(star::TransferQueueCapacity::Low)};
+    size_t standardPriorityQueueSize{capacityToSize(star::TransferQueueCapacity::Low)};
     size_t standardPriorityWorkerCount{0};
+    // size of the staging ring owned by each transfer worker, 0 gives every request its own staging buffer
+    uint32_t stagingRingSizeMB{16};
+    // number of queued tasks a worker may record into one submission, 1 submits every task on its own
+    uint32_t batchMaxRequests{8};
+    // a batch is closed once this much data has been staged, 0 for no limit
+    uint32_t batchMaxKB{8192};
+    // how long the first task of a batch may be held back waiting for more work
+    uint32_t batchLatencyCapUs{50};
 
     static TransferServiceConfig fromConfigFile()
     {
@@ -25,14 +35,32 @@ struct TransferServiceConfig
         const auto standardStr =
             star::ConfigFile::getString(star::Config_Settings::transfer_standard_priority_queue_size, "low");
 
-        cfg.highPrioritySize = parseCapacity(highStr);
-        cfg.standardPrioritySize = parseCapacity(standardStr);
+        cfg.highPriorityQueueSize = parseQueueSize(highStr);
+        cfg.standardPriorityQueueSize = parseQueueSize(standardStr);
         cfg.standardPriorityWorkerCount =
             star::ConfigFile::getUint32(star::Config_Settings::transfer_standard_priority_worker_count, 0);
+        cfg.stagingRingSizeMB = star::ConfigFile::getUint32(star::Config_Settings::transfer_staging_ring_size_mb, 16);
+        cfg.batchMaxRequests =
+            std::max(1u, star::ConfigFile::getUint32(star::Config_Settings::transfer_batch_max_requests, 8));
+        cfg.batchMaxKB = star::ConfigFile::getUint32(star::Config_Settings::transfer_batch_max_kb, 8192);
+        cfg.batchLatencyCapUs = star::ConfigFile::getUint32(star::Config_Settings::transfer_batch_latency_cap_us, 50);
 
         return cfg;
     }
 
+    /// Queue sizes may be given either as one of the named capacities or as an explicit number of tasks
+    static size_t parseQueueSize(std::string_view value)
+    {
+        if (!value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c); }))
+        {
+            const size_t size = std::stoull(std::string{value});
+            if (size > 0)
+                return size;
+        }
+
+        return capacityToSize(parseCapacity(value));
+    }
+
     static star::TransferQueueCapacity parseCapacity(std::string_view value)
     {
         std::string lowered{value};
@@ -64,5 +92,15 @@ struct TransferServiceConfig
         }
         return 64;
     }
+
+    uint64_t getStagingRingSize() const noexcept
+    {
+        return static_cast<uint64_t>(stagingRingSizeMB) * 1024 * 1024;
+    }
+
+    uint64_t getBatchMaxBytes() const noexcept
+    {
+        return static_cast<uint64_t>(batchMaxKB) * 1024;
+    }
 };
 } // namespace star::service
\ No newline at end of file
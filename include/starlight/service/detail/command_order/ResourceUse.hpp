@@ -0,0 +1,108 @@
+#pragma once
+
+#include <star_common/Handle.hpp>
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <optional>
+
+namespace star::service::command_order
+{
+/// How a pass touches an image or buffer. The graph orders passes by these uses and derives the barriers between
+/// them, so they should describe every access the pass records.
+struct ResourceUse
+{
+    enum class Type
+    {
+        image,
+        buffer
+    };
+
+    Handle resource;
+    Type type = Type::image;
+    vk::PipelineStageFlags2 stages = vk::PipelineStageFlagBits2::eAllCommands;
+    vk::AccessFlags2 access = vk::AccessFlagBits2::eNone;
+    /// Layout the image must be in while the pass runs, ignored for buffers
+    vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+    vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor;
+    /// Resources which only exist for one frame in flight are only transitioned on that frame
+    std::optional<uint8_t> frameInFlightIndex = std::nullopt;
+    /// The contents are consumed outside of the graph, such as by presentation or the host, which keeps the pass from
+    /// being culled
+    bool isExternal = false;
+    /// The contents are written by uploads submitted outside of the graph between frames, so the first use of each
+    /// frame waits on transfer writes even when it only reads
+    bool isUploaded = false;
+    /// The pass overwrites the whole resource without reading it first, so the first use of each frame may start from
+    /// an undefined layout no matter which pass used it last
+    bool discardsContents = false;
+
+    bool isWrite() const
+    {
+        constexpr vk::AccessFlags2 writeAccess =
+            vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eShaderStorageWrite |
+            vk::AccessFlagBits2::eColorAttachmentWrite | vk::AccessFlagBits2::eDepthStencilAttachmentWrite |
+            vk::AccessFlagBits2::eTransferWrite | vk::AccessFlagBits2::eHostWrite | vk::AccessFlagBits2::eMemoryWrite;
+
+        return static_cast<bool>(access & writeAccess);
+    }
+};
+
+/// Barrier derived by the graph between two uses of the same resource
+struct ResourceTransition
+{
+    Handle resource;
+    ResourceUse::Type type = ResourceUse::Type::image;
+    vk::PipelineStageFlags2 srcStages = vk::PipelineStageFlagBits2::eNone;
+    vk::AccessFlags2 srcAccess = vk::AccessFlagBits2::eNone;
+    vk::PipelineStageFlags2 dstStages = vk::PipelineStageFlagBits2::eNone;
+    vk::AccessFlags2 dstAccess = vk::AccessFlagBits2::eNone;
+    vk::ImageLayout oldLayout = vk::ImageLayout::eUndefined;
+    vk::ImageLayout newLayout = vk::ImageLayout::eUndefined;
+    vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor;
+    uint32_t srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+    uint32_t dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+    std::optional<uint8_t> frameInFlightIndex = std::nullopt;
+    /// Acquires ownership released by the last use of the resource in the previous frame
+    bool isFromLastFrame = false;
+
+    bool appliesTo(const uint8_t &index) const
+    {
+        return !frameInFlightIndex.has_value() || frameInFlightIndex.value() == index;
+    }
+
+    vk::ImageMemoryBarrier2 toImageBarrier(vk::Image image) const
+    {
+        return vk::ImageMemoryBarrier2()
+            .setSrcStageMask(srcStages)
+            .setSrcAccessMask(srcAccess)
+            .setDstStageMask(dstStages)
+            .setDstAccessMask(dstAccess)
+            .setOldLayout(oldLayout)
+            .setNewLayout(newLayout)
+            .setSrcQueueFamilyIndex(srcQueueFamilyIndex)
+            .setDstQueueFamilyIndex(dstQueueFamilyIndex)
+            .setImage(image)
+            .setSubresourceRange(vk::ImageSubresourceRange()
+                                     .setAspectMask(aspect)
+                                     .setBaseMipLevel(0)
+                                     .setLevelCount(vk::RemainingMipLevels)
+                                     .setBaseArrayLayer(0)
+                                     .setLayerCount(vk::RemainingArrayLayers));
+    }
+
+    vk::BufferMemoryBarrier2 toBufferBarrier(vk::Buffer buffer) const
+    {
+        return vk::BufferMemoryBarrier2()
+            .setSrcStageMask(srcStages)
+            .setSrcAccessMask(srcAccess)
+            .setDstStageMask(dstStages)
+            .setDstAccessMask(dstAccess)
+            .setSrcQueueFamilyIndex(srcQueueFamilyIndex)
+            .setDstQueueFamilyIndex(dstQueueFamilyIndex)
+            .setBuffer(buffer)
+            .setSize(vk::WholeSize);
+    }
+};
+} // namespace star::service::command_order
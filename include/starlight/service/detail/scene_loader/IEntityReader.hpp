@@ -11,5 +11,8 @@ class IEntityReader
     virtual ~IEntityReader() = default;
 
     virtual bool canLoad(const nlohmann::json &jData, const std::string &uniqueName) const noexcept = 0;
+
+    /// Check an entity node which has already been resolved, i.e. from SceneDocumentCache
+    virtual bool canLoad(const nlohmann::json &entityData) const noexcept = 0;
 };
 } // namespace star::service::scene_loader
\ No newline at end of file
@@ -12,6 +12,10 @@ class LightReader : public IEntityReader
   public:
     virtual bool canLoad(const nlohmann::json &lightData, const std::string &uniqueName) const noexcept override; 
 
+    virtual bool canLoad(const nlohmann::json &lightData) const noexcept override;
+
     void load(const nlohmann::json &lightDatas, const std::string &uniqueName, std::vector<Light> &light) const noexcept; 
+
+    void load(const nlohmann::json &lightData, std::vector<Light> &light) const noexcept;
 };
 } // namespace star::service::scene_writer
\ No newline at end of file
@@ -12,8 +12,12 @@ class ObjectLoader : public IEntityReader
   public:
     virtual bool canLoad(const nlohmann::json &objectDatas, const std::string &uniqueName) const noexcept override;
 
+    virtual bool canLoad(const nlohmann::json &objectData) const noexcept override;
+
     void load(const nlohmann::json &objectDatas, const std::string &uniqueName, StarObject &obj) const noexcept;
 
+    void load(const nlohmann::json &objectData, StarObject &obj) const noexcept;
+
   private:
     struct LoadedObjectInfo
     {
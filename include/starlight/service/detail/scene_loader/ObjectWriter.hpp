@@ -1,6 +1,7 @@
 #pragma once
 
 #include "starlight/object/StarObject.hpp"
+#include "starlight/service/detail/scene_loader/SceneStateSnapshot.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -10,5 +11,7 @@ class ObjectWriter
 {
   public:
     nlohmann::json write(const StarObject &object) const noexcept;
+
+    nlohmann::json write(const ObjectState &state) const noexcept;
 };
 } // namespace star::service::scene_loader
\ No newline at end of file
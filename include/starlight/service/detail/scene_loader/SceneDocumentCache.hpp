@@ -0,0 +1,63 @@
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace star::service::scene_loader
+{
+/// Parses the scene file once and keeps a name -> node index for objects and lights. The document is only re-read
+/// when the modification time of the file on disk changes.
+class SceneDocumentCache
+{
+  public:
+    SceneDocumentCache() = default;
+    explicit SceneDocumentCache(std::string sceneFilePath);
+    SceneDocumentCache(const SceneDocumentCache &) = delete;
+    SceneDocumentCache &operator=(const SceneDocumentCache &) = delete;
+    SceneDocumentCache(SceneDocumentCache &&other) noexcept;
+    SceneDocumentCache &operator=(SceneDocumentCache &&other) noexcept;
+    ~SceneDocumentCache() = default;
+
+    /// Re-parse the document if the file on disk has changed since the last read
+    /// @return true if a valid scene document is available
+    bool refresh();
+
+    /// Drop the parsed document so the next refresh always reads from disk
+    void invalidate() noexcept;
+
+    bool isValid() const noexcept
+    {
+        return m_root.has_value();
+    }
+
+    const nlohmann::json *getDocument() const noexcept
+    {
+        return m_root.has_value() ? &m_root.value() : nullptr;
+    }
+
+    const nlohmann::json *findObject(const std::string &uniqueName) const noexcept;
+
+    const nlohmann::json *findLight(const std::string &uniqueName) const noexcept;
+
+    const std::string &getSceneFilePath() const noexcept
+    {
+        return m_sceneFilePath;
+    }
+
+  private:
+    std::string m_sceneFilePath;
+    std::optional<std::filesystem::file_time_type> m_lastWriteTime = std::nullopt;
+    std::optional<nlohmann::json> m_root = std::nullopt;
+    absl::flat_hash_map<std::string, const nlohmann::json *> m_objectIndex;
+    absl::flat_hash_map<std::string, const nlohmann::json *> m_lightIndex;
+
+    void buildIndex();
+
+    static const nlohmann::json *Find(const absl::flat_hash_map<std::string, const nlohmann::json *> &index,
+                                      const std::string &uniqueName) noexcept;
+};
+} // namespace star::service::scene_loader
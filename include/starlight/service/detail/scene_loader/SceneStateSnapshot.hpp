@@ -0,0 +1,44 @@
+#pragma once
+
+#include "starlight/common/entities/Light.hpp"
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace star
+{
+class StarObject;
+}
+
+namespace star::service::scene_loader
+{
+/// Plain value copy of the persisted transform of a StarObject
+struct ObjectState
+{
+    glm::vec3 position{0.0f};
+    glm::vec3 rotationDeg{0.0f};
+    glm::vec3 scale{1.0f};
+
+    static ObjectState FromObject(const StarObject &object);
+
+    bool operator==(const ObjectState &other) const
+    {
+        return position == other.position && rotationDeg == other.rotationDeg && scale == other.scale;
+    }
+};
+
+/// Values captured on the main thread during a save. Serialization happens later, off the main thread.
+struct SceneStateSnapshot
+{
+    std::vector<std::pair<std::string, ObjectState>> objects;
+    std::vector<std::pair<std::string, std::vector<Light>>> lights;
+
+    bool empty() const noexcept
+    {
+        return objects.empty() && lights.empty();
+    }
+};
+} // namespace star::service::scene_loader
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "starlight/service/detail/scene_loader/SceneStateSnapshot.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cassert>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace star::service::scene_loader
+{
+/// Commits snapshots to the scene file from the IO worker. Every commit re-reads the file and merges the snapshot into
+/// it, so only entities contained in the snapshot are serialized again and edits made to the file in the meantime are
+/// kept for everything else.
+///
+/// The object states of a snapshot only count as saved once its commit succeeded. They are collected here until the
+/// owner takes them with takeCommittedObjectStates, a failed commit leaves its objects dirty for the next save.
+class SceneStateWriter
+{
+  public:
+    /// Write function for job::tasks::io::WritePayload
+    struct Commit
+    {
+        std::shared_ptr<SceneStateWriter> writer = nullptr;
+        std::unique_ptr<SceneStateSnapshot> snapshot = nullptr;
+
+        int operator()(const std::filesystem::path &path)
+        {
+            assert(writer != nullptr && snapshot != nullptr);
+            return writer->write(std::move(*snapshot), path);
+        }
+    };
+
+    SceneStateWriter() = default;
+
+    int write(SceneStateSnapshot snapshot, const std::filesystem::path &path);
+
+    /// Object states written by commits which succeeded since the previous call, in commit order
+    std::vector<std::pair<std::string, ObjectState>> takeCommittedObjectStates();
+
+  private:
+    std::mutex m_writeLock;
+    std::mutex m_committedLock;
+    std::vector<std::pair<std::string, ObjectState>> m_committedObjectStates;
+
+    /// Empty when the file exists but can not be parsed, committing over it would drop every entity not in the snapshot
+    static std::optional<nlohmann::json> LoadExistingDocument(const std::filesystem::path &path);
+};
+} // namespace star::service::scene_loader
@@ -9,6 +9,7 @@
 
 #include <string_view>
 #include <optional>
+#include <vector>
 
 namespace star::service::detail::screen_capture::common
 {
@@ -41,5 +42,10 @@ struct InUseResourceInformation
     vk::Semaphore *semaphoreForBlitDone = nullptr;
     star::StarSemaphore *targetTextureReadySemaphore{nullptr};
     vk::Queue queueToUse = VK_NULL_HANDLE;
+    /// Barriers derived by the command order graph for the target texture, around the copy
+    std::vector<vk::ImageMemoryBarrier2> graphAcquireBarriers;
+    std::vector<vk::ImageMemoryBarrier2> graphReleaseBarriers;
+    /// The graph transitions the target texture, otherwise the copy moves it to transfer src and back by hand
+    bool isTargetInGraph = false;
 };
 } // namespace star::service::detail::screen_capture::common
\ No newline at end of file
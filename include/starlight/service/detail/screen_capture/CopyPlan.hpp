@@ -12,5 +12,7 @@ struct CopyPlan
     common::RoutePath path;
     vk::Filter blitFilter;
     CalleeRenderDependencies *calleeDependencies = nullptr;
+    /// Handle of the target texture in the command order graph, targets without one are transitioned by hand
+    std::optional<Handle> targetTextureResource = std::nullopt;
 };
 } // namespace star::service::detail::screen_capture
\ No newline at end of file
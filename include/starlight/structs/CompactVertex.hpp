@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Vertex.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace star {
+/// <summary>
+/// Quantized version of star::Vertex (36 bytes instead of 96). Every stream uses a format which the vertex
+/// fetch unit expands back to floats, so shaders written against star::Vertex read it unchanged.
+/// Material values are not stored per vertex, see VertexMaterialConstants.
+/// </summary>
+struct CompactVertex {
+public:
+    glm::vec3 pos{ 0.0f, 0.0f, 0.0f };          // R32G32B32_SFLOAT
+    glm::i16vec4 normal{ 0, 0, 0, 0 };          // R16G16B16A16_SNORM
+    glm::u8vec4 color{ 0, 0, 0, 0 };            // R8G8B8A8_UNORM
+    glm::u16vec2 texCoord{ 0, 0 };              // R16G16_SFLOAT
+    glm::i8vec4 aTangent{ 0, 0, 0, 0 };         // R8G8B8A8_SNORM
+    glm::i8vec4 aBitangent{ 0, 0, 0, 0 };       // R8G8B8A8_SNORM
+
+    static CompactVertex Pack(const Vertex& vertex) {
+        CompactVertex packed{};
+        packed.pos = vertex.pos;
+        packed.normal = glm::i16vec4(PackSnorm<int16_t>(vertex.normal), 0);
+        packed.color = glm::u8vec4(PackUnorm8(vertex.color), 255);
+        packed.texCoord = glm::u16vec2(glm::packHalf1x16(vertex.texCoord.x), glm::packHalf1x16(vertex.texCoord.y));
+        packed.aTangent = glm::i8vec4(PackSnorm<int8_t>(vertex.aTangent), 0);
+        packed.aBitangent = glm::i8vec4(PackSnorm<int8_t>(vertex.aBitangent), 0);
+        return packed;
+    }
+
+private:
+    template <typename T>
+    static glm::vec<3, T> PackSnorm(const glm::vec3& value) {
+        constexpr float maxValue = static_cast<float>(std::numeric_limits<T>::max());
+        return glm::vec<3, T>(glm::round(glm::clamp(value, -1.0f, 1.0f) * maxValue));
+    }
+
+    static glm::u8vec3 PackUnorm8(const glm::vec3& value) {
+        return glm::u8vec3(glm::round(glm::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+};
+
+/// <summary>
+/// Material values which star::Vertex repeats for every vertex. With the compact layout these are stored once
+/// at the end of the vertex buffer and read through a binding with a stride of 0.
+/// </summary>
+struct VertexMaterialConstants {
+public:
+    glm::vec3 matAmbient = glm::vec3{ 1.0f, 1.0f, 1.0f };
+    glm::vec3 matDiffuse = glm::vec3{ 1.0f, 1.0f, 1.0f };
+    glm::vec3 matSpecular = glm::vec3{ 1.0f, 1.0f, 1.0f };
+    float matShininess = 1.0f;
+
+    static VertexMaterialConstants FromVertex(const Vertex& vertex) {
+        return VertexMaterialConstants{ vertex.matAmbient, vertex.matDiffuse, vertex.matSpecular,
+                                        vertex.matShininess };
+    }
+};
+
+static_assert(sizeof(CompactVertex) == 36, "CompactVertex must stay tightly packed");
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "GpuCullingPass.hpp"
+#include "StarMaterial.hpp"
+#include "StarMesh.hpp"
+#include "StarPipeline.hpp"
+#include "core/renderer/RecordState.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <vulkan/vulkan.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace star
+{
+class StarObject;
+
+/// Binds issued while recording a draw list, and the binds skipped because the state was already in place
+struct DrawStats
+{
+    size_t numDraws = 0;
+    size_t numPipelineBinds = 0;
+    size_t numDescriptorBinds = 0;
+    size_t numVertexBufferBinds = 0;
+    size_t numIndexBufferBinds = 0;
+    size_t numBindsSaved = 0;
+
+    DrawStats &operator+=(const DrawStats &other)
+    {
+        numDraws += other.numDraws;
+        numPipelineBinds += other.numPipelineBinds;
+        numDescriptorBinds += other.numDescriptorBinds;
+        numVertexBufferBinds += other.numVertexBufferBinds;
+        numIndexBufferBinds += other.numIndexBufferBinds;
+        numBindsSaved += other.numBindsSaved;
+        return *this;
+    }
+};
+
+/// Mesh draws gathered from every render group for one frame. Each draw gets a sort key made of its pipeline, then
+/// material descriptor sets, then vertex buffer, then depth, so that draws sharing state end up next to each other
+/// and opaque geometry is drawn front to back. Recording skips any bind whose state is already current.
+///
+/// Buffers and descriptor sets are looked up once per frame while sorting, so that once sorted any number of threads
+/// may record separate ranges of the list at the same time.
+class DrawList
+{
+  public:
+    struct Draw
+    {
+        StarPipeline *pipeline = nullptr;
+        vk::PipelineLayout pipelineLayout{VK_NULL_HANDLE};
+        StarMaterial *material = nullptr;
+        const StarMesh *mesh = nullptr;
+        uint32_t instanceCount = 0;
+        /// When set, draw parameters are read from the cull pass instead of instanceCount, one indirect draw per mesh
+        const GpuCullingPass *gpuCulling = nullptr;
+        uint32_t gpuDrawIndex = 0;
+        /// Distance in front of the camera, smaller is drawn first among draws sharing the same state
+        float depth = 0.0f;
+    };
+
+    void clear();
+
+    void add(const Draw &draw)
+    {
+        m_draws.push_back(draw);
+    }
+
+    /// Debug geometry of an object, drawn after every draw of the list since it binds its own pipelines
+    void addDebug(StarObject *object)
+    {
+        m_debugObjects.push_back(object);
+    }
+
+    size_t size() const
+    {
+        return m_draws.size();
+    }
+
+    /// Look up the buffers and descriptor sets of every draw for the frame, then order the draws by their sort keys.
+    /// Draws with equal keys keep the order they were added in. Must be called before recording.
+    void sort(const uint8_t &frameInFlightIndex);
+
+    DrawStats record(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex) const
+    {
+        return record(commandBuffer, frameInFlightIndex, 0, m_draws.size());
+    }
+
+    /// Record count draws in sorted order starting from first. Nothing is assumed to be bound beforehand.
+    DrawStats record(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex, const size_t &first,
+                     const size_t &count) const;
+
+    /// Record the debug geometry of every object added through addDebug. Must follow the last range of draws.
+    void recordDebug(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex) const;
+
+    /// Add everything record and recordDebug would issue for the sorted list
+    void hashRecordState(core::renderer::RecordState &state) const;
+
+  private:
+    static constexpr uint32_t PipelineBits = 12;
+    static constexpr uint32_t MaterialBits = 18;
+    static constexpr uint32_t GeometryBits = 18;
+    static constexpr uint32_t DepthBits = 16;
+    static_assert(PipelineBits + MaterialBits + GeometryBits + DepthBits == 64, "Sort key fields must fill 64 bits");
+
+    static constexpr uint32_t RadixBits = 8;
+    static constexpr size_t RadixSize = size_t(1) << RadixBits;
+
+    struct SortEntry
+    {
+        uint64_t key = 0;
+        uint32_t index = 0;
+    };
+
+    /// State of a draw looked up while sorting
+    struct ResolvedDraw
+    {
+        vk::Buffer vertexBuffer{VK_NULL_HANDLE}, indexBuffer{VK_NULL_HANDLE};
+        uint32_t materialID = 0;
+    };
+
+    /// Descriptor sets of one material, stored in m_descriptorSets
+    struct DescriptorRange
+    {
+        size_t offset = 0;
+        uint32_t count = 0;
+        size_t numWrites = 0;
+    };
+
+    std::vector<Draw> m_draws;
+    std::vector<ResolvedDraw> m_resolved;
+    std::vector<SortEntry> m_order, m_scratch;
+    std::vector<DescriptorRange> m_materialSets;
+    std::vector<vk::DescriptorSet> m_descriptorSets;
+    std::vector<StarObject *> m_debugObjects;
+
+    // ids are handed out in the order state is first seen each frame, so keys follow the order draws are added
+    absl::flat_hash_map<const void *, uint32_t> m_pipelineIds, m_materialIds;
+    absl::flat_hash_map<VkBuffer, uint32_t> m_geometryIds;
+
+    ResolvedDraw resolve(const Draw &draw, const uint8_t &frameInFlightIndex);
+
+    uint64_t makeKey(const Draw &draw, const ResolvedDraw &resolved);
+
+    template <typename TKey> static uint32_t GetID(absl::flat_hash_map<TKey, uint32_t> &ids, const TKey &key)
+    {
+        return ids.try_emplace(key, static_cast<uint32_t>(ids.size())).first->second;
+    }
+
+    /// Ids past the width of their field share the last value, which only costs binds, never correctness
+    static uint64_t ClampID(const uint32_t &id, const uint32_t &numBits)
+    {
+        const uint32_t maxID = (uint32_t(1) << numBits) - 1;
+        return id < maxID ? id : maxID;
+    }
+
+    static uint32_t QuantizeDepth(const float &depth);
+
+    static void RadixSort(std::vector<SortEntry> &entries, std::vector<SortEntry> &scratch);
+};
+} // namespace star
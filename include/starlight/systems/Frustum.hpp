@@ -0,0 +1,76 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace star
+{
+/// Counts gathered while culling, summed over everything tested in a frame
+struct CullingStats
+{
+    size_t numTested = 0;
+    size_t numVisible = 0;
+
+    size_t getNumCulled() const
+    {
+        return numTested - numVisible;
+    }
+
+    CullingStats &operator+=(const CullingStats &other)
+    {
+        numTested += other.numTested;
+        numVisible += other.numVisible;
+        return *this;
+    }
+};
+
+/// Six planes of a view volume, stored one component per array so a batch of boxes can be tested against each plane
+/// with straight line loops the compiler can vectorize.
+class Frustum
+{
+  public:
+    static constexpr size_t NumPlanes = 6;
+    static constexpr size_t BatchSize = 64;
+    /// Index of the near plane within getPlanes(), its distance is a view depth usable for sorting
+    static constexpr size_t NearPlaneIndex = 4;
+
+    /// Boxes transformed into world space, as centers and half extents stored one component per array
+    struct BoxBatch
+    {
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> extentX, extentY, extentZ;
+
+        void resize(const size_t &count);
+
+        size_t size() const
+        {
+            return centerX.size();
+        }
+
+        /// Transform the local box by the matrix and store the enclosing world space box at the index
+        void set(const size_t &index, const glm::mat4 &transform, const glm::vec3 &localCenter,
+                 const glm::vec3 &localExtent);
+    };
+
+    Frustum() = default;
+
+    /// Extract the planes from a projection * view matrix with a [0, 1] depth range
+    static Frustum FromViewProjection(const glm::mat4 &viewProjection);
+
+    /// Test every box in the batch against the planes
+    /// @param visible Set to 1 for boxes inside or intersecting the frustum, 0 otherwise
+    void testBoxes(const BoxBatch &boxes, std::vector<uint8_t> &visible) const;
+
+    /// Planes as normal in xyz and distance in w, a point is inside when dot(normal, point) + distance >= 0
+    std::array<glm::vec4, NumPlanes> getPlanes() const;
+
+  private:
+    std::array<float, NumPlanes> m_normalX{}, m_normalY{}, m_normalZ{}, m_distance{};
+
+    void testRange(const BoxBatch &boxes, const size_t &first, const size_t &count, uint8_t *visible) const;
+};
+} // namespace star
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Frustum.hpp"
+#include "StarBuffers/Buffer.hpp"
+#include "StarDescriptorBuilders.hpp"
+#include "StarPipeline.hpp"
+#include "StarShaderInfo.hpp"
+#include "core/device/DeviceContext.hpp"
+#include "core/renderer/RecordState.hpp"
+#include "starlight/service/detail/command_order/ResourceUse.hpp"
+#include <star_common/Handle.hpp>
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace star
+{
+/// Frustum culling of the instances of one object on the GPU. A compute pass tests the bounds of every instance,
+/// copies the transforms of the visible ones to the front of the buffers read while drawing and fills in one indexed
+/// indirect draw per mesh. The CPU neither culls nor re-uploads instance data, and the vertex shaders read the same
+/// compacted layout as they do on the CPU culled path.
+///
+/// Only culling and instance uploads move to the GPU. Meshes keep their own geometry buffers and the materials of an
+/// object may differ, so the draw list still issues one indirect draw per mesh of every culled object. Merging those
+/// into a single count driven draw per pipeline would need the geometry of every mesh suballocated from shared
+/// buffers and materials indexed from the shaders, neither of which exists yet.
+///
+/// The shader is read from shaders/culling/instanceCull.comp in the media directory when present, otherwise from the
+/// copy shipped with the library in shaders/ at the root of the repository. It must match:
+///  - local_size_x = WorkgroupSize
+///  - set 0, std430 buffers: 0 mat3x4 models[], 1 mat3x4 normals[], 2 mat3x4 visibleModels[],
+///    3 mat3x4 visibleNormals[], 4 VkDrawIndexedIndirectCommand draws[], 5 uint drawCount
+///  - push constants laid out as PushConstants
+/// A visible instance takes its slot from an atomicAdd on draws[0].instanceCount, adds one to the instance count of
+/// every other draw, and the first one stores numDraws into drawCount.
+///
+/// With gpu_culling_validation set in the config, the visible count of each cull is read back once its frame in flight
+/// comes around again and compared with the count the CPU frustum test found for the same instances.
+class GpuCullingPass
+{
+  public:
+    static constexpr uint32_t WorkgroupSize = 64;
+    static constexpr uint32_t DrawCommandStride = sizeof(vk::DrawIndexedIndirectCommand);
+    static constexpr size_t MaxDraws = 65536 / DrawCommandStride;
+    /// Location of the shader below the shaders directory
+    static constexpr const char *ShaderPath = "culling/instanceCull.comp";
+
+    struct PushConstants
+    {
+        std::array<glm::vec4, Frustum::NumPlanes> planes{};
+        glm::vec3 boundsCenter{0.0f};
+        uint32_t instanceCount = 0;
+        glm::vec3 boundsExtent{0.0f};
+        uint32_t numDraws = 0;
+    };
+    static_assert(sizeof(PushConstants) == 128, "Push constants must fit in the smallest range a device may offer");
+
+    /// @param maxInstances Instances the compacted buffers initially hold. When 0 the instance count at prep time is
+    /// used. The buffers grow when more instances are culled.
+    explicit GpuCullingPass(const uint32_t &maxInstances = 0) : m_capacity(maxInstances)
+    {
+    }
+
+    /// Create the compacted instance buffers, indirect draws and compute pipeline
+    /// @param modelHandles Full instance model buffer of each frame in flight
+    /// @param normalHandles Full instance normal buffer of each frame in flight
+    /// @param draws One draw per mesh, instance counts are filled in by the compute pass
+    void prepRender(core::device::DeviceContext &context, const uint8_t &numFramesInFlight,
+                    const std::vector<Handle> &modelHandles, const std::vector<Handle> &normalHandles,
+                    std::vector<vk::DrawIndexedIndirectCommand> draws, const size_t &numInstances);
+
+    void cleanupRender(core::device::DeviceContext &context);
+
+    bool isRenderReady(core::device::DeviceContext &context);
+
+    /// Check the readback of the previous cull of the frame in flight and grow its compacted buffers to hold
+    /// numInstances. The GPU must be done with the previous submission of the frame in flight.
+    void frameUpdate(core::device::DeviceContext &context, const uint8_t &frameInFlightIndex,
+                     const size_t &numInstances);
+
+    void setFrustum(const Frustum &frustum)
+    {
+        m_planes = frustum.getPlanes();
+    }
+
+    bool isValidating() const
+    {
+        return m_isValidating;
+    }
+
+    /// Visible instance count found by the CPU for the frustum of the next cull, compared against the GPU result
+    void setExpectedVisibleCount(const size_t &numVisible)
+    {
+        m_expectedVisibleCount = numVisible;
+    }
+
+    /// Reset the draws, dispatch the culling and make the results visible to the indirect draws and vertex shaders.
+    /// Must be recorded outside of rendering.
+    /// @return false when nothing was recorded, draws for the frame must be skipped
+    bool recordCullCommands(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
+                            const size_t &numInstances, const glm::vec3 &localBoundsCenter,
+                            const glm::vec3 &localBoundsExtent);
+
+    /// Add everything recordCullCommands would record with the same arguments
+    void hashRecordState(core::renderer::RecordState &state, const uint8_t &frameInFlightIndex,
+                         const size_t &numInstances, const glm::vec3 &localBoundsCenter,
+                         const glm::vec3 &localBoundsExtent);
+
+    /// Draw one mesh with the parameters written by the last cull of the frame, geometry must already be bound
+    void recordDraw(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
+                    const uint32_t &drawIndex) const;
+
+    /// Compacted instance buffers written by the cull and read by the draws of the frame in flight. The indirect draw
+    /// buffers are not behind handles and stay ordered by the barriers recordCullCommands records itself.
+    std::vector<service::command_order::ResourceUse> getResourceUses(const uint8_t &frameInFlightIndex) const;
+
+    /// Compacted models of the frame in flight. The buffer behind the handle is replaced when it grows.
+    const Handle &getVisibleModels(const uint8_t &frameInFlightIndex) const
+    {
+        return m_frames[frameInFlightIndex].visibleModels;
+    }
+    /// Compacted normals of the frame in flight. The buffer behind the handle is replaced when it grows.
+    const Handle &getVisibleNormals(const uint8_t &frameInFlightIndex) const
+    {
+        return m_frames[frameInFlightIndex].visibleNormals;
+    }
+
+  private:
+    struct FrameResources
+    {
+        Handle visibleModels, visibleNormals;
+        uint32_t capacity = 0;
+        std::unique_ptr<StarBuffers::Buffer> draws, drawCount, readback;
+        std::optional<size_t> expectedVisibleCount = std::nullopt;
+        bool wasCulled = false;
+    };
+
+    uint32_t m_capacity = 0;
+    bool m_useDrawCount = false;
+    bool m_isValidating = false;
+    bool m_hasWarnedMismatch = false;
+    std::optional<size_t> m_expectedVisibleCount = std::nullopt;
+    Handle m_deviceID;
+    std::array<glm::vec4, Frustum::NumPlanes> m_planes{};
+    std::vector<vk::DrawIndexedIndirectCommand> m_drawTemplate;
+    std::vector<FrameResources> m_frames;
+    std::shared_ptr<StarDescriptorSetLayout> m_setLayout;
+    std::unique_ptr<StarDescriptorPool> m_descriptorPool;
+    std::unique_ptr<StarShaderInfo> m_shaderInfo;
+    vk::PipelineLayout m_pipelineLayout{VK_NULL_HANDLE};
+    Handle m_pipeline;
+    StarPipeline *m_boundPipeline = nullptr;
+};
+} // namespace star
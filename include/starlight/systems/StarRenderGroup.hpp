@@ -1,6 +1,8 @@
 #pragma once
 
+#include "DrawList.hpp"
 #include "Enums.hpp"
+#include "Frustum.hpp"
 #include "Light.hpp"
 #include "StarCommandBuffer.hpp"
 #include "StarDescriptorBuilders.hpp"
@@ -46,8 +48,15 @@ class StarRenderGroup
                      const Handle &targetCommandBuffer,
                      const star::core::graphics::SemaphoreInfo &transferReuqestSyncInfo);
 
-    virtual void recordRenderPassCommands(vk::CommandBuffer &mainDrawBuffer, const uint8_t &swapChainImageIndex,
-                                          const uint64_t &frameIndex);
+    /// Cull the instances of every object in the group against the frustum
+    CullingStats cullInstances(const Frustum &frustum);
+
+    /// Add everything the objects of the group record outside of their draws, before and after the rendering pass
+    virtual void hashRecordState(core::renderer::RecordState &state, const uint8_t &frameInFlightIndex,
+                                 const uint64_t &frameIndex);
+
+    /// Add the draws of every object in the group, bound against the layout shared by the group
+    virtual void collectDraws(DrawList &drawList, const uint8_t &frameInFlightIndex);
 
     virtual void recordPreRenderPassCommands(vk::CommandBuffer &mainDrawBuffer, const uint8_t &swapChainImageIndex,
                                              const uint64_t &frameIndex);
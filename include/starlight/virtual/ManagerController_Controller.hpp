@@ -48,7 +48,15 @@ template <typename TTransferType, typename TDataType> class Controller
         return m_resourceHandles[index];
     }
 
-    /// Call any frame updates. Returns true if the controller submitted an update
+    /// Data written directly from the CPU into host visible memory. It needs no transfer semaphore or barrier.
+    virtual bool isWrittenByHost(const uint8_t &frameInFlightIndex) const
+    {
+        (void)frameInFlightIndex;
+        return false;
+    }
+
+    /// Call any frame updates. Returns true if the controller submitted an update. The semaphore is null when the
+    /// update was written by the host and there is nothing to wait on.
     std::pair<bool, const star::StarSemaphore *> submitUpdateIfNeeded(
         core::device::DeviceContext &context, const uint8_t &frameInFlightIndex,
         std::optional<star::core::graphics::SemaphoreInfo> transferGPUWorkWaitOnSyncInfo = std::nullopt)
@@ -61,12 +69,16 @@ template <typename TTransferType, typename TDataType> class Controller
             return std::make_pair(false, nullptr);
 
         if (hasAlreadyBeenUpdatedThisFrame(context.frameTracker().getCurrent().getGlobalFrameCounter()))
-            return std::make_pair(true, &getSemaphore(context, fi));
+            return std::make_pair(true, isWrittenByHost(fi) ? nullptr : &getSemaphore(context, fi));
 
         m_lastFrameUpdate = context.frameTracker().getCurrent().getGlobalFrameCounter();
-        context.getManagerRenderResource().updateRequest(
-            context.getDeviceID(), createTransferRequest(context, frameInFlightIndex),
-            m_resourceHandles[frameInFlightIndex], std::move(transferGPUWorkWaitOnSyncInfo), true);
+        auto request = createTransferRequest(context, frameInFlightIndex);
+        if (isWrittenByHost(fi) && writeFromHost(context, fi, *request))
+            return std::make_pair(true, nullptr);
+
+        context.getManagerRenderResource().updateRequest(context.getDeviceID(), std::move(request),
+                                                         m_resourceHandles[frameInFlightIndex],
+                                                         std::move(transferGPUWorkWaitOnSyncInfo), true);
         return std::make_pair(true, &getSemaphore(context, fi));
     }
 
@@ -94,5 +106,16 @@ template <typename TTransferType, typename TDataType> class Controller
     }
 
     virtual bool doesFrameInFlightDataNeedUpdated(const uint8_t &frameInFlightIndex) const = 0;
+
+    /// Write the request straight into host visible memory. Returns false if the request must go through the transfer
+    /// queue instead.
+    virtual bool writeFromHost(core::device::DeviceContext &context, const size_t &frameInFlightIndex,
+                               const TTransferType &request)
+    {
+        (void)context;
+        (void)frameInFlightIndex;
+        (void)request;
+        return false;
+    }
 };
 } // namespace star::ManagerController
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #include <star_common/EventBus.hpp>
 
+#include <vector>
+
 namespace star::ManagerController::RenderResource
 {
 class Buffer : public star::ManagerController::Controller<TransferRequest::Buffer, StarBuffers::Buffer>
@@ -15,7 +17,18 @@ class Buffer : public star::ManagerController::Controller<TransferRequest::Buffe
     Buffer() = default;
     virtual ~Buffer() = default;
 
+    /// Places the data for each frame in flight in the host visible frame ring when it fits, otherwise falls back to
+    /// the transfer queue. The initial contents are written immediately either way.
+    void prepRender(core::device::DeviceContext &context, const uint8_t &numFramesInFlight) override;
+
+    bool isWrittenByHost(const uint8_t &frameInFlightIndex) const override;
+
   protected:
+    std::vector<bool> m_isWrittenByHost;
+
+    bool writeFromHost(core::device::DeviceContext &context, const size_t &frameInFlightIndex,
+                       const TransferRequest::Buffer &request) override;
+
     virtual std::unique_ptr<TransferRequest::Buffer> createTransferRequest(
         core::device::DeviceContext &device, const uint8_t &frameInFlightIndex) override = 0;
     virtual bool doesFrameInFlightDataNeedUpdated(const uint8_t &frameInFlightIndex) const override = 0;
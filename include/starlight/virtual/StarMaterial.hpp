@@ -45,6 +45,13 @@ class StarMaterial
 
     virtual void bind(vk::CommandBuffer &commandBuffer, vk::PipelineLayout pipelineLayout, int swapChainImageIndex);
 
+    /// Descriptor sets bound by bind, starting from set 0. Rebuilds any set whose resources have changed, so must not
+    /// be called from more than one thread at a time.
+    virtual std::vector<vk::DescriptorSet> getDescriptorSets(const uint8_t &frameInFlightIndex);
+
+    /// Number of in place writes to the sets returned by getDescriptorSets, which keep their handles when rebuilt
+    virtual size_t getNumDescriptorWrites(const uint8_t &frameInFlightIndex) const;
+
     bool isKnownToBeReady(const uint8_t &swapChainImageIndex);
 
     /// Add the descriptor types to be used in this material to the provided layout builder. The layout builder should
@@ -5,6 +5,7 @@
 #include <star_common/Handle.hpp>
 #include "StarCommandBuffer.hpp"
 #include "StarDescriptorBuilders.hpp"
+#include "Enums.hpp"
 #include "StarMaterial.hpp"
 #include "Vertex.hpp"
 
@@ -17,19 +18,33 @@ namespace star
 class StarMesh
 {
   public:
-    StarMesh(const Handle &vertBuffer, const Handle &indBuffer, std::vector<Vertex> &vertices,
-             std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material, bool hasAdjacenciesPacked);
+    StarMesh(const Handle &vertBuffer, const Handle &indBuffer, const std::vector<Vertex> &vertices,
+             const std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material,
+             bool hasAdjacenciesPacked, vk::IndexType indexType = vk::IndexType::eUint32,
+             Vertex_Layout vertexLayout = Vertex_Layout::full);
 
-    StarMesh(const Handle &vertBuffer, const Handle &indBuffer, std::vector<Vertex> &vertices,
-             std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material, const glm::vec3 &boundBoxMinCoord,
-             const glm::vec3 &boundBoxMaxCoord, bool packAdjacencies = false);
+    StarMesh(const Handle &vertBuffer, const Handle &indBuffer, const std::vector<Vertex> &vertices,
+             const std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material,
+             const glm::vec3 &boundBoxMinCoord, const glm::vec3 &boundBoxMaxCoord, bool packAdjacencies = false);
 
     virtual ~StarMesh() = default;
 
     virtual void prepRender(core::device::DeviceContext &device);
 
-    virtual void recordRenderPassCommands(vk::CommandBuffer &commandBuffer, vk::PipelineLayout &pipelineLayout,
-                                          const uint8_t &frameInFlightIndex, const uint32_t &instanceCount);
+    void bindVertexBuffers(vk::CommandBuffer &commandBuffer) const;
+
+    /// Bind geometry already looked up through getVertexBuffer, avoiding the resource manager while recording
+    void bindVertexBuffers(vk::CommandBuffer &commandBuffer, const vk::Buffer &vertexBuffer) const;
+
+    void bindIndexBuffer(vk::CommandBuffer &commandBuffer) const;
+
+    void bindIndexBuffer(vk::CommandBuffer &commandBuffer, const vk::Buffer &indexBuffer) const;
+
+    /// Draw every instance, the material and geometry must already be bound
+    void recordDraw(vk::CommandBuffer &commandBuffer, const uint32_t &instanceCount) const
+    {
+        commandBuffer.drawIndexed(this->numInds, instanceCount, 0, 0, 0);
+    }
 
     bool isKnownToBeReady(const uint8_t &frameInFlightIndex);
 
@@ -58,6 +73,12 @@ class StarMesh
     {
         return this->numInds;
     }
+    vk::IndexType getIndexType() const
+    {
+        return m_indexType;
+    }
+    vk::Buffer getVertexBuffer() const;
+    vk::Buffer getIndexBuffer() const;
 
   protected:
     Handle m_deviceID;
@@ -68,5 +89,7 @@ class StarMesh
     bool hasAdjacenciesPacked = false;
     bool triangular = false;
     bool isReady = false;
+    vk::IndexType m_indexType = vk::IndexType::eUint32;
+    Vertex_Layout m_vertexLayout = Vertex_Layout::full;
 };
 } // namespace star
\ No newline at end of file
@@ -24,6 +24,8 @@ class StarPipeline
         std::vector<std::pair<star::StarShader, std::shared_ptr<std::vector<uint32_t>>>> compiledShaders;
         core::renderer::RenderingTargetInfo renderingTargetInfo;
         vk::Extent2D swapChainExtent;
+        // driver cache used while creating the pipeline, owned by whoever runs the build
+        vk::PipelineCache pipelineCache = VK_NULL_HANDLE;
     };
 
     struct GraphicsPipelineConfigSettings
@@ -38,8 +40,8 @@ class StarPipeline
         std::vector<VkDynamicState> dynamicStateEnables;
         vk::PipelineDynamicStateCreateInfo dynamicStateInfo;
         vk::Extent2D swapChainExtent;
-        std::vector<vk::VertexInputBindingDescription> vertInputBindingDescription =
-            std::vector<vk::VertexInputBindingDescription>{VulkanVertex::getBindingDescription()};
+        // layout of the vertex buffers bound while drawing, selects the vertex input bindings and attributes
+        Vertex_Layout vertexLayout = Vertex_Layout::full;
         uint32_t subpass = 0;
     };
 
@@ -126,6 +128,11 @@ class StarPipeline
         return m_shaders;
     }
 
+    /// Bytes describing everything which decides the built pipeline when built for the provided targets. Pipelines
+    /// with equal keys are interchangeable.
+    std::string getStateKey(const vk::Extent2D &resolution,
+                            const core::renderer::RenderingTargetInfo &renderingInfo) const;
+
   private:
     vk::PipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
     std::variant<GraphicsPipelineConfigSettings, ComputePipelineConfigSettings> m_configSettings;
@@ -13,7 +13,9 @@ class StarShader
 {
   public:
     StarShader() = default;
-    StarShader(const std::string &path, const star::Shader_Stage &stage) : path(path), stage(stage)
+    StarShader(const std::string &path, const star::Shader_Stage &stage,
+               const star::Shader_Optimization &optimization = star::Shader_Optimization::performance)
+        : path(path), stage(stage), optimization(optimization)
     {
     }
     ~StarShader() = default;
@@ -32,8 +34,14 @@ class StarShader
         return this->path;
     }
 
+    star::Shader_Optimization getOptimization() const
+    {
+        return this->optimization;
+    }
+
   protected:
     std::string path = "";
     star::Shader_Stage stage = star::Shader_Stage::none;
+    star::Shader_Optimization optimization = star::Shader_Optimization::performance;
 };
 } // namespace star
\ No newline at end of file
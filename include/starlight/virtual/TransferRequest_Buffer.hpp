@@ -3,14 +3,33 @@
 #include "TransferRequest_Memory.hpp"
 #include "StarBuffers/Buffer.hpp"
 
+#include <optional>
+#include <string>
+
 namespace star::TransferRequest
 {
+/// Shape of the staging memory filled by writeDataToStageBuffer
+struct StagingLayout
+{
+    vk::DeviceSize size = 0;
+    uint32_t instanceCount = 0;
+    vk::DeviceSize instanceSize = 0;
+    vk::DeviceSize minOffsetAlignment = 1;
+};
+
 class Buffer : public Memory<StarBuffers::Buffer>
 {
   public:
     Buffer() = default;
     virtual ~Buffer() = default;
 
+    /// Describe the staging buffer this request needs so the transfer worker can place it in its shared staging
+    /// memory. Requests returning std::nullopt always receive a dedicated buffer from createStagingBuffer.
+    virtual std::optional<StagingLayout> getStagingLayout() const
+    {
+        return std::nullopt;
+    }
+
     virtual std::unique_ptr<StarBuffers::Buffer> createStagingBuffer(
         vk::Device &device, VmaAllocator &allocator) const override = 0;
 
@@ -25,6 +44,12 @@ class Buffer : public Memory<StarBuffers::Buffer>
   protected:
     static void DefaultCopy(StarBuffers::Buffer &srcBuffer, StarBuffers::Buffer &dstBuffer, vk::CommandBuffer &commandBuffer);
 
+    /// Dedicated host visible staging buffer shaped by layout, so requests describe their staging size only once in
+    /// getStagingLayout
+    static std::unique_ptr<StarBuffers::Buffer> CreateStagingBuffer(VmaAllocator &allocator,
+                                                                    const StagingLayout &layout,
+                                                                    const std::string &name);
+
   private:
 };
 } // namespace star::TransferRequest
\ No newline at end of file
@@ -45,6 +45,14 @@ class Buffer
            const vk::DeviceSize &minOffsetAlignment, const VmaAllocationCreateInfo &allocCreateInfo,
            const vk::BufferCreateInfo &bufferCreateInfo, const std::string &allocName);
 
+    /// Create a buffer which refers to a range of an existing buffer. Mapping, writes and flushes are relative to the
+    /// start of the range. Cleaning up a view only releases its reference to the shared resources.
+    static std::unique_ptr<Buffer> CreateView(std::shared_ptr<Resources> resources,
+                                              const vk::BufferUsageFlags &usageFlags, const vk::DeviceSize &rangeOffset,
+                                              const vk::DeviceSize &rangeSize, const uint32_t &instanceCount,
+                                              const vk::DeviceSize &instanceSize,
+                                              const vk::DeviceSize &minOffsetAlignment = 1);
+
     void map(void **mapped) const;
 
     void unmap() const;
@@ -58,11 +66,16 @@ class Buffer
     vk::Result flush(const vk::DeviceSize &size = vk::WholeSize, const vk::DeviceSize &offset = 0) const;
 
     vk::DescriptorBufferInfo descriptorInfo(const vk::DeviceSize &size = vk::WholeSize,
-                                            const vk::DeviceSize &offset = 0);
+                                            const vk::DeviceSize &offset = 0) const;
 
     void writeToIndex(void *data, void *mapped, const size_t &index);
     vk::Result flushIndex(const size_t &index);
-    vk::DescriptorBufferInfo descriptorInfoForIndex(const size_t &index);
+    vk::DescriptorBufferInfo descriptorInfoForIndex(const size_t &index) const;
+
+    std::shared_ptr<Resources> shareResources() const
+    {
+        return resources;
+    }
 
     std::shared_ptr<Resources> releaseResources()
     {
@@ -95,6 +108,15 @@ class Buffer
     {
         return size;
     }
+    /// Offset of this buffer's data within getVulkanBuffer(). Only non-zero for views.
+    const vk::DeviceSize &getRangeOffset() const
+    {
+        return m_rangeOffset;
+    }
+    bool isView() const
+    {
+        return m_isView;
+    }
 
   protected:
     std::shared_ptr<Resources> resources;
@@ -104,6 +126,8 @@ class Buffer
     uint32_t instanceCount;
     uint32_t m_alignmentSize;
     vk::BufferUsageFlags usageFlags;
+    vk::DeviceSize m_rangeOffset = 0;
+    bool m_isView = false;
 
     static std::shared_ptr<StarBuffers::Resources> CreateBuffer(VmaAllocator &allocator,
                                                                 const VmaAllocationCreateInfo &allocCreateInfo,
@@ -8,6 +8,8 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace star
@@ -67,12 +69,48 @@ class StarCommandBuffer
 
     void reset(int bufferIndex);
 
+    /// Tag the commands just recorded into the buffer with the state they were recorded from, so that a later frame
+    /// with the same state can submit them again through reuse. The state is opaque to the buffer, a hash and the
+    /// bytes it was computed from. Cleared by the next begin or reset.
+    /// Only valid for buffers not begun with vk::CommandBufferUsageFlagBits::eOneTimeSubmit.
+    void setRecordedState(const size_t &bufferIndex, const size_t &hash, std::string bytes)
+    {
+        m_recordedStates.at(bufferIndex) = RecordedState{.hash = hash, .bytes = std::move(bytes)};
+    }
+
+    /// Whether the buffer still holds the commands recorded for the state. The hashes reject most changed states
+    /// without comparing the bytes.
+    bool isRecordedWithState(const size_t &bufferIndex, const size_t &hash, std::string_view bytes) const
+    {
+        const auto &recorded = m_recordedStates.at(bufferIndex);
+        return recorded.has_value() && recorded->hash == hash && recorded->bytes == bytes;
+    }
+
+    /// Prepare the previously recorded commands of the buffer to be submitted again. Waits for the last submission in
+    /// place of begin.
+    void reuse(const int &bufferIndex);
+
     void submit(int bufferIndex, vk::Queue &targetQueue,
                 std::vector<std::pair<vk::Semaphore, vk::PipelineStageFlags>> *additionalWaits = nullptr,
                 std::vector<std::optional<uint64_t>> *additionalWaitsSignaledValues = nullptr,
                 vk::Fence *additionalFences = nullptr,
                 std::vector<vk::Semaphore> *additionalSignalSemaphores = nullptr);
 
+    /// Append the waits and signals submit() would use for the buffer, for callers which combine the submissions of
+    /// several buffers into a single call to the queue
+    void appendSubmitInfo(const int &bufferIndex,
+                          const std::vector<std::pair<vk::Semaphore, vk::PipelineStageFlags>> *additionalWaits,
+                          const std::vector<std::optional<uint64_t>> *additionalWaitsSignaledValues,
+                          std::vector<vk::SemaphoreSubmitInfo> &waits,
+                          std::vector<vk::SemaphoreSubmitInfo> &signals) const;
+
+    /// The buffer was submitted with a fence it does not own, which is waited on in place of its own fence until the
+    /// owner releases it
+    void setSubmissionFence(const int &bufferIndex, const vk::Fence &fence);
+
+    /// Called by the owner of a fence passed to setSubmissionFence once it has completed, before the fence is reused
+    void releaseSubmissionFence(const int &bufferIndex, const vk::Fence &fence);
+
     bool isFenceReady(const int &bufferIndex);
 
     /// <summary>
@@ -99,6 +137,10 @@ class StarCommandBuffer
 
     void wait(int bufferIndex = 0);
 
+    /// Block until the last submission of the buffer has completed without resetting its fence. Returns immediately if
+    /// the fence was reset by begin and the buffer has not been submitted since.
+    void waitForLastSubmission(const int &bufferIndex);
+
     void prepRender(vk::Device vulkanDevice, const StarCommandPool *parentPool, int numBuffersToCreate, bool initFences,
                     bool initSemaphores);
 
@@ -113,10 +155,21 @@ class StarCommandBuffer
     }
 
   protected:
+    struct RecordedState
+    {
+        size_t hash = 0;
+        std::string bytes;
+    };
+
     std::vector<vk::CommandBuffer> commandBuffers;
     std::vector<vk::Semaphore> completeSemaphores;
     std::vector<vk::Fence> readyFence;
+    std::vector<bool> m_isFenceAwaitingSubmit;
     std::vector<std::vector<std::pair<vk::Semaphore, vk::PipelineStageFlags>>> waitSemaphores;
+    std::vector<std::optional<RecordedState>> m_recordedStates;
+    /// Set when the last submission did not signal the ready fence. Holds the fence it did signal, or null once that
+    /// fence has been released.
+    std::vector<std::optional<vk::Fence>> m_submissionFences;
 
     vk::Device vulkanDevice{VK_NULL_HANDLE};
     const StarCommandPool *parentPool = nullptr;
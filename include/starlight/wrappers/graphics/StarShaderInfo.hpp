@@ -104,6 +104,12 @@ class StarShaderInfo
             return this->isBuilt;
         }
 
+        /// Number of times the descriptor set has been written, the handle stays the same across writes
+        size_t getNumWrites() const
+        {
+            return this->m_numWrites;
+        }
+
       private:
         core::device::StarDevice &device;
         StarDescriptorPool &m_pool;
@@ -111,6 +117,7 @@ class StarShaderInfo
         std::vector<size_t> m_pendingBuildIndices;
         bool setNeedsRebuild = true;
         bool isBuilt = false;
+        size_t m_numWrites = 0;
         std::shared_ptr<vk::DescriptorSet> descriptorSet = std::shared_ptr<vk::DescriptorSet>();
         std::shared_ptr<StarDescriptorWriter> descriptorWriter = std::shared_ptr<StarDescriptorWriter>();
 
@@ -190,6 +197,9 @@ class StarShaderInfo
 
     std::vector<vk::DescriptorSet> getDescriptors(uint8_t frameInFlight);
 
+    /// Total writes to the sets of a frame in flight, changes whenever getDescriptors updated a set in place
+    size_t getNumWrites(uint8_t frameInFlight) const;
+
     void cleanupRender(core::device::StarDevice &device);
 
     std::vector<std::vector<std::shared_ptr<ShaderInfoSet>>> &getShaderInfoSets()
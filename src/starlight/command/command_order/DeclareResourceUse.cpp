@@ -0,0 +1 @@
+#include "starlight/command/command_order/DeclareResourceUse.hpp"
\ No newline at end of file
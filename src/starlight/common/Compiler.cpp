@@ -1,9 +1,12 @@
 #include "Compiler.hpp"
 
+#include "ShaderCache.hpp"
 #include "core/graphics/shader/BasicIncluder.hpp"
 #include "logging/LoggingFactory.hpp"
 #include "starlight/core/Exceptions.hpp"
 
+#include <spirv-tools/optimizer.hpp>
+
 namespace star
 {
 
@@ -13,16 +16,34 @@ bool Compiler::compileDebug = false;
 bool Compiler::compileDebug = true;
 #endif
 
-std::vector<uint32_t> Compiler::compile(const std::string &pathToFile, bool optimize)
+// bump when the passes run by runOptimizerPasses change, so cached code from the old pipeline is not reused
+static constexpr std::string_view OptimizerPipelineVersion = "1";
+
+std::vector<uint32_t> Compiler::compile(const std::string &pathToFile, const Shader_Optimization &optimization)
+{
+    return compilePreprocessed(pathToFile, preprocess(pathToFile), optimization);
+}
+
+std::string Compiler::preprocess(const std::string &pathToFile)
 {
     shaderc::Compiler shaderCompiler;
-    shaderc::CompileOptions compilerOptions = getCompileOptions(pathToFile);
+    shaderc::CompileOptions compilerOptions = getCompileOptions(pathToFile, Shader_Optimization::none);
 
     auto stageC = getShaderCStageFlag(pathToFile);
     auto name = file_helpers::GetFullPath(pathToFile);
     auto fileCode = file_helpers::ReadFile(pathToFile, true);
 
-    std::string preprocessed = preprocessShader(shaderCompiler, compilerOptions, name, stageC, fileCode.c_str());
+    return preprocessShader(shaderCompiler, compilerOptions, name, stageC, fileCode.c_str());
+}
+
+std::vector<uint32_t> Compiler::compilePreprocessed(const std::string &pathToFile, const std::string &preprocessed,
+                                                    const Shader_Optimization &optimization)
+{
+    shaderc::Compiler shaderCompiler;
+    shaderc::CompileOptions compilerOptions = getCompileOptions(pathToFile, optimization);
+
+    auto stageC = getShaderCStageFlag(pathToFile);
+    auto name = file_helpers::GetFullPath(pathToFile);
 
     shaderc::SpvCompilationResult compileResult =
         shaderCompiler.CompileGlslToSpv(preprocessed.c_str(), stageC, name.c_str(), compilerOptions);
@@ -33,7 +54,78 @@ std::vector<uint32_t> Compiler::compile(const std::string &pathToFile, bool opti
         oss << "Failed to compile shader with error: " << compileResult.GetErrorMessage() << std::endl;
         STAR_THROW(oss.str());
     }
-    return std::vector<uint32_t>{compileResult.cbegin(), compileResult.cend()};
+
+    auto code = std::vector<uint32_t>{compileResult.cbegin(), compileResult.cend()};
+    const size_t compiledSize = code.size() * sizeof(uint32_t);
+
+    if (optimization == Shader_Optimization::full)
+    {
+        runOptimizerPasses(name, code);
+
+        std::ostringstream oss;
+        oss << "Compiled " << name << ": " << compiledSize << " bytes of SPIR-V, " << code.size() * sizeof(uint32_t)
+            << " bytes after spirv-opt";
+        core::logging::info(oss.str());
+    }
+    else
+    {
+        std::ostringstream oss;
+        oss << "Compiled " << name << ": " << compiledSize << " bytes of SPIR-V";
+        core::logging::info(oss.str());
+    }
+
+    return code;
+}
+
+void Compiler::runOptimizerPasses(const std::string &sourceName, std::vector<uint32_t> &code)
+{
+    spvtools::Optimizer optimizer(SPV_ENV_VULKAN_1_3);
+    optimizer.SetMessageConsumer(
+        [&sourceName](spv_message_level_t level, const char *, const spv_position_t &position, const char *message) {
+            if (level <= SPV_MSG_ERROR)
+            {
+                std::ostringstream oss;
+                oss << "spirv-opt " << sourceName << " at " << position.index << ": " << message;
+                core::logging::warning(oss.str());
+            }
+        });
+
+    // inline everything so constants reach their uses, fold them, then remove whatever is left unused
+    optimizer.RegisterPass(spvtools::CreateStripDebugInfoPass())
+        .RegisterPass(spvtools::CreateMergeReturnPass())
+        .RegisterPass(spvtools::CreateInlineExhaustivePass())
+        .RegisterPass(spvtools::CreateEliminateDeadFunctionsPass())
+        .RegisterPass(spvtools::CreateLocalSingleStoreElimPass())
+        .RegisterPass(spvtools::CreateScalarReplacementPass())
+        .RegisterPass(spvtools::CreateCCPPass())
+        .RegisterPass(spvtools::CreateFoldSpecConstantOpAndCompositePass())
+        .RegisterPass(spvtools::CreateDeadBranchElimPass())
+        .RegisterPass(spvtools::CreateAggressiveDCEPass())
+        .RegisterPass(spvtools::CreateCFGCleanupPass())
+        .RegisterPass(spvtools::CreateEliminateDeadConstantPass())
+        .RegisterPass(spvtools::CreateCompactIdsPass());
+
+    std::vector<uint32_t> optimized;
+    if (!optimizer.Run(code.data(), code.size(), &optimized))
+    {
+        core::logging::warning("spirv-opt failed for " + sourceName + ", using the code from shaderc");
+        return;
+    }
+
+    code = std::move(optimized);
+}
+
+std::string Compiler::getCacheKey(const std::string &pathToFile, const std::string &preprocessed,
+                                  const Shader_Optimization &optimization) const
+{
+    const std::string stage = std::to_string(static_cast<int>(getShaderCStageFlag(pathToFile)));
+    const std::string environment = std::to_string(static_cast<int>(TargetEnvironmentVersion));
+    const std::string spirv = std::to_string(static_cast<int>(TargetSpirvVersion));
+
+    const std::string optimizationLevel = std::to_string(static_cast<int>(optimization));
+
+    return ShaderCache::CreateKey({preprocessed, m_precompilerMacros, stage, environment, spirv,
+                                   compileDebug ? "debug" : "release", optimizationLevel, OptimizerPipelineVersion});
 }
 
 shaderc_shader_kind Compiler::getShaderCStageFlag(const std::string &pathToFile)
@@ -80,18 +172,23 @@ std::string Compiler::preprocessShader(shaderc::Compiler &compiler, shaderc::Com
     return {result.cbegin(), result.cend()};
 }
 
-shaderc::CompileOptions Compiler::getCompileOptions(const std::string &filePath)
+shaderc::CompileOptions Compiler::getCompileOptions(const std::string &filePath,
+                                                    const Shader_Optimization &optimization)
 {
     shaderc::CompileOptions options;
 
-    options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
-    options.SetTargetSpirv(shaderc_spirv_version_1_6);
+    options.SetTargetEnvironment(shaderc_target_env_vulkan, TargetEnvironmentVersion);
+    options.SetTargetSpirv(TargetSpirvVersion);
     if (!m_precompilerMacros.empty())
     {
         options.AddMacroDefinition(m_precompilerMacros);
     }
 
-    if (compileDebug)
+    options.SetOptimizationLevel(optimization == Shader_Optimization::none ? shaderc_optimization_level_zero
+                                                                           : shaderc_optimization_level_performance);
+
+    // spirv-opt strips the debug info again, generating it would only slow the compile
+    if (compileDebug && optimization != Shader_Optimization::full)
         options.SetGenerateDebugInfo();
 
     std::filesystem::path parent;
@@ -34,7 +34,16 @@ std::map<std::string, star::Config_Settings> star::ConfigFile::availableSettings
     std::make_pair("transfer_standard_priority_queue_size",
                    star::Config_Settings::transfer_standard_priority_queue_size),
     std::make_pair("transfer_standard_priority_worker_count",
-                   star::Config_Settings::transfer_standard_priority_worker_count)};
+                   star::Config_Settings::transfer_standard_priority_worker_count),
+    std::make_pair("transfer_staging_ring_size_mb", star::Config_Settings::transfer_staging_ring_size_mb),
+    std::make_pair("transfer_batch_max_requests", star::Config_Settings::transfer_batch_max_requests),
+    std::make_pair("transfer_batch_max_kb", star::Config_Settings::transfer_batch_max_kb),
+    std::make_pair("transfer_batch_latency_cap_us", star::Config_Settings::transfer_batch_latency_cap_us),
+    std::make_pair("shader_cache_dir", star::Config_Settings::shader_cache_directory),
+    std::make_pair("shader_cache_max_mb", star::Config_Settings::shader_cache_max_mb),
+    std::make_pair("shader_compile_worker_count", star::Config_Settings::shader_compile_worker_count),
+    std::make_pair("pipeline_build_worker_count", star::Config_Settings::pipeline_build_worker_count),
+    std::make_pair("gpu_culling_validation", star::Config_Settings::gpu_culling_validation)};
 
 void star::ConfigFile::load(const std::filesystem::path &configPath)
 {
@@ -119,6 +128,37 @@ void star::ConfigFile::applyDefaults(std::map<std::string, std::string> values)
             case Config_Settings::transfer_standard_priority_worker_count:
                 settings[configKey] = "0";
                 break;
+            case Config_Settings::transfer_staging_ring_size_mb:
+                settings[configKey] = "16";
+                break;
+            case Config_Settings::transfer_batch_max_requests:
+                settings[configKey] = "8";
+                break;
+            case Config_Settings::transfer_batch_max_kb:
+                settings[configKey] = "8192";
+                break;
+            case Config_Settings::transfer_batch_latency_cap_us:
+                settings[configKey] = "50";
+                break;
+            case Config_Settings::shader_cache_directory:
+                // resolved against tmp_dir when used
+                settings[configKey] = "";
+                break;
+            case Config_Settings::shader_cache_max_mb:
+                settings[configKey] = "256";
+                break;
+            case Config_Settings::shader_compile_worker_count:
+                // one for each executor thread
+                settings[configKey] = "0";
+                break;
+            case Config_Settings::pipeline_build_worker_count:
+                // one for each executor thread
+                settings[configKey] = "0";
+                break;
+            case Config_Settings::gpu_culling_validation:
+                // compares the culled counts against the CPU each frame, only meant for debugging
+                settings[configKey] = "0";
+                break;
             default:
                 STAR_THROW("Setting not found and has no available default: " + jsonKey);
             }
@@ -182,6 +222,33 @@ std::string star::ConfigFile::getSetting(Config_Settings setting)
     case (Config_Settings::transfer_standard_priority_worker_count):
         name = "transfer_standard_priority_worker_count";
         break;
+    case (Config_Settings::transfer_staging_ring_size_mb):
+        name = "transfer_staging_ring_size_mb";
+        break;
+    case (Config_Settings::transfer_batch_max_requests):
+        name = "transfer_batch_max_requests";
+        break;
+    case (Config_Settings::transfer_batch_max_kb):
+        name = "transfer_batch_max_kb";
+        break;
+    case (Config_Settings::transfer_batch_latency_cap_us):
+        name = "transfer_batch_latency_cap_us";
+        break;
+    case (Config_Settings::shader_cache_directory):
+        name = "shader_cache_dir";
+        break;
+    case (Config_Settings::shader_cache_max_mb):
+        name = "shader_cache_max_mb";
+        break;
+    case (Config_Settings::shader_compile_worker_count):
+        name = "shader_compile_worker_count";
+        break;
+    case (Config_Settings::pipeline_build_worker_count):
+        name = "pipeline_build_worker_count";
+        break;
+    case (Config_Settings::gpu_culling_validation):
+        name = "gpu_culling_validation";
+        break;
     default:
         name = "UNKNOWN";
         break;
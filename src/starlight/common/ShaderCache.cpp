@@ -0,0 +1,254 @@
+#include "ShaderCache.hpp"
+
+#include "common/ConfigFile.hpp"
+#include "common/helpers/FileHelpers.hpp"
+#include "logging/LoggingFactory.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace star
+{
+namespace
+{
+constexpr uint32_t EntryMagic = 0x56505353; // SSPV
+constexpr uint32_t EntryVersion = 1;
+constexpr uint32_t SpirvMagic = 0x07230203;
+constexpr std::string_view EntryExtension = ".spv";
+
+struct EntryHeader
+{
+    uint32_t magic = EntryMagic;
+    uint32_t version = EntryVersion;
+    uint64_t numWords = 0;
+};
+
+uint64_t Mix(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
+std::filesystem::path GetDefaultDirectory()
+{
+    const std::string configured = ConfigFile::getString(Config_Settings::shader_cache_directory, "");
+    if (!configured.empty())
+    {
+        return configured;
+    }
+
+    const auto fallback = file_helpers::GetExecutableDirectory() / "tmp";
+    const std::filesystem::path tmp = ConfigFile::getString(Config_Settings::tmp_directory, fallback.string());
+    return tmp / "shader_cache";
+}
+} // namespace
+
+ShaderCache::ShaderCache(std::filesystem::path directory, const uintmax_t &maxSizeBytes)
+    : m_directory(std::move(directory)), m_maxSizeBytes(maxSizeBytes)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+    {
+        core::logging::warning("Shader cache is disabled, failed to create directory " + m_directory.string() + ": " +
+                               error.message());
+        m_maxSizeBytes = 0;
+    }
+}
+
+ShaderCache &ShaderCache::Default()
+{
+    static ShaderCache cache(GetDefaultDirectory(),
+                             static_cast<uintmax_t>(ConfigFile::getUint32(Config_Settings::shader_cache_max_mb, 256)) *
+                                 1024 * 1024);
+
+    return cache;
+}
+
+std::string ShaderCache::CreateKey(const std::vector<std::string_view> &parts)
+{
+    // two unrelated 64 bit hashes, a collision would hand back code for another shader
+    uint64_t fnv = 0xcbf29ce484222325ull;
+    uint64_t mixed = 0x9e3779b97f4a7c15ull;
+    const auto addByte = [&](const unsigned char &byte) {
+        fnv = (fnv ^ byte) * 0x100000001b3ull;
+        mixed = Mix(mixed ^ (static_cast<uint64_t>(byte) << ((mixed & 0x7) * 8)));
+    };
+
+    for (const auto &part : parts)
+    {
+        // the length separates the parts so that moving text from one part into the next changes the key
+        const uint64_t length = part.size();
+        for (size_t i = 0; i < sizeof(length); i++)
+        {
+            addByte(static_cast<unsigned char>(length >> (i * 8)));
+        }
+        for (const char &c : part)
+        {
+            addByte(static_cast<unsigned char>(c));
+        }
+    }
+
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0') << std::setw(16) << fnv << std::setw(16) << mixed;
+    return oss.str();
+}
+
+std::optional<std::vector<uint32_t>> ShaderCache::load(const std::string &key) const
+{
+    if (!isEnabled())
+    {
+        return std::nullopt;
+    }
+
+    const auto path = getEntryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    EntryHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != EntryMagic ||
+        header.version != EntryVersion || header.numWords == 0)
+    {
+        core::logging::warning("Ignoring unreadable shader cache entry: " + path.string());
+        return std::nullopt;
+    }
+
+    std::error_code error;
+    const uintmax_t expectedSize = sizeof(EntryHeader) + header.numWords * sizeof(uint32_t);
+    if (std::filesystem::file_size(path, error) != expectedSize || error)
+    {
+        core::logging::warning("Ignoring truncated shader cache entry: " + path.string());
+        return std::nullopt;
+    }
+
+    std::vector<uint32_t> code(header.numWords);
+    if (!file.read(reinterpret_cast<char *>(code.data()), code.size() * sizeof(uint32_t)) ||
+        code.front() != SpirvMagic)
+    {
+        core::logging::warning("Ignoring corrupt shader cache entry: " + path.string());
+        return std::nullopt;
+    }
+
+    // eviction removes the entries used longest ago, so a hit counts as a use
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+
+    return code;
+}
+
+void ShaderCache::store(const std::string &key, const std::vector<uint32_t> &code)
+{
+    if (!isEnabled() || code.empty())
+    {
+        return;
+    }
+
+    const auto path = getEntryPath(key);
+
+    // every writer has its own temporary file, readers only ever see a complete entry once it is renamed into place
+    std::filesystem::path tmpPath;
+    {
+        thread_local std::mt19937_64 generator{std::random_device{}()};
+        std::ostringstream oss;
+        oss << key << "." << std::hex << generator() << ".tmp";
+        tmpPath = m_directory / oss.str();
+    }
+
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        const EntryHeader header{.numWords = code.size()};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(code.data()), code.size() * sizeof(uint32_t));
+        file.close();
+
+        if (file.fail())
+        {
+            core::logging::warning("Failed to write shader cache entry: " + tmpPath.string());
+            std::error_code error;
+            std::filesystem::remove(tmpPath, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmpPath, path, error);
+    if (error)
+    {
+        // another process may have stored the same entry first, which is just as good
+        std::filesystem::remove(tmpPath, error);
+        return;
+    }
+
+    evict();
+}
+
+std::filesystem::path ShaderCache::getEntryPath(const std::string &key) const
+{
+    return m_directory / (key + std::string(EntryExtension));
+}
+
+void ShaderCache::evict()
+{
+    std::lock_guard<std::mutex> lock(m_evictionMutex);
+
+    struct Entry
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUse;
+        uintmax_t size = 0;
+    };
+
+    std::vector<Entry> entries;
+    uintmax_t totalSize = 0;
+
+    std::error_code error;
+    for (const auto &file : std::filesystem::directory_iterator(m_directory, error))
+    {
+        if (!file.is_regular_file(error) || file.path().extension() != EntryExtension)
+        {
+            continue;
+        }
+
+        Entry entry{.path = file.path(), .lastUse = file.last_write_time(error), .size = file.file_size(error)};
+        if (error)
+        {
+            // removed by another process in the meantime
+            error.clear();
+            continue;
+        }
+        totalSize += entry.size;
+        entries.push_back(std::move(entry));
+    }
+
+    if (totalSize <= m_maxSizeBytes)
+    {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+    for (const auto &entry : entries)
+    {
+        if (totalSize <= m_maxSizeBytes)
+        {
+            break;
+        }
+
+        std::filesystem::remove(entry.path, error);
+        totalSize -= entry.size;
+    }
+}
+} // namespace star
@@ -3,20 +3,14 @@
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::GlobalInfo::createStagingBuffer(
     vk::Device &device, VmaAllocator &allocator) const
 {
-    return StarBuffers::Buffer::Builder(allocator)
-        .setAllocationCreateInfo(
-            Allocator::AllocationBuilder()
-                .setFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT)
-                .setUsage(VMA_MEMORY_USAGE_AUTO)
-                .build(),
-            vk::BufferCreateInfo()
-                .setSharingMode(vk::SharingMode::eExclusive)
-                .setSize(sizeof(GlobalUniformBufferObject))
-                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
-            "GlobalInfo_TransferSRC")
-        .setInstanceCount(1)
-        .setInstanceSize(sizeof(GlobalUniformBufferObject))
-        .buildUnique();
+    return CreateStagingBuffer(allocator, getStagingLayout().value(), "GlobalInfo_TransferSRC");
+}
+
+std::optional<star::TransferRequest::StagingLayout> star::TransferRequest::GlobalInfo::getStagingLayout() const
+{
+    return StagingLayout{.size = sizeof(GlobalUniformBufferObject),
+                         .instanceCount = 1,
+                         .instanceSize = sizeof(GlobalUniformBufferObject)};
 }
 
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::GlobalInfo::createFinal(
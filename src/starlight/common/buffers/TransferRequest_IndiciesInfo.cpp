@@ -2,26 +2,20 @@
 
 #include <star_common/helper/CastHelpers.hpp>
 
+#include <cassert>
+#include <limits>
+
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::IndicesInfo::createStagingBuffer(vk::Device &device,
                                                                                           VmaAllocator &allocator) const
 {
-    uint32_t numIndices = 0; 
-    star::common::casts::SafeCast<size_t, uint32_t>(this->indices.size(), numIndices); 
+    return CreateStagingBuffer(allocator, getStagingLayout().value(), "IndicesInfoBuffer_Src");
+}
 
-    return StarBuffers::Buffer::Builder(allocator)
-        .setAllocationCreateInfo(
-            Allocator::AllocationBuilder()
-                .setFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT)
-                .setUsage(VMA_MEMORY_USAGE_AUTO)
-                .build(),
-            vk::BufferCreateInfo()
-                .setSharingMode(vk::SharingMode::eExclusive)
-                .setSize(sizeof(uint32_t) * star::common::casts::size_t_to_unsigned_int(this->indices.size()))
-                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
-            "IndicesInfoBuffer_Src")
-        .setInstanceCount(star::common::casts::size_t_to_unsigned_int(this->indices.size()))
-        .setInstanceSize(sizeof(uint32_t))
-        .buildUnique();
+std::optional<star::TransferRequest::StagingLayout> star::TransferRequest::IndicesInfo::getStagingLayout() const
+{
+    return StagingLayout{.size = getIndexSize() * this->indices.size(),
+                         .instanceCount = star::common::casts::size_t_to_unsigned_int(this->indices.size()),
+                         .instanceSize = getIndexSize()};
 }
 
 void star::TransferRequest::IndicesInfo::writeDataToStageBuffer(StarBuffers::Buffer &buffer) const
@@ -29,9 +23,22 @@ void star::TransferRequest::IndicesInfo::writeDataToStageBuffer(StarBuffers::Buf
     void *mapped = nullptr;
     buffer.map(&mapped);
 
-    vk::DeviceSize indSize = sizeof(uint32_t) * this->indices.size();
-    std::vector<uint32_t> cpInd{this->indices};
-    buffer.writeToBuffer(cpInd.data(), mapped, indSize);
+    vk::DeviceSize indSize = getIndexSize() * this->indices.size();
+    if (compactIndices)
+    {
+        std::vector<uint16_t> cpInd(this->indices.size());
+        for (size_t i = 0; i < this->indices.size(); i++)
+        {
+            assert(this->indices[i] <= std::numeric_limits<uint16_t>::max() && "Index does not fit in 16 bits");
+            cpInd[i] = static_cast<uint16_t>(this->indices[i]);
+        }
+        buffer.writeToBuffer(cpInd.data(), mapped, indSize);
+    }
+    else
+    {
+        std::vector<uint32_t> cpInd{this->indices};
+        buffer.writeToBuffer(cpInd.data(), mapped, indSize);
+    }
 
     buffer.unmap();
 }
@@ -58,10 +65,10 @@ std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::IndicesInfo::c
                 .setSharingMode(vk::SharingMode::eConcurrent)
                 .setQueueFamilyIndexCount(indices.size())
                 .setPQueueFamilyIndices(indices.data())
-                .setSize(sizeof(uint32_t) * star::common::casts::size_t_to_unsigned_int(this->indices.size()))
+                .setSize(getIndexSize() * star::common::casts::size_t_to_unsigned_int(this->indices.size()))
                 .setUsage(vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer),
             "IndicesInfoBuffer_Src")
         .setInstanceCount(star::common::casts::size_t_to_unsigned_int(this->indices.size()))
-        .setInstanceSize(sizeof(uint32_t))
+        .setInstanceSize(getIndexSize())
         .buildUnique();
 }
@@ -18,23 +18,15 @@ static vk::DeviceSize GetMemorySize(const std::vector<Color> colors)
 
 std::unique_ptr<StarBuffers::Buffer> star::TransferRequest::InstanceColorInfo::createStagingBuffer(
     vk::Device &device, VmaAllocator &allocator) const
+{
+    return CreateStagingBuffer(allocator, getStagingLayout().value(), "InstanceColorInfo_src");
+}
+
+std::optional<star::TransferRequest::StagingLayout> star::TransferRequest::InstanceColorInfo::getStagingLayout() const
 {
     const vk::DeviceSize bSize = GetMemorySize(m_colors);
 
-    return StarBuffers::Buffer::Builder(allocator)
-        .setAllocationCreateInfo(
-            Allocator::AllocationBuilder()
-                .setFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT)
-                .setUsage(VMA_MEMORY_USAGE_AUTO)
-                .build(),
-            vk::BufferCreateInfo()
-                .setSharingMode(vk::SharingMode::eExclusive)
-                .setSize(bSize)
-                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
-            "InstanceColorInfo_src")
-        .setInstanceCount(1)
-        .setInstanceSize(bSize)
-        .buildUnique();
+    return StagingLayout{.size = bSize, .instanceCount = 1, .instanceSize = bSize};
 }
 
 std::unique_ptr<StarBuffers::Buffer> star::TransferRequest::InstanceColorInfo::createFinal(
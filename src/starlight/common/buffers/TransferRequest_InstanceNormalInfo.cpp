@@ -5,24 +5,15 @@
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::InstanceNormalInfo::createStagingBuffer(
     vk::Device &device, VmaAllocator &allocator) const
 {
-    const vk::DeviceSize alignmentSize =
-        StarBuffers::Buffer::GetAlignment(sizeof(glm::mat4), this->minUniformBufferOffsetAlignment);
+    return CreateStagingBuffer(allocator, getStagingLayout().value(), "InstanceNormalInfo_SRC");
+}
 
-    return StarBuffers::Buffer::Builder(allocator)
-        .setAllocationCreateInfo(
-            Allocator::AllocationBuilder()
-                .setFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT)
-                .setUsage(VMA_MEMORY_USAGE_AUTO)
-                .build(),
-            vk::BufferCreateInfo()
-                .setSharingMode(vk::SharingMode::eExclusive)
-                .setSize(star::common::casts::size_t_to_unsigned_int(this->normalMatrixInfo.size() * alignmentSize))
-                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
-            "InstanceNormalInfo_SRC")
-        .setInstanceCount(star::common::casts::size_t_to_unsigned_int(this->normalMatrixInfo.size()))
-        .setInstanceSize(sizeof(glm::mat4))
-        .setMinOffsetAlignment(this->minUniformBufferOffsetAlignment)
-        .buildUnique();
+std::optional<star::TransferRequest::StagingLayout> star::TransferRequest::InstanceNormalInfo::getStagingLayout() const
+{
+    // only the dirty slots are staged, packed together
+    return StagingLayout{.size = this->normalMatrixInfo.size() * sizeof(glm::mat3x4),
+                         .instanceCount = star::common::casts::size_t_to_unsigned_int(this->normalMatrixInfo.size()),
+                         .instanceSize = sizeof(glm::mat3x4)};
 }
 
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::InstanceNormalInfo::createFinal(
@@ -34,9 +25,6 @@ std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::InstanceNormal
     for (const auto &queueFamilyIndex : transferQueueFamilyIndex)
         indices.push_back(queueFamilyIndex);
 
-    const vk::DeviceSize alignmentSize =
-        StarBuffers::Buffer::GetAlignment(sizeof(glm::mat4), this->minUniformBufferOffsetAlignment);
-
     return StarBuffers::Buffer::Builder(allocator)
         .setAllocationCreateInfo(
             Allocator::AllocationBuilder()
@@ -47,12 +35,11 @@ std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::InstanceNormal
                 .setSharingMode(vk::SharingMode::eConcurrent)
                 .setQueueFamilyIndexCount(static_cast<uint32_t>(indices.size()))
                 .setQueueFamilyIndices(indices)
-                .setSize(star::common::casts::size_t_to_unsigned_int(this->normalMatrixInfo.size() * alignmentSize))
-                .setUsage(vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eUniformBuffer),
+                .setSize(m_numSlots * sizeof(glm::mat3x4))
+                .setUsage(vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eStorageBuffer),
             "InstanceNormalInfo")
-        .setInstanceCount(star::common::casts::size_t_to_unsigned_int(this->normalMatrixInfo.size()))
-        .setInstanceSize(sizeof(glm::mat4))
-        .setMinOffsetAlignment(this->minUniformBufferOffsetAlignment)
+        .setInstanceCount(star::common::casts::size_t_to_unsigned_int(m_numSlots))
+        .setInstanceSize(sizeof(glm::mat3x4))
         .buildUnique();
 }
 
@@ -61,11 +48,42 @@ void star::TransferRequest::InstanceNormalInfo::writeDataToStageBuffer(star::Sta
     void *mapped = nullptr;
     buffer.map(&mapped);
 
-    for (size_t i = 0; i < this->normalMatrixInfo.size(); i++)
+    // staging memory holds the dirty slots packed together, a host written destination holds every slot and
+    // receives each dirty matrix at its final position
+    const bool isPacked = buffer.getInstanceCount() < m_numSlots;
+
+    size_t packedIndex = 0;
+    for (const auto &range : m_dirtyRanges)
     {
-        glm::mat4 inverseTranspose = glm::inverse(glm::transpose(this->normalMatrixInfo[i]));
-        buffer.writeToIndex(&inverseTranspose, mapped, i);
+        for (size_t i = range.first; i < range.end(); i++)
+        {
+            // std430 pads each column of a mat3 to a vec4, which is exactly the layout of a mat3x4
+            glm::mat3x4 inverseTranspose =
+                glm::mat3x4(glm::inverse(glm::transpose(glm::mat3(this->normalMatrixInfo[packedIndex]))));
+            buffer.writeToIndex(&inverseTranspose, mapped, isPacked ? packedIndex : i);
+            packedIndex++;
+        }
     }
 
     buffer.unmap();
-}
\ No newline at end of file
+}
+
+void star::TransferRequest::InstanceNormalInfo::copyFromTransferSRCToDST(StarBuffers::Buffer &srcBuffer,
+                                                                         StarBuffers::Buffer &dstBuffer,
+                                                                         vk::CommandBuffer &commandBuffer) const
+{
+    std::vector<vk::BufferCopy> regions;
+    regions.reserve(m_dirtyRanges.size());
+    vk::DeviceSize srcOffset = srcBuffer.getRangeOffset();
+    for (const auto &range : m_dirtyRanges)
+    {
+        regions.emplace_back(srcOffset, dstBuffer.getRangeOffset() + range.first * sizeof(glm::mat3x4),
+                             range.count * sizeof(glm::mat3x4));
+        srcOffset += range.count * sizeof(glm::mat3x4);
+    }
+
+    if (!regions.empty())
+    {
+        commandBuffer.copyBuffer(srcBuffer.getVulkanBuffer(), dstBuffer.getVulkanBuffer(), regions);
+    }
+}
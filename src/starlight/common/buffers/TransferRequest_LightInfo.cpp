@@ -5,20 +5,12 @@
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::LightInfo::createStagingBuffer(
     vk::Device &device, VmaAllocator &allocator) const
 {
-    return StarBuffers::Buffer::Builder(allocator)
-        .setAllocationCreateInfo(
-            Allocator::AllocationBuilder()
-                .setFlags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
-                .setUsage(VMA_MEMORY_USAGE_AUTO)
-                .build(),
-            vk::BufferCreateInfo()
-                .setSharingMode(vk::SharingMode::eExclusive)
-                .setSize(sizeof(int))
-                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
-            "LightList_Stage")
-        .setInstanceCount(star::common::casts::size_t_to_unsigned_int(1))
-        .setInstanceSize(sizeof(int))
-        .buildUnique();
+    return CreateStagingBuffer(allocator, getStagingLayout().value(), "LightList_Stage");
+}
+
+std::optional<star::TransferRequest::StagingLayout> star::TransferRequest::LightInfo::getStagingLayout() const
+{
+    return StagingLayout{.size = sizeof(int), .instanceCount = 1, .instanceSize = sizeof(int)};
 }
 
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::LightInfo::createFinal(
@@ -5,23 +5,14 @@
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::LightList::createStagingBuffer(
     vk::Device &device, VmaAllocator &allocator) const
 {
-    uint32_t numLights = 0;
-    star::common::casts::SafeCast<size_t, uint32_t>(myLights.size(), numLights);
+    return CreateStagingBuffer(allocator, getStagingLayout().value(), "LightList_Stage");
+}
 
-    return StarBuffers::Buffer::Builder(allocator)
-        .setAllocationCreateInfo(
-            Allocator::AllocationBuilder()
-                .setFlags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
-                .setUsage(VMA_MEMORY_USAGE_AUTO)
-                .build(),
-            vk::BufferCreateInfo()
-                .setSharingMode(vk::SharingMode::eExclusive)
-                .setSize(sizeof(LightBufferObject) * numLights)
-                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
-            "LightList_Stage")
-        .setInstanceCount(numLights)
-        .setInstanceSize(sizeof(LightBufferObject))
-        .buildUnique();
+std::optional<star::TransferRequest::StagingLayout> star::TransferRequest::LightList::getStagingLayout() const
+{
+    return StagingLayout{.size = sizeof(LightBufferObject) * myLights.size(),
+                         .instanceCount = star::common::casts::size_t_to_unsigned_int(myLights.size()),
+                         .instanceSize = sizeof(LightBufferObject)};
 }
 
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::LightList::createFinal(
@@ -1,5 +1,7 @@
 #include "TransferRequest_VertInfo.hpp"
 
+#include "VulkanVertex.hpp"
+
 #include <star_common/helper/CastHelpers.hpp>
 
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::VertInfo::createFinal(
@@ -24,36 +26,25 @@ std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::VertInfo::crea
                 .setSharingMode(vk::SharingMode::eConcurrent)
                 .setPQueueFamilyIndices(indices.data())
                 .setQueueFamilyIndexCount(numInds)
-                .setSize(sizeof(Vertex) * numVerts)
+                .setSize(VertexInputDescription::GetVertexBufferSize(layout, numVerts))
                 .setUsage(vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer),
             "VertexBuffer")
         .setInstanceCount(numVerts)
-        .setInstanceSize(sizeof(Vertex))
+        .setInstanceSize(layout == Vertex_Layout::compact ? sizeof(CompactVertex) : sizeof(Vertex))
         .buildUnique();
 }
 
 std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::VertInfo::createStagingBuffer(
     vk::Device &device, VmaAllocator &allocator) const
 {
-    uint32_t numVerts = 0; 
-    if (!star::common::casts::SafeCast<size_t, uint32_t>(this->vertices.size(), numVerts)){
-        throw std::runtime_error("Failed to cast numerical info for vert info creation"); 
-    } 
+    return CreateStagingBuffer(allocator, getStagingLayout().value(), "VertexBuffer_Stage");
+}
 
-    return StarBuffers::Buffer::Builder(allocator)
-        .setAllocationCreateInfo(
-            Allocator::AllocationBuilder()
-                .setFlags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
-                .setUsage(VMA_MEMORY_USAGE_AUTO)
-                .build(),
-            vk::BufferCreateInfo()
-                .setSharingMode(vk::SharingMode::eExclusive)
-                .setSize(sizeof(Vertex) * numVerts)
-                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
-            "VertexBuffer_Stage")
-        .setInstanceCount(numVerts)
-        .setInstanceSize(sizeof(Vertex))
-        .buildUnique();
+std::optional<star::TransferRequest::StagingLayout> star::TransferRequest::VertInfo::getStagingLayout() const
+{
+    return StagingLayout{.size = VertexInputDescription::GetVertexBufferSize(layout, vertices.size()),
+                         .instanceCount = star::common::casts::size_t_to_unsigned_int(vertices.size()),
+                         .instanceSize = layout == Vertex_Layout::compact ? sizeof(CompactVertex) : sizeof(Vertex)};
 }
 
 void star::TransferRequest::VertInfo::writeDataToStageBuffer(StarBuffers::Buffer &buffer) const
@@ -61,6 +52,13 @@ void star::TransferRequest::VertInfo::writeDataToStageBuffer(StarBuffers::Buffer
     void *mapped = nullptr;
     buffer.map(&mapped);
 
+    if (layout == Vertex_Layout::compact)
+    {
+        writeCompactVertices(buffer, mapped);
+        buffer.unmap();
+        return;
+    }
+
     for (size_t i{0}; i < vertices.size(); i++)
     {
         Vertex vert = Vertex(vertices[i]); 
@@ -69,4 +67,22 @@ void star::TransferRequest::VertInfo::writeDataToStageBuffer(StarBuffers::Buffer
     }
 
     buffer.unmap();
+}
+
+void star::TransferRequest::VertInfo::writeCompactVertices(StarBuffers::Buffer &buffer, void *mapped) const
+{
+    std::vector<CompactVertex> packed(vertices.size());
+    for (size_t i{0}; i < vertices.size(); i++)
+    {
+        packed[i] = CompactVertex::Pack(vertices[i]);
+    }
+
+    // material values are constant across a mesh, keep the ones from the first vertex
+    const VertexMaterialConstants material =
+        vertices.empty() ? VertexMaterialConstants() : VertexMaterialConstants::FromVertex(vertices.front());
+
+    const vk::DeviceSize vertSize = sizeof(CompactVertex) * packed.size();
+    buffer.writeToBuffer(packed.data(), mapped, vertSize);
+    buffer.writeToBuffer((void *)&material, mapped, sizeof(VertexMaterialConstants),
+                         VertexInputDescription::GetMaterialConstantsOffset(vertices.size()));
 }
\ No newline at end of file
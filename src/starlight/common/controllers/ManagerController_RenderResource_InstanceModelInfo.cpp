@@ -6,45 +6,43 @@
 #include <cassert>
 
 star::ManagerController::RenderResource::InstanceModelInfo::InstanceModelInfo(
-    std::vector<StarEntity> *instances)
-    : m_instances(std::move(instances))
+    std::vector<StarEntity> *instances, const std::vector<uint32_t> *visibleInstances)
+    : m_instances(std::move(instances)), m_visibleInstances(visibleInstances)
 {
-    assert(m_instances && "Instances must be provided before use");
+    assert(m_instances && m_visibleInstances && "Instances must be provided before use");
 }
 
 void star::ManagerController::RenderResource::InstanceModelInfo::prepRender(core::device::DeviceContext &context,
                                                                             const uint8_t &numFramesInFlight)
 {
-    m_needsUpdatedThisFrame.resize(numFramesInFlight, true);
+    m_slots.resize(numFramesInFlight);
 
     Buffer::prepRender(context, numFramesInFlight);
 }
 
 void star::ManagerController::RenderResource::InstanceModelInfo::setToUpdate()
 {
-    for (size_t i = 0; i < m_needsUpdatedThisFrame.size(); i++)
-    {
-        m_needsUpdatedThisFrame[i] = true;
-    }
+    m_slots.markAllDirty();
+}
+
+void star::ManagerController::RenderResource::InstanceModelInfo::setToUpdate(const size_t &instanceIndex)
+{
+    m_slots.markInstanceDirty(instanceIndex);
 }
 
 std::unique_ptr<star::TransferRequest::Buffer> star::ManagerController::RenderResource::InstanceModelInfo::
     createTransferRequest(star::core::device::DeviceContext &context, const uint8_t &frameInFlightIndex)
 {
-    m_needsUpdatedThisFrame[frameInFlightIndex] = false;
-
     return std::make_unique<TransferRequest::InstanceModelInfo>(
-        *m_instances,
+        *m_instances, *m_visibleInstances,
         core::helper::GetEngineDefaultQueue(context.getEventBus(), context.getGraphicsManagers().queueManager,
                                             star::Queue_Type::Tgraphics)
             ->getParentQueueFamilyIndex(),
-        context.getDevice().getPhysicalDevice().getProperties().limits.minUniformBufferOffsetAlignment);
+        m_slots.takeDirtySlots(frameInFlightIndex, *m_visibleInstances));
 }
 
 bool star::ManagerController::RenderResource::InstanceModelInfo::doesFrameInFlightDataNeedUpdated(
     const uint8_t &frameInFlightIndex) const
 {
-    assert(frameInFlightIndex < m_needsUpdatedThisFrame.size());
-
-    return m_needsUpdatedThisFrame[frameInFlightIndex];
+    return m_slots.needsUpload(frameInFlightIndex, *m_visibleInstances);
 }
@@ -5,16 +5,18 @@
 
 void star::ManagerController::RenderResource::InstanceNormalInfo::setForUpdate()
 {
-    for (size_t i = 0; i < m_needsUpdatedThisFrame.size(); i++)
-    {
-        m_needsUpdatedThisFrame[i] = true;
-    }
+    m_slots.markAllDirty();
+}
+
+void star::ManagerController::RenderResource::InstanceNormalInfo::setForUpdate(const size_t &instanceIndex)
+{
+    m_slots.markInstanceDirty(instanceIndex);
 }
 
 void star::ManagerController::RenderResource::InstanceNormalInfo::prepRender(core::device::DeviceContext &context,
                                                                              const uint8_t &numFramesInFlight)
 {
-    m_needsUpdatedThisFrame.resize(numFramesInFlight, true);
+    m_slots.resize(numFramesInFlight);
 
     Buffer::prepRender(context, numFramesInFlight);
 }
@@ -22,20 +24,18 @@ void star::ManagerController::RenderResource::InstanceNormalInfo::prepRender(cor
 std::unique_ptr<star::TransferRequest::Buffer> star::ManagerController::RenderResource::InstanceNormalInfo::
     createTransferRequest(star::core::device::DeviceContext &context, const uint8_t &frameInFlightIndex)
 {
-    assert(m_instances && "Instances must be provided before use");
-
-    m_needsUpdatedThisFrame[frameInFlightIndex] = false;
+    assert(m_instances && m_visibleInstances && "Instances must be provided before use");
 
     return std::make_unique<star::TransferRequest::InstanceNormalInfo>(
-        *m_instances,
+        *m_instances, *m_visibleInstances,
         core::helper::GetEngineDefaultQueue(context.getEventBus(), context.getGraphicsManagers().queueManager,
                                             star::Queue_Type::Tgraphics)
             ->getParentQueueFamilyIndex(),
-        context.getDevice().getPhysicalDevice().getProperties().limits.minUniformBufferOffsetAlignment);
+        m_slots.takeDirtySlots(frameInFlightIndex, *m_visibleInstances));
 }
 
 bool star::ManagerController::RenderResource::InstanceNormalInfo::doesFrameInFlightDataNeedUpdated(
     const uint8_t &frameInFlightIndex) const
 {
-    return m_needsUpdatedThisFrame[frameInFlightIndex];
+    return m_slots.needsUpload(frameInFlightIndex, *m_visibleInstances);
 }
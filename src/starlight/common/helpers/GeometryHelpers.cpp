@@ -1,86 +1,170 @@
 #include "GeometryHelpers.hpp"
 
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
+#include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
 
-#include <unordered_map>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
-void star::GeometryHelpers::packTriangleAdjacency(std::vector<Vertex> &verts, std::vector<uint32_t> &indices)
+namespace
 {
-    std::vector<uint32_t> neighborIndices;
+/// Key used for vertex welding, only the attributes that are sourced from the obj file are considered
+struct VertexWeldKey
+{
+    std::array<float, 11> values;
 
-    std::vector<uint32_t> uniqueIndicies;
-    std::unordered_map<glm::vec3, uint32_t> vertIndexMap;
-    std::vector<Vertex> finalizedVerts;
-    uint32_t uniqueIndexCount = 0;
+    explicit VertexWeldKey(const star::Vertex &vert)
+        : values{vert.pos.x,   vert.pos.y,   vert.pos.z,      vert.normal.x,   vert.normal.y, vert.normal.z,
+                 vert.color.x, vert.color.y, vert.color.z, vert.texCoord.x, vert.texCoord.y}
+    {
+    }
+
+    bool operator==(const VertexWeldKey &other) const
+    {
+        return std::memcmp(values.data(), other.values.data(), sizeof(float) * values.size()) == 0;
+    }
+
+    template <typename H> friend H AbslHashValue(H h, const VertexWeldKey &key)
+    {
+        return H::combine_contiguous(std::move(h), reinterpret_cast<const unsigned char *>(key.values.data()),
+                                     sizeof(float) * key.values.size());
+    }
+};
+
+/// Exact position match used to find triangles sharing an edge
+struct PositionKey
+{
+    std::array<float, 3> values;
 
-    // ensure unique verts
-    for (int i = 0; i < indices.size(); i++)
+    explicit PositionKey(const glm::vec3 &pos) : values{pos.x, pos.y, pos.z}
     {
-        // check if vert is in another triangle
+    }
 
-        glm::vec3 loc = verts.at(indices.at(i)).pos;
-        if (vertIndexMap.find(loc) != vertIndexMap.end())
-            uniqueIndicies.push_back(vertIndexMap.at(loc));
+    bool operator==(const PositionKey &other) const
+    {
+        return std::memcmp(values.data(), other.values.data(), sizeof(float) * values.size()) == 0;
+    }
+
+    template <typename H> friend H AbslHashValue(H h, const PositionKey &key)
+    {
+        return H::combine_contiguous(std::move(h), reinterpret_cast<const unsigned char *>(key.values.data()),
+                                     sizeof(float) * key.values.size());
+    }
+};
+
+struct EdgeFaces
+{
+    std::array<uint32_t, 2> triangles{0, 0};
+    std::array<uint32_t, 2> opposite{0, 0};
+    uint32_t count = 0;
+};
+
+/// Direction independent key for the edge between two welded positions
+uint64_t EdgeKey(const uint32_t &first, const uint32_t &second)
+{
+    const uint64_t low = std::min(first, second);
+    const uint64_t high = std::max(first, second);
+    return (high << 32) | low;
+}
+
+constexpr size_t VertexCacheSize = 32;
+
+float ScoreVertex(const int &cachePosition, const uint32_t &remainingValence)
+{
+    if (remainingValence == 0)
+    {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+        {
+            // vertices of the last triangle get a fixed score so the same triangle strip is not favored too heavily
+            score = 0.75f;
+        }
         else
         {
-            vertIndexMap.insert(std::pair<glm::vec3, uint32_t>(loc, uniqueIndexCount));
-            finalizedVerts.push_back(verts[i]);
-            uniqueIndicies.push_back(uniqueIndexCount);
-            uniqueIndexCount++;
+            const float scaler = 1.0f / static_cast<float>(VertexCacheSize - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, 1.5f);
         }
     }
 
-    std::vector<TriangleTracker> triangles;
+    // boost vertices with few triangles left so they can be retired from the cache
+    score += 2.0f / std::sqrt(static_cast<float>(remainingValence));
+    return score;
+}
+} // namespace
+
+void star::GeometryHelpers::packTriangleAdjacency(const std::vector<Vertex> &verts, std::vector<uint32_t> &indices)
+{
+    assert(indices.size() % 3 == 0 && "Adjacency can only be packed for triangle lists");
 
-    // create triangles
-    for (int i = 0; i <= uniqueIndicies.size() - 3; i += 3)
+    // connectivity is found through shared positions so seams in other attributes do not split the surface
+    std::vector<uint32_t> positionIds(verts.size());
     {
-        triangles.push_back(TriangleTracker{EdgeTracker(uniqueIndicies[i], uniqueIndicies[i + 1]),
-                                            EdgeTracker(uniqueIndicies[i + 1], uniqueIndicies[i + 2]),
-                                            EdgeTracker(uniqueIndicies[i + 2], uniqueIndicies[i])});
+        absl::flat_hash_map<PositionKey, uint32_t> positionMap;
+        positionMap.reserve(verts.size());
+        for (size_t i = 0; i < verts.size(); i++)
+        {
+            const uint32_t nextId = static_cast<uint32_t>(positionMap.size());
+            positionIds[i] = positionMap.try_emplace(PositionKey(verts[i].pos), nextId).first->second;
+        }
     }
 
-    for (int i = 0; i < triangles.size(); i++)
+    const size_t numTriangles = indices.size() / 3;
+
+    // every edge records the first two triangles using it along with the vertex opposite of the edge in each
+    absl::flat_hash_map<uint64_t, EdgeFaces> edges;
+    edges.reserve(numTriangles * 3 / 2 + 1);
+    for (size_t tri = 0; tri < numTriangles; tri++)
     {
-        for (int j = 0; j < i; j++)
+        for (size_t corner = 0; corner < 3; corner++)
         {
-            bool isNeighbor = false;
-            for (int k = 0; k < 3; k++)
+            const uint32_t first = indices[3 * tri + corner];
+            const uint32_t second = indices[3 * tri + (corner + 1) % 3];
+            const uint32_t opposite = indices[3 * tri + (corner + 2) % 3];
+
+            auto &edge = edges[EdgeKey(positionIds[first], positionIds[second])];
+            if (edge.count < 2)
             {
-                EdgeTracker &f = triangles[i].edges[k];
-                for (int m = 0; m < 3; m++)
-                {
-                    EdgeTracker &s = triangles[j].edges[m];
-                    if (f == s)
-                    {
-                        isNeighbor = true;
-                        triangles[i].addNeighbor(k, triangles[j]);
-                        triangles[j].addNeighbor(m, triangles[i]);
-                        break;
-                    }
-                }
-                if (isNeighbor)
-                    break;
+                edge.triangles[edge.count] = static_cast<uint32_t>(tri);
+                edge.opposite[edge.count] = opposite;
             }
+            edge.count++;
         }
     }
 
-    // pack adjacency information
+    // pack as triangle list with adjacency: v0, adj01, v1, adj12, v2, adj20
     std::vector<uint32_t> adjInds;
-
-    for (size_t i = 0; i < triangles.size(); i++)
+    adjInds.reserve(indices.size() * 2);
+    for (size_t tri = 0; tri < numTriangles; tri++)
     {
-        for (int j = 0; j < 3; j++)
+        for (size_t corner = 0; corner < 3; corner++)
         {
-            EdgeTracker &curEdge = triangles[i].edges[j];
-            adjInds.push_back(curEdge.verts.first);
-            adjInds.push_back(triangles[i].neighbors[j]->getOppositeVertIndex(curEdge.verts.first));
+            const uint32_t first = indices[3 * tri + corner];
+            const uint32_t second = indices[3 * tri + (corner + 1) % 3];
+            const uint32_t opposite = indices[3 * tri + (corner + 2) % 3];
+
+            const auto &edge = edges.at(EdgeKey(positionIds[first], positionIds[second]));
+
+            // boundary and non-manifold edges point back into the triangle itself
+            uint32_t neighborVert = opposite;
+            if (edge.count == 2)
+            {
+                neighborVert = edge.triangles[0] == tri ? edge.opposite[1] : edge.opposite[0];
+            }
+
+            adjInds.push_back(first);
+            adjInds.push_back(neighborVert);
         }
     }
 
-    indices = adjInds;
-    verts = finalizedVerts;
+    indices = std::move(adjInds);
 }
 
 void star::GeometryHelpers::calculateAndApplyVertTangents(std::vector<star::Vertex> &verts,
@@ -142,6 +226,205 @@ void star::GeometryHelpers::calculateAxisAlignedBoundingBox(const glm::vec3 lowe
                                             4, 7, 6, 4, 6, 5};
 }
 
+size_t star::GeometryHelpers::deduplicateVertices(std::vector<Vertex> &verts, std::vector<uint32_t> &indices)
+{
+    absl::flat_hash_map<VertexWeldKey, uint32_t> uniqueVerts;
+    uniqueVerts.reserve(verts.size());
+
+    std::vector<Vertex> finalizedVerts;
+    finalizedVerts.reserve(verts.size());
+
+    std::vector<uint32_t> remap(verts.size());
+    for (size_t i = 0; i < verts.size(); i++)
+    {
+        const auto result = uniqueVerts.try_emplace(VertexWeldKey(verts[i]), static_cast<uint32_t>(finalizedVerts.size()));
+        if (result.second)
+        {
+            finalizedVerts.push_back(verts[i]);
+        }
+
+        remap[i] = result.first->second;
+    }
+
+    for (auto &index : indices)
+    {
+        index = remap[index];
+    }
+
+    const size_t numRemoved = verts.size() - finalizedVerts.size();
+    finalizedVerts.shrink_to_fit();
+    verts = std::move(finalizedVerts);
+
+    return numRemoved;
+}
+
+void star::GeometryHelpers::optimizeVertexCacheOrder(std::vector<Vertex> &verts, std::vector<uint32_t> &indices)
+{
+    assert(indices.size() % 3 == 0 && "Vertex cache optimization requires a triangle list");
+
+    const size_t numVerts = verts.size();
+    const size_t numTris = indices.size() / 3;
+    if (numTris == 0)
+    {
+        return;
+    }
+
+    // build vertex -> triangle adjacency
+    std::vector<uint32_t> valence(numVerts, 0);
+    for (const auto &index : indices)
+    {
+        valence[index]++;
+    }
+
+    std::vector<uint32_t> adjacencyOffsets(numVerts + 1, 0);
+    for (size_t i = 0; i < numVerts; i++)
+    {
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + valence[i];
+    }
+
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePosition(numVerts, -1);
+    std::vector<float> vertScore(numVerts);
+    for (size_t i = 0; i < numVerts; i++)
+    {
+        vertScore[i] = ScoreVertex(-1, valence[i]);
+    }
+
+    std::vector<float> triScore(numTris);
+    std::vector<bool> triEmitted(numTris, false);
+    for (size_t i = 0; i < numTris; i++)
+    {
+        triScore[i] = vertScore[indices[3 * i]] + vertScore[indices[3 * i + 1]] + vertScore[indices[3 * i + 2]];
+    }
+
+    std::vector<uint32_t> cache;
+    cache.reserve(VertexCacheSize + 3);
+    std::vector<uint32_t> nextCache;
+    nextCache.reserve(VertexCacheSize + 3);
+
+    std::vector<uint32_t> orderedIndices;
+    orderedIndices.reserve(indices.size());
+
+    size_t scanCursor = 0;
+    int64_t bestTri = -1;
+    float bestScore = -1.0f;
+    for (size_t i = 0; i < numTris; i++)
+    {
+        if (triScore[i] > bestScore)
+        {
+            bestScore = triScore[i];
+            bestTri = static_cast<int64_t>(i);
+        }
+    }
+
+    while (bestTri >= 0)
+    {
+        const size_t tri = static_cast<size_t>(bestTri);
+        triEmitted[tri] = true;
+
+        // emit triangle and move its vertices to the front of the cache
+        nextCache.clear();
+        for (size_t i = 0; i < 3; i++)
+        {
+            const uint32_t vert = indices[3 * tri + i];
+            orderedIndices.push_back(vert);
+            nextCache.push_back(vert);
+            valence[vert]--;
+        }
+        for (const auto &vert : cache)
+        {
+            if (vert != nextCache[0] && vert != nextCache[1] && vert != nextCache[2])
+            {
+                nextCache.push_back(vert);
+            }
+        }
+
+        // evicted vertices lose their cache position
+        for (size_t i = VertexCacheSize; i < nextCache.size(); i++)
+        {
+            cachePosition[nextCache[i]] = -1;
+            vertScore[nextCache[i]] = ScoreVertex(-1, valence[nextCache[i]]);
+        }
+        if (nextCache.size() > VertexCacheSize)
+        {
+            nextCache.resize(VertexCacheSize);
+        }
+        std::swap(cache, nextCache);
+
+        for (size_t i = 0; i < cache.size(); i++)
+        {
+            cachePosition[cache[i]] = static_cast<int>(i);
+            vertScore[cache[i]] = ScoreVertex(static_cast<int>(i), valence[cache[i]]);
+        }
+
+        // only triangles touching the cache can have changed score
+        bestTri = -1;
+        bestScore = -1.0f;
+        for (const auto &vert : cache)
+        {
+            for (uint32_t a = adjacencyOffsets[vert]; a < adjacencyOffsets[vert + 1]; a++)
+            {
+                const uint32_t adjTri = adjacency[a];
+                if (triEmitted[adjTri])
+                {
+                    continue;
+                }
+
+                triScore[adjTri] = vertScore[indices[3 * adjTri]] + vertScore[indices[3 * adjTri + 1]] +
+                                   vertScore[indices[3 * adjTri + 2]];
+                if (triScore[adjTri] > bestScore)
+                {
+                    bestScore = triScore[adjTri];
+                    bestTri = adjTri;
+                }
+            }
+        }
+
+        if (bestTri < 0)
+        {
+            // cache has no more connected work, continue with the next unemitted triangle
+            while (scanCursor < numTris && triEmitted[scanCursor])
+            {
+                scanCursor++;
+            }
+            if (scanCursor < numTris)
+            {
+                bestTri = static_cast<int64_t>(scanCursor);
+            }
+        }
+    }
+
+    // reorder vertices in the order they are first referenced so fetches are sequential
+    std::vector<uint32_t> remap(numVerts, std::numeric_limits<uint32_t>::max());
+    std::vector<Vertex> orderedVerts;
+    orderedVerts.reserve(numVerts);
+    for (auto &index : orderedIndices)
+    {
+        if (remap[index] == std::numeric_limits<uint32_t>::max())
+        {
+            remap[index] = static_cast<uint32_t>(orderedVerts.size());
+            orderedVerts.push_back(verts[index]);
+        }
+        index = remap[index];
+    }
+
+    verts = std::move(orderedVerts);
+    indices = std::move(orderedIndices);
+}
+
+bool star::GeometryHelpers::canUseCompactIndices(const size_t &numVerts)
+{
+    return numVerts <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1;
+}
+
 void star::GeometryHelpers::calcTangentSpaceVectors(std::array<star::Vertex *, 3> &triVerts)
 {
     glm::vec3 tangent = glm::vec3(), bitangent = glm::vec3();
@@ -1,6 +1,6 @@
 #include "starlight/common/io/JSONFileWriter.hpp"
 
-#include "starlight/core/Exceptions.hpp"
+#include "starlight/core/logging/LoggingFactory.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -8,14 +8,18 @@
 namespace star::common::io
 {
 int JSONFileWriter::operator()(const std::string &path)
+{
+    return Write(m_jData, path, m_commitThroughTempFile);
+}
+
+int JSONFileWriter::Write(const nlohmann::json &jData, const std::filesystem::path &path, bool commitThroughTempFile)
 {
     // Ensure directory exists
     try
     {
-        std::filesystem::path p(path);
-        if (p.has_parent_path())
+        if (path.has_parent_path())
         {
-            std::filesystem::create_directories(p.parent_path());
+            std::filesystem::create_directories(path.parent_path());
         }
     }
     catch (...)
@@ -23,19 +27,37 @@ int JSONFileWriter::operator()(const std::string &path)
         // Non-fatal; try writing anyway
     }
 
-    // Pretty print with 2-space indentation
-    std::ofstream ofs(path, std::ios::binary);
-    if (!ofs)
+    const std::filesystem::path writePath = commitThroughTempFile ? std::filesystem::path(path.string() + ".tmp") : path;
+
     {
-        STAR_THROW(std::string("Failed to open JSON for writing: ") + path);
+        // Pretty print with 2-space indentation
+        std::ofstream ofs(writePath, std::ios::binary);
+        if (!ofs)
+        {
+            core::logging::error("Failed to open JSON for writing: ", writePath.string());
+            return 1;
+        }
+        ofs << std::setw(2) << jData;
+        ofs.flush();
+        if (!ofs)
+        {
+            core::logging::error("Failed to write JSON to: ", writePath.string());
+            return 1;
+        }
     }
-    ofs << std::setw(2) << m_jData;
-    ofs.flush();
-    if (!ofs)
+
+    if (commitThroughTempFile)
     {
-        STAR_THROW(std::string("Failed to write JSON to: ") + path);
+        std::error_code ec;
+        std::filesystem::rename(writePath, path, ec);
+        if (ec)
+        {
+            core::logging::error("Failed to commit JSON file: ", path.string(), ": ", ec.message());
+            std::filesystem::remove(writePath, ec);
+            return 1;
+        }
     }
 
     return 0;
 }
-}
\ No newline at end of file
+}
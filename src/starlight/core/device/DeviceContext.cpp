@@ -1,5 +1,6 @@
 #include "core/device/DeviceContext.hpp"
 
+#include "common/ConfigFile.hpp"
 #include "core/logging/LoggingFactory.hpp"
 #include "event/PrepForNextFrame.hpp"
 #include "event/StartOfNextFrame.hpp"
@@ -11,7 +12,7 @@
 #include "starlight/command/frames/GetFrameTracker.hpp"
 #include "starlight/core/WorkerPool.hpp"
 #include "starlight/core/helper/queue/QueueHelpers.hpp"
-#include "starlight/job/worker/detail/default_worker/BusyWaitTaskHandlingPolicy.hpp"
+#include "starlight/job/worker/detail/default_worker/ExecutorTaskHandlingPolicy.hpp"
 #include "starlight/service/QueueManagerService.hpp"
 #include "starlight/service/TaskSchedulerService.hpp"
 #include "starlight/service/TransferService.hpp"
@@ -20,7 +21,9 @@
 #include <star_common/HandleTypeRegistry.hpp>
 #include <star_common/helper/CastHelpers.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <string>
 #include <utility>
 
 star::core::device::DeviceContext::DeviceContext(DeviceContext &&other)
@@ -202,26 +205,42 @@ void star::core::device::DeviceContext::initWorkers(core::WorkerPool &pool,
                                                     absl::flat_hash_map<star::Queue_Type, Handle> engineReserved,
                                                     const uint8_t &numFramesInFlight)
 {
-    ManagerRenderResource::init(m_deviceID, &m_device, m_commandBus);
+    ManagerRenderResource::init(m_deviceID, &m_device, m_commandBus, numFramesInFlight);
 
-    if (!pool.allocateWorker())
-        STAR_THROW("Unable to allocate worker from pool for pipeline");
-
-    // create worker for pipeline building
-    job::worker::Worker pipelineWorker{job::worker::DefaultWorker{
-        job::worker::default_worker::BusyWaitTaskHandlingPolicy<job::tasks::build_pipeline::BuildPipelineTask, 64>{},
-        "Pipeline_Builder"}};
+    // pipeline building and shader compilation run on the shared executor, shaders first since pipelines wait on them.
+    // Each worker has its own home thread, so a batch of requests starts on several threads at once instead of waiting
+    // to be stolen from one.
+    const uint32_t numPipelineWorkers = getWorkerCount(Config_Settings::pipeline_build_worker_count);
+    for (uint32_t i = 0; i < numPipelineWorkers; i++)
+    {
+        job::worker::Worker pipelineWorker{job::worker::DefaultWorker{
+            job::worker::default_worker::ExecutorTaskHandlingPolicy<job::tasks::build_pipeline::BuildPipelineTask>{
+                m_taskManager.getExecutor(), job::WorkStealingExecutor::Priority::Normal},
+            "Pipeline_Builder_" + std::to_string(i)}};
+        m_taskManager.registerWorker(std::move(pipelineWorker), job::tasks::build_pipeline::BuildPipelineTaskName);
+    }
 
-    if (!pool.allocateWorker())
-        STAR_THROW("Unable to allocate worker from pool for shader compiler");
+    const uint32_t numShaderWorkers = getWorkerCount(Config_Settings::shader_compile_worker_count);
+    for (uint32_t i = 0; i < numShaderWorkers; i++)
+    {
+        job::worker::Worker shaderWorker{job::worker::DefaultWorker{
+            job::worker::default_worker::ExecutorTaskHandlingPolicy<job::tasks::compile_shader::CompileShaderTask>{
+                m_taskManager.getExecutor(), job::WorkStealingExecutor::Priority::High},
+            "Shader_Compiler_" + std::to_string(i)}};
+        m_taskManager.registerWorker(std::move(shaderWorker), job::tasks::compile_shader::CompileShaderTypeName);
+    }
+}
 
-    m_taskManager.registerWorker(std::move(pipelineWorker), job::tasks::build_pipeline::BuildPipelineTaskName);
+uint32_t star::core::device::DeviceContext::getWorkerCount(const Config_Settings &setting)
+{
+    // zero asks for one worker for each executor thread
+    uint32_t count = ConfigFile::getUint32(setting, 0);
+    if (count == 0)
+    {
+        star::common::casts::SafeCast<size_t, uint32_t>(m_taskManager.getExecutor().getNumThreads(), count);
+    }
 
-    // create worker for shader compilation
-    job::worker::Worker shaderWorker{job::worker::DefaultWorker{
-        job::worker::default_worker::BusyWaitTaskHandlingPolicy<job::tasks::compile_shader::CompileShaderTask, 64>{},
-        "Shader_Compiler"}};
-    m_taskManager.registerWorker(std::move(shaderWorker), job::tasks::compile_shader::CompileShaderTypeName);
+    return std::max(count, 1u);
 }
 
 void star::core::device::DeviceContext::handleCompleteMessages(const uint8_t maxMessagesCounter)
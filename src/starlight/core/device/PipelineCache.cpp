@@ -0,0 +1,243 @@
+#include "core/device/PipelineCache.hpp"
+
+#include "common/ConfigFile.hpp"
+#include "common/helpers/FileHelpers.hpp"
+#include "core/logging/LoggingFactory.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+namespace star::core::device
+{
+static std::filesystem::path GetCacheDirectory()
+{
+    const auto fallback = file_helpers::GetExecutableDirectory() / "tmp";
+    return ConfigFile::getString(Config_Settings::tmp_directory, fallback.string());
+}
+
+void PipelineCache::init(vk::Device device, vk::PhysicalDevice physicalDevice)
+{
+    m_device = device;
+    m_properties = physicalDevice.getProperties();
+
+    {
+        std::ostringstream oss;
+        oss << "pipeline_cache_" << std::hex << m_properties.vendorID << "_" << m_properties.deviceID << ".bin";
+        m_path = GetCacheDirectory() / oss.str();
+    }
+
+    std::ifstream file(m_path, std::ios::binary);
+    if (file.is_open())
+    {
+        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        if (isCompatible(data))
+        {
+            m_initialData = std::move(data);
+            core::logging::info("Loaded pipeline cache with " + std::to_string(m_initialData.size()) +
+                                " bytes from " + m_path.string());
+        }
+        else
+        {
+            core::logging::info("Ignoring pipeline cache created for another device or driver: " + m_path.string());
+        }
+    }
+
+    m_primary = createCache();
+    m_lastSave = std::chrono::steady_clock::now();
+}
+
+void PipelineCache::cleanupRender()
+{
+    if (!m_primary)
+    {
+        return;
+    }
+
+    std::optional<SaveData> save = std::nullopt;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        assert(m_leased.empty() && "Pipeline builds must be finished before the cache is destroyed");
+
+        save = takeSaveDataLocked();
+
+        for (auto &cache : m_available)
+        {
+            m_device.destroyPipelineCache(cache);
+        }
+        m_available.clear();
+        m_device.destroyPipelineCache(m_primary);
+        m_primary = VK_NULL_HANDLE;
+    }
+
+    if (save.has_value())
+    {
+        writeSaveData(save.value());
+    }
+}
+
+vk::PipelineCache PipelineCache::acquire()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(m_primary && "Pipeline cache must be initialized before use");
+
+    vk::PipelineCache cache{VK_NULL_HANDLE};
+    if (m_available.empty())
+    {
+        cache = createCache();
+    }
+    else
+    {
+        cache = m_available.back();
+        m_available.pop_back();
+    }
+
+    m_leased.push_back(cache);
+    return cache;
+}
+
+void PipelineCache::release(vk::PipelineCache cache, const std::chrono::nanoseconds &buildTime)
+{
+    std::optional<SaveData> save = std::nullopt;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto leased = std::find(m_leased.begin(), m_leased.end(), cache);
+        assert(leased != m_leased.end() && "Released a cache which was not acquired");
+        m_leased.erase(leased);
+        m_available.push_back(cache);
+
+        m_numBuilds++;
+        m_numBuildsSinceSave++;
+        m_totalBuildTime += buildTime;
+
+        if (std::chrono::steady_clock::now() - m_lastSave >= SaveInterval)
+        {
+            save = takeSaveDataLocked();
+        }
+    }
+
+    if (save.has_value())
+    {
+        writeSaveData(save.value());
+    }
+}
+
+void PipelineCache::save()
+{
+    std::optional<SaveData> save = std::nullopt;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        save = takeSaveDataLocked();
+    }
+
+    if (save.has_value())
+    {
+        writeSaveData(save.value());
+    }
+}
+
+std::optional<PipelineCache::SaveData> PipelineCache::takeSaveDataLocked()
+{
+    m_lastSave = std::chrono::steady_clock::now();
+    if (m_numBuildsSinceSave == 0)
+    {
+        return std::nullopt;
+    }
+
+    // caches still leased are merged on the next save
+    if (!m_available.empty())
+    {
+        m_device.mergePipelineCaches(m_primary, m_available);
+        for (auto &cache : m_available)
+        {
+            m_device.destroyPipelineCache(cache);
+        }
+        m_available.clear();
+    }
+
+    SaveData save{.data = m_device.getPipelineCacheData(m_primary), .saveIndex = ++m_numSaves};
+
+    {
+        std::ostringstream oss;
+        oss << "Saving pipeline cache with " << save.data.size() << " bytes, " << m_numBuilds
+            << " pipelines built in " << std::chrono::duration_cast<std::chrono::milliseconds>(m_totalBuildTime).count()
+            << " ms";
+        core::logging::info(oss.str());
+    }
+
+    // caches leased from now on start from everything built so far
+    m_initialData = save.data;
+    m_numBuildsSinceSave = 0;
+
+    return save;
+}
+
+void PipelineCache::writeSaveData(const SaveData &save)
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+
+    // a later save was already written by another thread, its data holds everything this one does
+    if (save.saveIndex < m_lastWrittenSave)
+    {
+        return;
+    }
+
+    // written next to the target and renamed over it so a crash never leaves a partial cache behind
+    std::filesystem::path tmpPath = m_path;
+    tmpPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::error_code error;
+        std::filesystem::create_directories(m_path.parent_path(), error);
+
+
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(save.data.data()), save.data.size());
+        file.close();
+
+        if (file.fail())
+        {
+            core::logging::warning("Failed to write pipeline cache: " + tmpPath.string());
+            std::error_code error;
+            std::filesystem::remove(tmpPath, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmpPath, m_path, error);
+    if (error)
+    {
+        core::logging::warning("Failed to replace pipeline cache " + m_path.string() + ": " + error.message());
+        std::filesystem::remove(tmpPath, error);
+        return;
+    }
+
+    m_lastWrittenSave = save.saveIndex;
+}
+
+bool PipelineCache::isCompatible(const std::vector<uint8_t> &data) const
+{
+    VkPipelineCacheHeaderVersionOne header{};
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == m_properties.vendorID && header.deviceID == m_properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+}
+
+vk::PipelineCache PipelineCache::createCache() const
+{
+    return m_device.createPipelineCache(
+        vk::PipelineCacheCreateInfo().setInitialDataSize(m_initialData.size()).setPInitialData(m_initialData.data()));
+}
+} // namespace star::core::device
@@ -26,12 +26,16 @@ static vk::Device CreateLogicalDevice(vk::PhysicalDevice physicalDevice, core::R
     vk::PhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures =
         vk::PhysicalDeviceDynamicRenderingFeatures().setDynamicRendering(true);
 
-    vk::PhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeature =
-        vk::PhysicalDeviceTimelineSemaphoreFeatures().setTimelineSemaphore(true).setPNext(&dynamicRenderingFeatures);
+    // draw indirect count has no feature struct of its own, share the 1.2 struct with timeline semaphores
+    vk::PhysicalDeviceVulkan12Features vulkan12Features =
+        vk::PhysicalDeviceVulkan12Features()
+            .setTimelineSemaphore(deviceFeatures.contains(Rendering_Device_Features::timeline_semaphores))
+            .setDrawIndirectCount(deviceFeatures.contains(Rendering_Device_Features::draw_indirect_count))
+            .setPNext(&dynamicRenderingFeatures);
     void *next = &dynamicRenderingFeatures;
-    if (deviceFeatures.contains(Rendering_Device_Features::timeline_semaphores))
+    if (vulkan12Features.timelineSemaphore || vulkan12Features.drawIndirectCount)
     {
-        next = &timelineSemaphoreFeature;
+        next = &vulkan12Features;
     }
     auto syncFeatures = vk::PhysicalDeviceSynchronization2Features().setSynchronization2(true).setPNext(next);
 
@@ -293,18 +297,35 @@ StarDevice StarDevice::Builder::build()
         requiredPhysicalDeviceFeatures.textureCompressionETC2 = feats.textureCompressionETC2;
     }
 
+    std::set<Rendering_Device_Features> enabledFeatures = m_deviceFeatures;
+    if (enabledFeatures.contains(Rendering_Device_Features::draw_indirect_count))
+    {
+        const auto feats =
+            physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+        if (!feats.get<vk::PhysicalDeviceVulkan12Features>().drawIndirectCount)
+        {
+            core::logging::warning("Draw indirect count is not supported by the device, GPU culled draws will not "
+                                   "skip empty draws on the GPU");
+            enabledFeatures.erase(Rendering_Device_Features::draw_indirect_count);
+        }
+    }
+
     device = CreateLogicalDevice(physicalDevice, m_instance, requiredPhysicalDeviceFeatures, m_extensions,
-                                 m_deviceFeatures, m_surface);
+                                 enabledFeatures, m_surface);
     if (device == VK_NULL_HANDLE)
         STAR_THROW("Failed to create logical vulkan device");
 
     Allocator allocator(device, physicalDevice, m_instance.getVulkanInstance());
-    return m_surface ? StarDevice(std::move(allocator), std::move(device), std::move(physicalDevice), m_surface.value())
-                     : StarDevice(std::move(allocator), std::move(device), std::move(physicalDevice));
+    StarDevice result =
+        m_surface ? StarDevice(std::move(allocator), std::move(device), std::move(physicalDevice), m_surface.value())
+                  : StarDevice(std::move(allocator), std::move(device), std::move(physicalDevice));
+    result.m_enabledFeatures = std::move(enabledFeatures);
+    return result;
 }
 
 StarDevice::StarDevice(StarDevice &&other) noexcept
-    : vulkanDevice(other.vulkanDevice), allocator(std::move(other.allocator)), physicalDevice(other.physicalDevice)
+    : vulkanDevice(other.vulkanDevice), allocator(std::move(other.allocator)), physicalDevice(other.physicalDevice),
+      m_renderingSurface(std::move(other.m_renderingSurface)), m_enabledFeatures(std::move(other.m_enabledFeatures))
 {
     other.vulkanDevice = VK_NULL_HANDLE;
 }
@@ -316,6 +337,8 @@ StarDevice &StarDevice::operator=(StarDevice &&other) noexcept
         vulkanDevice = std::move(other.vulkanDevice);
         allocator = std::move(other.allocator);
         physicalDevice = std::move(other.physicalDevice);
+        m_renderingSurface = std::move(other.m_renderingSurface);
+        m_enabledFeatures = std::move(other.m_enabledFeatures);
 
         other.vulkanDevice = VK_NULL_HANDLE;
     }
@@ -139,6 +139,9 @@ vk::Semaphore star::core::device::manager::ManagerCommandBuffer::submitCommandBu
     // determine the order of buffers to execute
     assert(this->mainGraphicsBufferHandle && "No main graphics buffer set -- not a valid rendering setup");
 
+    // buffers on the same queue are collected and handed over in as few submissions as possible
+    this->buffers.beginFrame(frameTracker);
+
     // submit before
     std::vector<vk::Semaphore> beforeSemaphores = {this->buffers.submitGroupWhenReady(
         device, Command_Buffer_Order::before_render_pass, frameTracker, currentFrameIndex, m_preparedQueues)};
@@ -146,16 +149,8 @@ vk::Semaphore star::core::device::manager::ManagerCommandBuffer::submitCommandBu
     // need to submit each group of buffers depending on the queue family they are in
     CommandBufferContainer::CompleteRequest &mainGraphicsBuffer = this->buffers.get(*this->mainGraphicsBufferHandle);
 
-    if (mainGraphicsBuffer.beforeBufferSubmissionCallback.has_value())
-        mainGraphicsBuffer.beforeBufferSubmissionCallback.value()(frameTracker.getCurrent().getFrameInFlightIndex());
-
-    if (!mainGraphicsBuffer.recordOnce)
-    {
-        mainGraphicsBuffer.recordBufferCallback(*mainGraphicsBuffer.commandBuffer, frameTracker, currentFrameIndex);
-    }
-
-    auto mainGraphicsSemaphore =
-        mainGraphicsBuffer.submitCommandBuffer(device, frameTracker, m_preparedQueues, &beforeSemaphores);
+    auto mainGraphicsSemaphore = this->buffers.submitRequest(device, mainGraphicsBuffer, frameTracker,
+                                                             currentFrameIndex, m_preparedQueues, &beforeSemaphores);
 
     assert(mainGraphicsSemaphore && "The main graphics complete semaphore is not valid. This might happen if the "
                                     "override function does not return a valid semaphore");
@@ -165,6 +160,9 @@ vk::Semaphore star::core::device::manager::ManagerCommandBuffer::submitCommandBu
     vk::Semaphore finalSubmissionSemaphores = this->buffers.submitGroupWhenReady(
         device, Command_Buffer_Order::end_of_frame, frameTracker, currentFrameIndex, m_preparedQueues, &waitSemaphores);
 
+    // the returned semaphore is waited on by presentation, so nothing may be left pending
+    this->buffers.flushSubmissions();
+
     if (finalSubmissionSemaphores != VK_NULL_HANDLE)
     {
         return finalSubmissionSemaphores;
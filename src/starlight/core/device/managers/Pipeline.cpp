@@ -14,9 +14,26 @@ void Pipeline::init(device::StarDevice *device, common::EventBus &eventBus, job:
     TaskCreatedResourceManager<PipelineRecord, PipelineRequest, 50>::init(device, eventBus, taskSystem);
 }
 
+Handle Pipeline::submit(PipelineRequest request)
+{
+    std::string key = request.pipeline.getStateKey(request.resolution, request.renderingInfo);
+
+    auto existing = m_requestedPipelines.find(key);
+    if (existing != m_requestedPipelines.end())
+    {
+        return existing->second;
+    }
+
+    Handle handle = TaskCreatedResourceManager<PipelineRecord, PipelineRequest, 50>::submit(std::move(request));
+    m_requestedPipelines.insert(std::make_pair(std::move(key), handle));
+    return handle;
+}
+
 void Pipeline::cleanupRender()
 {
     this->TaskCreatedResourceManager<PipelineRecord, PipelineRequest, 50>::cleanupRender();
+
+    m_requestedPipelines.clear();
     
     std::vector<const Handle *> unsubscribers; 
     for (const auto &subscriberInfo : m_subscriberShaderBuildInfo)
@@ -55,10 +72,14 @@ void Pipeline::submitTask(device::StarDevice &device, const Handle &handle, job:
                                   auto *record = this->get(handle);
                                   bool shouldKeepAlive = true;
 
-                                  for (const auto &shader : record->request.pipeline.getShaders())
+                                  const auto &shaders = record->request.pipeline.getShaders();
+                                  record->isShaderCompiled.resize(shaders.size(), false);
+                                  for (size_t i = 0; i < shaders.size(); i++)
                                   {
-                                      if (shader.isSameElementAs(event.shaderHandle))
+                                      if (!record->isShaderCompiled[i] &&
+                                          shaders[i].isSameElementAs(event.shaderHandle))
                                       {
+                                          record->isShaderCompiled[i] = true;
                                           record->numCompiled++;
                                           if (record->numCompiled == record->request.pipeline.getShaders().size())
                                           {
@@ -1,15 +1,69 @@
 #include "device/managers/Shader.hpp"
 
+#include "core/Exceptions.hpp"
 #include "device/system/event/ShaderCompiled.hpp"
+#include "job/complete_tasks/CompileShader.hpp"
 #include "job/tasks/TaskFactory.hpp"
 
+#include <filesystem>
+
+star::Handle star::core::device::manager::Shader::submit(ShaderRequest request)
+{
+    const std::string key = CreateRequestKey(request);
+
+    auto existing = m_requestedShaders.find(key);
+    if (existing == m_requestedShaders.end())
+    {
+        Handle handle = TaskCreatedResourceManager<ShaderRecord, ShaderRequest, 50>::submit(std::move(request));
+        m_requestedShaders.insert(std::make_pair(key, handle));
+        return handle;
+    }
+
+    // an in flight compile announces itself to everyone waiting on the handle when it completes. A finished one
+    // already did, so it is announced again for whatever is about to wait on it.
+    ShaderRecord *record = this->get(existing->second);
+    if (record->isReady() && !record->isCompletionQueued)
+    {
+        if (!this->m_deviceTaskSystem->getCompleteMessages()->queueTask(
+                job::complete_tasks::compile_shader::CreateShaderCompileComplete(
+                    existing->second.getID(), std::make_unique<StarShader>(record->request.shader),
+                    record->getCompiledShader())))
+        {
+            STAR_THROW("Failed to announce compiled shader for a duplicate request, complete messages are full");
+        }
+        record->isCompletionQueued = true;
+    }
+
+    return existing->second;
+}
+
+void star::core::device::manager::Shader::cleanupRender()
+{
+    TaskCreatedResourceManager<ShaderRecord, ShaderRequest, 50>::cleanupRender();
+
+    m_requestedShaders.clear();
+}
+
+std::string star::core::device::manager::Shader::CreateRequestKey(const ShaderRequest &request)
+{
+    // the same file reached through different relative paths is still one shader, a missing file fails to compile
+    // later on with a proper error
+    std::error_code error;
+    const auto path = std::filesystem::weakly_canonical(request.shader.getPath(), error);
+
+    return (error ? request.shader.getPath() : path.string()) + '\n' + request.compiler.getPrecompilerMacros() + '\n' +
+           std::to_string(static_cast<int>(request.shader.getOptimization()));
+}
+
 void star::core::device::manager::Shader::submitTask(device::StarDevice &device, const Handle &handle,
                                                      job::TaskManager &taskSystem, common::EventBus &eventBus,
                                                      ShaderRecord *storedRecord)
 {
-    taskSystem.submitTask(job::tasks::compile_shader::Create(
-        storedRecord->request.shader.getPath(), storedRecord->request.shader.getStage(), handle,
-        std::move(storedRecord->request.compiler)), 
-        job::tasks::compile_shader::CompileShaderTypeName
-        );
+    // spread over the compile workers so each starts on its own thread
+    taskSystem.submitTaskRoundRobin(
+        job::tasks::compile_shader::Create(storedRecord->request.shader.getPath(),
+                                           storedRecord->request.shader.getStage(),
+                                           storedRecord->request.shader.getOptimization(), handle,
+                                           std::move(storedRecord->request.compiler)),
+        job::tasks::compile_shader::CompileShaderTypeName);
 }
\ No newline at end of file
@@ -68,10 +68,74 @@ void DefaultRenderer::prepRender(common::IDeviceContext &device)
         }
     }
 
+    // each frame in flight renders to its own targets, the color target is read after the frame by presentation or
+    // capture. Both targets are cleared on load so whatever used them last does not need to be preserved.
+    for (size_t i = 0; i < m_renderToImages.size(); i++)
+    {
+        declareResourceUse(c, service::command_order::ResourceUse{
+                                  .resource = m_renderToImages[i],
+                                  .type = service::command_order::ResourceUse::Type::image,
+                                  .stages = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                                  .access = vk::AccessFlagBits2::eColorAttachmentWrite,
+                                  .layout = vk::ImageLayout::eColorAttachmentOptimal,
+                                  .aspect = vk::ImageAspectFlagBits::eColor,
+                                  .frameInFlightIndex = static_cast<uint8_t>(i),
+                                  .isExternal = true,
+                                  .discardsContents = true});
+    }
+    for (size_t i = 0; i < m_renderToDepthImages.size(); i++)
+    {
+        declareResourceUse(c, service::command_order::ResourceUse{
+                                  .resource = m_renderToDepthImages[i],
+                                  .type = service::command_order::ResourceUse::Type::image,
+                                  .stages = vk::PipelineStageFlagBits2::eEarlyFragmentTests |
+                                            vk::PipelineStageFlagBits2::eLateFragmentTests,
+                                  .access = vk::AccessFlagBits2::eDepthStencilAttachmentRead |
+                                            vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                                  .layout = vk::ImageLayout::eDepthStencilAttachmentOptimal,
+                                  .aspect = vk::ImageAspectFlagBits::eDepth,
+                                  .frameInFlightIndex = static_cast<uint8_t>(i),
+                                  .discardsContents = true});
+    }
+
+    if (ownsRenderResourceControllers)
+    {
+        // global data is uploaded by updateDependentData between frames
+        std::vector<std::shared_ptr<ManagerController::RenderResource::Buffer>> globals{m_infoManagerLightData,
+                                                                                       m_infoManagerLightList};
+        if (m_infoManagerCamera)
+        {
+            globals.push_back(m_infoManagerCamera);
+        }
+
+        for (const auto &global : globals)
+        {
+            for (uint8_t i = 0; i < c.frameTracker().getSetup().getNumFramesInFlight(); i++)
+            {
+                declareResourceUse(c, service::command_order::ResourceUse{
+                                          .resource = global->getHandle(i),
+                                          .type = service::command_order::ResourceUse::Type::buffer,
+                                          .stages = vk::PipelineStageFlagBits2::eVertexShader |
+                                                    vk::PipelineStageFlagBits2::eFragmentShader,
+                                          .access = vk::AccessFlagBits2::eUniformRead |
+                                                    vk::AccessFlagBits2::eShaderRead,
+                                          .frameInFlightIndex = i,
+                                          .isUploaded = true});
+            }
+        }
+    }
+
     for (auto &group : m_renderGroups)
     {
         group.prepRender(c);
     }
+    declareObjectResourceUses(c);
+
+    if (m_recordDrawsInParallel)
+    {
+        m_secondaryRecorder = std::make_unique<SecondaryDrawRecorder>();
+        m_secondaryRecorder->prepRender(c, c.frameTracker().getSetup().getNumFramesInFlight());
+    }
 
     // needs to wait until after prepRenderPhase ==> when descriptor pool will be created
     star::core::waiter::one_shot::GenericEvent<WaitForDescriptorPoolReady, star::event::DescriptorPoolReady>::Builder(
@@ -134,6 +198,12 @@ void DefaultRenderer::cleanupRender(common::IDeviceContext &context)
 {
     auto &c = static_cast<core::device::DeviceContext &>(context);
 
+    if (m_secondaryRecorder)
+    {
+        m_secondaryRecorder->cleanupRender(c);
+        m_secondaryRecorder.reset();
+    }
+
     RendererBase::cleanupRender(c);
 }
 
@@ -147,8 +217,6 @@ void DefaultRenderer::frameUpdate(common::IDeviceContext &context)
                                                          &c.getImageManager().get(m_renderToImages[i])->texture);
     m_renderingContext.recordDependentImage.manualInsert(m_renderToDepthImages[i],
                                                          &c.getImageManager().get(m_renderToDepthImages[i])->texture);
-
-    updateDependentData(c);
 }
 
 void DefaultRenderer::initBuffers(core::device::DeviceContext &context, std::shared_ptr<std::vector<Light>> lights)
@@ -164,6 +232,7 @@ void DefaultRenderer::initBuffers(core::device::DeviceContext &context, std::sha
 {
     initBuffers(context, std::move(lights));
 
+    setCullingCamera(camera);
     m_infoManagerCamera = std::make_unique<ManagerController::RenderResource::GlobalInfo>(camera);
 }
 
@@ -478,12 +547,13 @@ void DefaultRenderer::updateDependentData(star::core::device::DeviceContext &con
             const auto [submitted, semaphore] = m_infoManagerCamera->submitUpdateIfNeeded(context, fi);
             if (submitted)
             {
-                record.oneTimeWaitSemaphoreInfo.insert(m_infoManagerCamera->getHandle(fi), semaphore->vkSemaphore,
-                                                       vk::PipelineStageFlagBits::eVertexShader |
-                                                           vk::PipelineStageFlagBits::eFragmentShader,
-                                                       semaphore->signalValue);
-
-                m_renderingContext.addBufferToRenderingContext(context, m_infoManagerCamera->getHandle(fi));
+                if (semaphore != nullptr)
+                {
+                    record.oneTimeWaitSemaphoreInfo.insert(m_infoManagerCamera->getHandle(fi), semaphore->vkSemaphore,
+                                                           vk::PipelineStageFlagBits::eVertexShader |
+                                                               vk::PipelineStageFlagBits::eFragmentShader,
+                                                           semaphore->signalValue);
+                }
             }
         }
 
@@ -491,11 +561,13 @@ void DefaultRenderer::updateDependentData(star::core::device::DeviceContext &con
             const auto [submitted, semaphore] = m_infoManagerLightData->submitUpdateIfNeeded(context, fi);
             if (submitted)
             {
-                record.oneTimeWaitSemaphoreInfo.insert(m_infoManagerLightData->getHandle(fi), semaphore->vkSemaphore,
-                                                       vk::PipelineStageFlagBits::eFragmentShader,
-                                                       semaphore->signalValue);
-
-                m_renderingContext.addBufferToRenderingContext(context, m_infoManagerLightData->getHandle(fi));
+                if (semaphore != nullptr)
+                {
+                    record.oneTimeWaitSemaphoreInfo.insert(m_infoManagerLightData->getHandle(fi),
+                                                           semaphore->vkSemaphore,
+                                                           vk::PipelineStageFlagBits::eFragmentShader,
+                                                           semaphore->signalValue);
+                }
             }
         }
 
@@ -503,11 +575,13 @@ void DefaultRenderer::updateDependentData(star::core::device::DeviceContext &con
             const auto [submitted, semaphore] = m_infoManagerLightList->submitUpdateIfNeeded(context, fi);
             if (submitted)
             {
-                record.oneTimeWaitSemaphoreInfo.insert(m_infoManagerLightList->getHandle(fi), semaphore->vkSemaphore,
-                                                       vk::PipelineStageFlagBits::eFragmentShader,
-                                                       semaphore->signalValue);
-
-                m_renderingContext.addBufferToRenderingContext(context, m_infoManagerLightList->getHandle(fi));
+                if (semaphore != nullptr)
+                {
+                    record.oneTimeWaitSemaphoreInfo.insert(m_infoManagerLightList->getHandle(fi),
+                                                           semaphore->vkSemaphore,
+                                                           vk::PipelineStageFlagBits::eFragmentShader,
+                                                           semaphore->signalValue);
+                }
             }
         }
     }
@@ -524,22 +598,83 @@ std::vector<std::pair<vk::DescriptorType, const int>> DefaultRenderer::getDescri
 void DefaultRenderer::recordCommandBuffer(StarCommandBuffer &commandBuffer, const common::FrameTracker &frameTracker,
                                           const uint64_t &frameIndex)
 {
-    commandBuffer.begin(frameTracker.getCurrent().getFrameInFlightIndex());
+    const uint8_t frameInFlightIndex = frameTracker.getCurrent().getFrameInFlightIndex();
+
+    std::optional<RecordState> state = std::nullopt;
+    if (m_reuseRecordedCommands)
+    {
+        state = getRecordState(frameTracker, frameIndex);
+        if (commandBuffer.isRecordedWithState(frameInFlightIndex, state->getHash(), state->getBytes()))
+        {
+            commandBuffer.reuse(frameInFlightIndex);
+            return;
+        }
+    }
+
+    commandBuffer.begin(frameInFlightIndex);
+
+    recordCommands(commandBuffer.buffer(frameInFlightIndex), frameTracker, frameIndex);
+
+    commandBuffer.buffer(frameInFlightIndex).end();
+
+    if (state.has_value())
+    {
+        commandBuffer.setRecordedState(frameInFlightIndex, state->getHash(), state->getBytes());
+    }
+}
+
+RecordState DefaultRenderer::getRecordState(const common::FrameTracker &frameTracker, const uint64_t &frameIndex)
+{
+    const uint8_t frameInFlightIndex = frameTracker.getCurrent().getFrameInFlightIndex();
+
+    RecordState state;
+    state.add(m_renderingContext.targetResolution.width)
+        .add(m_renderingContext.targetResolution.height)
+        .add(m_secondaryRecorder != nullptr);
+
+    m_graphAcquireBarriers.hashRecordState(state);
+    m_graphReleaseBarriers.hashRecordState(state);
+
+    {
+        const auto color = prepareDynamicRenderingInfoColorAttachment(frameTracker);
+        state.add(color.imageView).add(color.imageLayout).add(color.loadOp).add(color.storeOp);
+        for (const auto &channel : color.clearValue.color.float32)
+        {
+            state.add(channel);
+        }
+
+        const auto depth = prepareDynamicRenderingInfoDepthAttachment(frameTracker);
+        state.add(depth.imageView)
+            .add(depth.imageLayout)
+            .add(depth.loadOp)
+            .add(depth.storeOp)
+            .add(depth.clearValue.depthStencil.depth)
+            .add(depth.clearValue.depthStencil.stencil);
+    }
 
-    recordCommands(commandBuffer.buffer(frameTracker.getCurrent().getFrameInFlightIndex()), frameTracker, frameIndex);
+    hashRecordState(state, frameInFlightIndex, frameIndex);
 
-    commandBuffer.buffer(frameTracker.getCurrent().getFrameInFlightIndex()).end();
+    return state;
 }
 
 void DefaultRenderer::recordCommands(vk::CommandBuffer &commandBuffer, const common::FrameTracker &frameTracker,
                                      const uint64_t &frameIndex)
 {
+    const uint8_t frameInFlightIndex = frameTracker.getCurrent().getFrameInFlightIndex();
+
     vk::Viewport viewport = this->prepareRenderingViewport(m_renderingContext.targetResolution);
     commandBuffer.setViewport(0, viewport);
 
+    // uploads are made visible before the pre-pass commands, gpu culling reads the instance buffers
+    m_graphAcquireBarriers.record(commandBuffer);
+
     recordPreRenderPassCommands(commandBuffer, frameTracker);
 
-    recordCommandBufferDependencies(commandBuffer, frameTracker.getCurrent().getFrameInFlightIndex(), frameIndex);
+    if (m_secondaryRecorder)
+    {
+        // rendering begun for secondaries may not contain any other commands, so the list is built beforehand
+        prepareDrawList(frameInFlightIndex, frameIndex);
+    }
 
     {
         vk::RenderingAttachmentInfo colorAttachmentInfo = prepareDynamicRenderingInfoColorAttachment(frameTracker);
@@ -552,83 +687,33 @@ void DefaultRenderer::recordCommands(vk::CommandBuffer &commandBuffer, const com
         renderInfo.pDepthAttachment = &depthAttachmentInfo;
         renderInfo.pColorAttachments = &colorAttachmentInfo;
         renderInfo.colorAttachmentCount = 1;
+        if (m_secondaryRecorder)
+        {
+            renderInfo.flags = vk::RenderingFlagBits::eContentsSecondaryCommandBuffers;
+        }
         commandBuffer.beginRendering(renderInfo);
     }
 
-    recordRenderingCalls(commandBuffer, frameTracker.getCurrent().getFrameInFlightIndex(), frameIndex);
-
-    commandBuffer.endRendering();
-
-    recordPostRenderingCalls(commandBuffer, frameTracker);
-}
-
-void DefaultRenderer::recordCommandBufferDependencies(vk::CommandBuffer &commandBuffer,
-                                                      const uint8_t &frameInFlightIndex, const uint64_t &frameIndex)
-{
-    auto memoryBarriers = getMemoryBarriersForThisFrame(frameInFlightIndex, frameIndex);
-
-    commandBuffer.pipelineBarrier2(vk::DependencyInfo()
-                                       .setBufferMemoryBarrierCount(memoryBarriers.size())
-                                       .setPBufferMemoryBarriers(memoryBarriers.data()));
-}
-
-std::vector<vk::BufferMemoryBarrier2> DefaultRenderer::getMemoryBarriersForThisFrame(const uint8_t &frameInFlightIndex,
-                                                                                     const uint64_t &frameIndex)
-{
-    auto barriers = std::vector<vk::BufferMemoryBarrier2>();
+    if (m_secondaryRecorder)
+    {
+        const auto renderingInfo = vk::CommandBufferInheritanceRenderingInfo()
+                                       .setColorAttachmentFormats(m_colorFormat)
+                                       .setDepthAttachmentFormat(m_depthFormat)
+                                       .setRasterizationSamples(vk::SampleCountFlagBits::e1);
 
-    if (ownsRenderResourceControllers)
+        m_drawStats =
+            m_secondaryRecorder->record(commandBuffer, m_drawList, renderingInfo, viewport, frameInFlightIndex);
+    }
+    else
     {
-        if (m_infoManagerCamera->willBeUpdatedThisFrame(frameIndex, frameInFlightIndex))
-        {
-            auto buffer =
-                m_renderingContext.bufferTransferRecords.get(m_infoManagerCamera->getHandle(frameInFlightIndex));
-
-            barriers.emplace_back(
-                vk::BufferMemoryBarrier2()
-                    .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
-                    .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
-                    .setDstStageMask(vk::PipelineStageFlagBits2::eFragmentShader |
-                                     vk::PipelineStageFlagBits2::eVertexShader)
-                    .setDstAccessMask(vk::AccessFlagBits2::eUniformRead | vk::AccessFlagBits2::eShaderRead)
-                    .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
-                    .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
-                    .setBuffer(buffer)
-                    .setSize(vk::WholeSize));
-        }
+        recordRenderingCalls(commandBuffer, frameInFlightIndex, frameIndex);
+    }
 
-        if (m_infoManagerLightData->willBeUpdatedThisFrame(frameIndex, frameInFlightIndex))
-        {
-            barriers.emplace_back(
-                vk::BufferMemoryBarrier2()
-                    .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
-                    .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
-                    .setDstStageMask(vk::PipelineStageFlagBits2::eFragmentShader |
-                                     vk::PipelineStageFlagBits2::eVertexShader)
-                    .setDstAccessMask(vk::AccessFlagBits2::eUniformRead | vk::AccessFlagBits2::eShaderRead)
-                    .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
-                    .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
-                    .setBuffer(m_renderingContext.bufferTransferRecords.get(
-                        m_infoManagerLightData->getHandle(frameInFlightIndex)))
-                    .setSize(vk::WholeSize));
-        }
+    commandBuffer.endRendering();
 
-        if (m_infoManagerLightList->willBeUpdatedThisFrame(frameIndex, frameInFlightIndex))
-        {
-            barriers.emplace_back(vk::BufferMemoryBarrier2()
-                                      .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
-                                      .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
-                                      .setDstStageMask(vk::PipelineStageFlagBits2::eFragmentShader |
-                                                       vk::PipelineStageFlagBits2::eVertexShader)
-                                      .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
-                                      .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
-                                      .setBuffer(m_renderingContext.bufferTransferRecords.get(
-                                          m_infoManagerLightList->getHandle(frameInFlightIndex)))
-                                      .setSize(vk::WholeSize));
-        }
-    }
+    recordPostRenderingCalls(commandBuffer, frameTracker);
 
-    return barriers;
+    m_graphReleaseBarriers.record(commandBuffer);
 }
 
 vk::RenderingAttachmentInfo star::core::renderer::DefaultRenderer::prepareDynamicRenderingInfoColorAttachment(
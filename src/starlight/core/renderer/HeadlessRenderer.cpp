@@ -5,25 +5,6 @@
 
 namespace star::core::renderer
 {
-namespace pre_pass
-{
-
-vk::ImageMemoryBarrier2 GetImageFromNeighbor::getBarrier() const noexcept
-{
-    assert(targetTexture != nullptr && "The target texture must be provided during init");
-    return vk::ImageMemoryBarrier2();
-}
-} // namespace pre_pass
-
-namespace post_pass
-{
-vk::ImageMemoryBarrier2 PrepImageForNeighbor::getBarrier() const noexcept
-{
-    assert(targetTexture != nullptr && "The target texture must be provided during init");
-    return vk::ImageMemoryBarrier2();
-}
-} // namespace post_pass
-
 static std::vector<star::Handle> CreateSemaphores(star::common::EventBus &evtBus,
                                                   const star::common::FrameTracker &ft) noexcept
 {
@@ -123,10 +104,6 @@ void HeadlessRenderer::prepRender(common::IDeviceContext &c)
     auto &context = static_cast<star::core::device::DeviceContext &>(c);
     m_cmdBus = &context.getCmdBus();
     m_device = context.getDevice().getVulkanDevice();
-    m_imgMgr = &context.getGraphicsManagers().imageManager;
-
-    m_prepScheme.resize(context.frameTracker().getSetup().getNumFramesInFlight(), pre_pass::DoNothing{});
-    m_postScheme.resize(context.frameTracker().getSetup().getNumFramesInFlight(), post_pass::DoNothing{});
 
     // create timeline semaphores to use
     m_timelineSemaphores = CreateSemaphores(context.getEventBus(), context.frameTracker());
@@ -164,6 +141,11 @@ vk::Semaphore HeadlessRenderer::submitBuffer(star::StarCommandBuffer &buffer,
             {
                 auto nCmd = star::command_order::GetPassInfo{edge.producer};
                 m_cmdBus->submit(nCmd);
+                if (!nCmd.getReply().get().isTriggeredThisFrame)
+                {
+                    // nothing was submitted by the producer this frame, so there is nothing to wait on
+                    continue;
+                }
 
                 waitInfo[waitInfoCount]
                     .setSemaphore(nCmd.getReply().get().signaledSemaphore)
@@ -1,6 +1,7 @@
 #include "core/renderer/RendererBase.hpp"
 
 #include "starlight/command/command_order/DeclarePass.hpp"
+#include "starlight/command/command_order/DeclareResourceUse.hpp"
 #include "starlight/command/command_order/GetPassInfo.hpp"
 #include "starlight/core/helper/queue/QueueHelpers.hpp"
 
@@ -31,10 +32,39 @@ void RendererBase::recordPreRenderPassCommands(vk::CommandBuffer &commandBuffer,
 void RendererBase::recordRenderingCalls(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
                                         const uint64_t &frameIndex)
 {
+    prepareDrawList(frameInFlightIndex, frameIndex);
+
+    m_drawStats = m_drawList.record(commandBuffer, frameInFlightIndex);
+    m_drawList.recordDebug(commandBuffer, frameInFlightIndex);
+}
+
+void RendererBase::hashRecordState(RecordState &state, const uint8_t &frameInFlightIndex, const uint64_t &frameIndex)
+{
+    // the groups cover the commands of their objects both before and after the rendering pass
     for (auto &group : m_renderGroups)
     {
-        group.recordRenderPassCommands(commandBuffer, frameInFlightIndex, frameIndex);
+        group.hashRecordState(state, frameInFlightIndex, frameIndex);
     }
+
+    prepareDrawList(frameInFlightIndex, frameIndex);
+    m_drawList.hashRecordState(state);
+}
+
+void RendererBase::prepareDrawList(const uint8_t &frameInFlightIndex, const uint64_t &frameIndex)
+{
+    if (m_drawListFrameIndex == frameIndex)
+    {
+        return;
+    }
+    m_drawListFrameIndex = frameIndex;
+
+    // draws from every group are recorded together so state shared across groups is only bound once
+    m_drawList.clear();
+    for (auto &group : m_renderGroups)
+    {
+        group.collectDraws(m_drawList, frameInFlightIndex);
+    }
+    m_drawList.sort(frameInFlightIndex);
 }
 
 void RendererBase::recordPostRenderingCalls(vk::CommandBuffer &commandBuffer, const common::FrameTracker &ft)
@@ -69,7 +99,104 @@ void RendererBase::prepRender(common::IDeviceContext &context)
 void RendererBase::frameUpdate(common::IDeviceContext &context)
 {
     auto &c = static_cast<core::device::DeviceContext &>(context);
-    updateRenderingGroups(c, c.frameTracker().getCurrent().getFrameInFlightIndex());
+    const uint8_t frameInFlightIndex = c.frameTracker().getCurrent().getFrameInFlightIndex();
+
+    // render resources written by the host are overwritten in place, the last use of this frame in flight must be done
+    auto &record = c.getManagerCommandBuffer().m_manager.get(m_commandBuffer);
+    if (record.commandBuffer)
+    {
+        record.commandBuffer->waitForLastSubmission(frameInFlightIndex);
+    }
+
+    cullRenderingGroups();
+    updateRenderingGroups(c, frameInFlightIndex);
+    updateDependentData(c);
+    gatherGraphBarriers(c, frameInFlightIndex);
+}
+
+void RendererBase::declareResourceUse(core::device::DeviceContext &context,
+                                      service::command_order::ResourceUse use) const
+{
+    context.getCmdBus().submit(star::command_order::DeclareResourceUse{m_commandBuffer, std::move(use)});
+}
+
+void RendererBase::declareObjectResourceUses(core::device::DeviceContext &context) const
+{
+    const uint8_t numFramesInFlight = context.frameTracker().getSetup().getNumFramesInFlight();
+    for (const auto &object : m_objects)
+    {
+        for (auto &use : object->getResourceUses(numFramesInFlight))
+        {
+            declareResourceUse(context, std::move(use));
+        }
+    }
+}
+
+void RendererBase::gatherGraphBarriers(core::device::DeviceContext &context, const uint8_t &frameInFlightIndex)
+{
+    auto cmd = star::command_order::GetPassInfo{m_commandBuffer};
+    context.getCmdBus().submit(cmd);
+    const auto &info = cmd.getReply().get();
+
+    const auto resolve = [&](const std::vector<service::command_order::ResourceTransition> *transitions,
+                             GraphBarriers &barriers) {
+        barriers.images.clear();
+        barriers.buffers.clear();
+        if (transitions == nullptr)
+        {
+            return;
+        }
+
+        for (const auto &transition : *transitions)
+        {
+            if (!transition.appliesTo(frameInFlightIndex))
+            {
+                continue;
+            }
+
+            if (transition.type == service::command_order::ResourceUse::Type::image)
+            {
+                barriers.images.push_back(transition.toImageBarrier(
+                    context.getImageManager().get(transition.resource)->texture.getVulkanImage()));
+            }
+            else
+            {
+                barriers.buffers.push_back(transition.toBufferBarrier(
+                    context.getManagerRenderResource()
+                        .getBuffer(context.getDeviceID(), transition.resource)
+                        .getVulkanBuffer()));
+            }
+        }
+    };
+
+    resolve(info.acquireTransitions, m_graphAcquireBarriers);
+    resolve(info.releaseTransitions, m_graphReleaseBarriers);
+}
+
+void RendererBase::GraphBarriers::record(vk::CommandBuffer &commandBuffer) const
+{
+    if (images.empty() && buffers.empty())
+    {
+        return;
+    }
+
+    commandBuffer.pipelineBarrier2(vk::DependencyInfo()
+                                       .setImageMemoryBarrierCount(static_cast<uint32_t>(images.size()))
+                                       .setPImageMemoryBarriers(images.data())
+                                       .setBufferMemoryBarrierCount(static_cast<uint32_t>(buffers.size()))
+                                       .setPBufferMemoryBarriers(buffers.data()));
+}
+
+void RendererBase::GraphBarriers::hashRecordState(RecordState &state) const
+{
+    for (const auto &barrier : images)
+    {
+        state.add(barrier);
+    }
+    for (const auto &barrier : buffers)
+    {
+        state.add(barrier);
+    }
 }
 
 std::vector<star::StarRenderGroup> RendererBase::CreateRenderingGroups(core::device::DeviceContext &context,
@@ -124,6 +251,22 @@ static star::core::graphics::SemaphoreInfo GetTransferRequestSyncToPreviousDraw(
     return star::core::graphics::SemaphoreInfo{.signalValue = currentSignalValue, .semaphore = semaphore};
 }
 
+void RendererBase::cullRenderingGroups()
+{
+    m_cullingStats = CullingStats();
+    if (!m_cullingCamera)
+    {
+        return;
+    }
+
+    const Frustum frustum =
+        Frustum::FromViewProjection(m_cullingCamera->getProjectionMatrix() * m_cullingCamera->getViewMatrix());
+    for (auto &group : m_renderGroups)
+    {
+        m_cullingStats += group.cullInstances(frustum);
+    }
+}
+
 void RendererBase::updateRenderingGroups(core::device::DeviceContext &context, const uint8_t &frameInFlightIndex)
 {
     const auto &transferSyncInfoToUse = GetTransferRequestSyncToPreviousDraw(m_commandBuffer, context.getCmdBus());
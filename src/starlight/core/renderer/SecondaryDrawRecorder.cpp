@@ -0,0 +1,158 @@
+#include "starlight/core/renderer/SecondaryDrawRecorder.hpp"
+
+#include "core/helper/queue/QueueHelpers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace star::core::renderer
+{
+void SecondaryDrawRecorder::prepRender(core::device::DeviceContext &context, const uint8_t &numFramesInFlight)
+{
+    auto *queue = core::helper::GetEngineDefaultQueue(context.getEventBus(), context.getGraphicsManagers().queueManager,
+                                                      star::Queue_Type::Tgraphics);
+    assert(queue != nullptr && "Failed to acquire default engine queue");
+
+    m_device = context.getDevice().getVulkanDevice();
+    m_queueFamilyIndex = queue->getParentQueueFamilyIndex();
+    m_numFramesInFlight = numFramesInFlight;
+    m_taskManager = &context.getTaskManager();
+
+    ensureSlots(1);
+}
+
+void SecondaryDrawRecorder::cleanupRender(core::device::DeviceContext &context)
+{
+    // destroying the pools frees the buffers allocated from them
+    for (auto &slot : m_slots)
+    {
+        for (auto &pool : slot.pools)
+        {
+            pool.cleanupRender(context.getDevice().getVulkanDevice());
+        }
+    }
+    m_slots.clear();
+    m_toExecute.clear();
+}
+
+DrawStats SecondaryDrawRecorder::record(vk::CommandBuffer &primary, const DrawList &drawList,
+                                        const vk::CommandBufferInheritanceRenderingInfo &renderingInfo,
+                                        const vk::Viewport &viewport, const uint8_t &frameInFlightIndex)
+{
+    assert(!m_slots.empty() && "Recorder must be prepared before recording");
+
+    const size_t numDraws = drawList.size();
+    if (numDraws == 0)
+    {
+        return DrawStats{};
+    }
+
+    job::WorkStealingExecutor *executor = m_taskManager->hasExecutor() ? &m_taskManager->getExecutor() : nullptr;
+    const size_t numThreads = executor != nullptr ? executor->getNumThreads() + 1 : 1;
+    const size_t numChunks = std::clamp<size_t>(numDraws / MinDrawsPerChunk, 1, numThreads);
+    const size_t drawsPerChunk = (numDraws + numChunks - 1) / numChunks;
+
+    ensureSlots(numChunks);
+    m_chunkStats.assign(numChunks, DrawStats{});
+    m_chunkErrors.assign(numChunks, nullptr);
+
+    // chunks read the list and write only their own slot, stats and error, so they need no locking
+    std::atomic<size_t> remaining{numChunks - 1};
+    const auto runChunk = [&](const size_t &chunk) {
+        const size_t first = chunk * drawsPerChunk;
+        try
+        {
+            recordChunk(chunk, drawList, first, std::min(drawsPerChunk, numDraws - first), renderingInfo, viewport,
+                        frameInFlightIndex);
+        }
+        catch (...)
+        {
+            m_chunkErrors[chunk] = std::current_exception();
+        }
+    };
+
+    for (size_t chunk = 1; chunk < numChunks; chunk++)
+    {
+        executor->submit(job::WorkStealingExecutor::Job([&runChunk, &remaining, chunk]() {
+                             runChunk(chunk);
+                             if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                             {
+                                 remaining.notify_one();
+                             }
+                         }),
+                         job::WorkStealingExecutor::Priority::High);
+    }
+
+    runChunk(0);
+
+    // the jobs reference this stack frame, so wait for all of them even when the first chunk failed
+    for (size_t left = remaining.load(std::memory_order_acquire); left != 0;
+         left = remaining.load(std::memory_order_acquire))
+    {
+        remaining.wait(left, std::memory_order_acquire);
+    }
+
+    DrawStats stats;
+    m_toExecute.clear();
+    for (size_t chunk = 0; chunk < numChunks; chunk++)
+    {
+        if (m_chunkErrors[chunk])
+        {
+            std::rethrow_exception(m_chunkErrors[chunk]);
+        }
+
+        stats += m_chunkStats[chunk];
+        m_toExecute.push_back(m_slots[chunk].buffers[frameInFlightIndex]);
+    }
+
+    primary.executeCommands(m_toExecute);
+
+    return stats;
+}
+
+void SecondaryDrawRecorder::ensureSlots(const size_t &numSlots)
+{
+    while (m_slots.size() < numSlots)
+    {
+        Slot slot;
+        for (uint8_t i = 0; i < m_numFramesInFlight; i++)
+        {
+            // reset as a whole at the start of each use instead of per buffer
+            slot.pools.emplace_back(m_device, m_queueFamilyIndex, false);
+            const auto allocateInfo = vk::CommandBufferAllocateInfo()
+                                          .setCommandPool(slot.pools.back().getVulkanCommandPool())
+                                          .setLevel(vk::CommandBufferLevel::eSecondary)
+                                          .setCommandBufferCount(1);
+            slot.buffers.push_back(m_device.allocateCommandBuffers(allocateInfo).front());
+        }
+        m_slots.push_back(std::move(slot));
+    }
+}
+
+void SecondaryDrawRecorder::recordChunk(const size_t &slot, const DrawList &drawList, const size_t &first,
+                                        const size_t &count,
+                                        const vk::CommandBufferInheritanceRenderingInfo &renderingInfo,
+                                        const vk::Viewport &viewport, const uint8_t &frameInFlightIndex)
+{
+    // the primary of this frame in flight has finished executing before it is recorded again, so has this pool
+    m_device.resetCommandPool(m_slots[slot].pools[frameInFlightIndex].getVulkanCommandPool());
+
+    const auto inheritance = vk::CommandBufferInheritanceInfo().setPNext(&renderingInfo);
+    vk::CommandBuffer &buffer = m_slots[slot].buffers[frameInFlightIndex];
+    // not one time submit, the primary may be submitted again without recording
+    buffer.begin(vk::CommandBufferBeginInfo()
+                     .setFlags(vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+                     .setPInheritanceInfo(&inheritance));
+
+    buffer.setViewport(0, viewport);
+    m_chunkStats[slot] = drawList.record(buffer, frameInFlightIndex, first, count);
+    // debug geometry binds its own state, it goes after the last draw so the chunks stay in list order
+    if (first + count == drawList.size())
+    {
+        drawList.recordDebug(buffer, frameInFlightIndex);
+    }
+
+    buffer.end();
+}
+} // namespace star::core::renderer
@@ -0,0 +1,79 @@
+#include "data_structure/DirtyRangeList.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace star::data_structure
+{
+DirtyRangeList::DirtyRangeList(size_t maxRanges) : m_maxRanges(std::max<size_t>(maxRanges, 1))
+{
+}
+
+void DirtyRangeList::markDirty(const size_t &index)
+{
+    markDirty(Range{.first = index, .count = 1});
+}
+
+void DirtyRangeList::markDirty(const Range &range)
+{
+    if (range.count == 0)
+    {
+        return;
+    }
+
+    // first range which ends at or after the new one begins, anything before it cannot touch the new range
+    auto it = std::lower_bound(m_ranges.begin(), m_ranges.end(), range.first,
+                               [](const Range &existing, const size_t &first) { return existing.end() < first; });
+
+    Range merged = range;
+    auto last = it;
+    while (last != m_ranges.end() && last->first <= merged.end())
+    {
+        const size_t end = std::max(merged.end(), last->end());
+        merged.first = std::min(merged.first, last->first);
+        merged.count = end - merged.first;
+        ++last;
+    }
+
+    it = m_ranges.erase(it, last);
+    m_ranges.insert(it, merged);
+
+    while (m_ranges.size() > m_maxRanges)
+    {
+        mergeClosestRanges();
+    }
+}
+
+void DirtyRangeList::clear()
+{
+    m_ranges.clear();
+}
+
+size_t DirtyRangeList::getNumDirtyElements() const
+{
+    size_t total = 0;
+    for (const auto &range : m_ranges)
+    {
+        total += range.count;
+    }
+    return total;
+}
+
+void DirtyRangeList::mergeClosestRanges()
+{
+    size_t closest = 0;
+    size_t smallestGap = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i + 1 < m_ranges.size(); i++)
+    {
+        const size_t gap = m_ranges[i + 1].first - m_ranges[i].end();
+        if (gap < smallestGap)
+        {
+            smallestGap = gap;
+            closest = i;
+        }
+    }
+
+    m_ranges[closest].count = m_ranges[closest + 1].end() - m_ranges[closest].first;
+    m_ranges.erase(m_ranges.begin() + static_cast<std::ptrdiff_t>(closest) + 1);
+}
+} // namespace star::data_structure
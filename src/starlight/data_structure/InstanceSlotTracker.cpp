@@ -0,0 +1,112 @@
+#include "data_structure/InstanceSlotTracker.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace star::data_structure
+{
+void InstanceSlotTracker::resize(const uint8_t &numFramesInFlight)
+{
+    m_dirtyInstances.resize(numFramesInFlight);
+    m_lastWrittenInstances.resize(numFramesInFlight);
+    m_allDirty.resize(numFramesInFlight, true);
+}
+
+void InstanceSlotTracker::markInstanceDirty(const size_t &instanceIndex)
+{
+    for (auto &dirty : m_dirtyInstances)
+    {
+        dirty.markDirty(instanceIndex);
+    }
+}
+
+void InstanceSlotTracker::markAllDirty()
+{
+    std::fill(m_allDirty.begin(), m_allDirty.end(), true);
+}
+
+bool InstanceSlotTracker::needsUpload(const uint8_t &frameInFlightIndex,
+                                      const std::vector<uint32_t> &visibleInstances) const
+{
+    assert(frameInFlightIndex < m_allDirty.size() && "Tracker has not been sized for this frame in flight");
+
+    // nothing would be drawn, the previous contents can stay until something is visible again
+    if (visibleInstances.empty())
+    {
+        return false;
+    }
+
+    if (m_allDirty[frameInFlightIndex] ||
+        m_lastWrittenInstances[frameInFlightIndex].size() != visibleInstances.size())
+    {
+        return true;
+    }
+
+    if (m_dirtyInstances[frameInFlightIndex].empty() && m_lastWrittenInstances[frameInFlightIndex] == visibleInstances)
+    {
+        return false;
+    }
+
+    for (size_t slot = 0; slot < visibleInstances.size(); slot++)
+    {
+        if (isSlotDirty(frameInFlightIndex, visibleInstances, slot))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<DirtyRangeList::Range> InstanceSlotTracker::takeDirtySlots(const uint8_t &frameInFlightIndex,
+                                                                       const std::vector<uint32_t> &visibleInstances)
+{
+    assert(frameInFlightIndex < m_allDirty.size() && "Tracker has not been sized for this frame in flight");
+
+    std::vector<DirtyRangeList::Range> result;
+
+    // a different slot count means the destination is new or about to be recreated, so everything is uploaded
+    if (!m_allDirty[frameInFlightIndex] &&
+        m_lastWrittenInstances[frameInFlightIndex].size() == visibleInstances.size())
+    {
+        DirtyRangeList dirtySlots;
+        for (size_t slot = 0; slot < visibleInstances.size(); slot++)
+        {
+            if (isSlotDirty(frameInFlightIndex, visibleInstances, slot))
+            {
+                dirtySlots.markDirty(slot);
+            }
+        }
+        result = dirtySlots.getRanges();
+    }
+
+    m_allDirty[frameInFlightIndex] = false;
+    m_dirtyInstances[frameInFlightIndex].clear();
+    m_lastWrittenInstances[frameInFlightIndex] = visibleInstances;
+
+    return result;
+}
+
+bool InstanceSlotTracker::isSlotDirty(const uint8_t &frameInFlightIndex, const std::vector<uint32_t> &visibleInstances,
+                                      const size_t &slot) const
+{
+    return m_lastWrittenInstances[frameInFlightIndex][slot] != visibleInstances[slot] ||
+           isInstanceDirty(frameInFlightIndex, visibleInstances[slot]);
+}
+
+bool InstanceSlotTracker::isInstanceDirty(const uint8_t &frameInFlightIndex, const size_t &instanceIndex) const
+{
+    const auto &ranges = m_dirtyInstances[frameInFlightIndex].getRanges();
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), instanceIndex,
+                               [](const size_t &index, const DirtyRangeList::Range &range) {
+                                   return index < range.first;
+                               });
+    if (it == ranges.begin())
+    {
+        return false;
+    }
+
+    --it;
+    return instanceIndex < it->end();
+}
+} // namespace star::data_structure
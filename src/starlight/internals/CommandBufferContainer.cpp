@@ -7,6 +7,7 @@ star::CommandBufferContainer::CommandBufferContainer(core::device::StarDevice &d
                                  std::make_pair(star::Command_Buffer_Order::end_of_frame, std::vector<Handle>(5)),
                                  std::make_pair(star::Command_Buffer_Order::presentation, std::vector<Handle>(1))})
 {
+    m_planner.prepRender(device.getVulkanDevice(), numImagesInFlight);
 }
 
 star::CommandBufferContainer::CompleteRequest::CompleteRequest(
@@ -31,7 +32,8 @@ star::CommandBufferContainer::CompleteRequest::CompleteRequest(
 
 vk::Semaphore star::CommandBufferContainer::CompleteRequest::submitCommandBuffer(
     core::device::StarDevice &device, const common::FrameTracker &frameTracker,
-    absl::flat_hash_map<star::Queue_Type, StarQueue *> &queues, std::vector<vk::Semaphore> *beforeSemaphores)
+    absl::flat_hash_map<star::Queue_Type, StarQueue *> &queues, SubmissionPlanner &planner,
+    std::vector<vk::Semaphore> *beforeSemaphores)
 {
     auto &waits = scratch.semaphores;
     auto &waitPoints = scratch.waitPoints;
@@ -47,6 +49,9 @@ vk::Semaphore star::CommandBufferContainer::CompleteRequest::submitCommandBuffer
         StarQueue *queue{queues[commandBuffer->getType()]};
         assert(queue != nullptr);
 
+        // the override submits on its own and may wait on semaphores of buffers still held by the planner
+        planner.flush();
+
         return overrideBufferSubmissionCallback.value()(*commandBuffer, frameTracker, beforeSemaphores, waits,
                                                         waitPoints, previousSignaledValues, *queue);
     }
@@ -67,9 +72,8 @@ vk::Semaphore star::CommandBufferContainer::CompleteRequest::submitCommandBuffer
             previousSignaledValues.push_back(std::nullopt);
         }
 
-        commandBuffer->submit(frameTracker.getCurrent().getFrameInFlightIndex(),
-                              queues[commandBuffer->getType()]->getVulkanQueue(), &additionalWaits,
-                              &previousSignaledValues);
+        planner.add(queues[commandBuffer->getType()]->getVulkanQueue(), *commandBuffer, &additionalWaits,
+                    &previousSignaledValues);
     }
 
     return commandBuffer->getCompleteSemaphores().at(frameTracker.getCurrent().getFrameInFlightIndex());
@@ -100,24 +104,22 @@ vk::Semaphore star::CommandBufferContainer::submitGroupWhenReady(
         if (shouldSubmitThisBuffer(bufferGroupsWithSubOrders[order][i - 1]))
         {
             CompleteRequest *buffer = this->allBuffers[bufferGroupsWithSubOrders[order][i - 1].getID()].get();
-
-            if (buffer->beforeBufferSubmissionCallback.has_value())
-                buffer->beforeBufferSubmissionCallback.value()(frameTracker.getCurrent().getFrameInFlightIndex());
-
-            if (!buffer->recordOnce)
+            if (buffer->isCulled)
             {
-                buffer->recordBufferCallback(*buffer->commandBuffer, frameTracker, currentFrameIndex);
+                resetThisBufferStatus(bufferGroupsWithSubOrders[order][i - 1]);
+                continue;
             }
 
             vk::Semaphore result = VK_NULL_HANDLE;
             if (!firstProcessed)
             {
-                result = buffer->submitCommandBuffer(device, frameTracker, queues, additionalWaitSemaphores);
+                result = submitRequest(device, *buffer, frameTracker, currentFrameIndex, queues,
+                                       additionalWaitSemaphores);
                 firstProcessed = true;
             }
             else
             {
-                result = buffer->submitCommandBuffer(device, frameTracker, queues);
+                result = submitRequest(device, *buffer, frameTracker, currentFrameIndex, queues);
             }
 
             if (result != VK_NULL_HANDLE)
@@ -132,6 +134,29 @@ vk::Semaphore star::CommandBufferContainer::submitGroupWhenReady(
     return lastInGroup;
 }
 
+vk::Semaphore star::CommandBufferContainer::submitRequest(core::device::StarDevice &device, CompleteRequest &request,
+                                                        const common::FrameTracker &frameTracker,
+                                                        const uint64_t &currentFrameIndex,
+                                                        absl::flat_hash_map<star::Queue_Type, StarQueue *> &queues,
+                                                        std::vector<vk::Semaphore> *waitSemaphores)
+{
+    if (request.overrideBufferSubmissionCallback.has_value())
+    {
+        // requests submitting on their own may also wait on earlier work from their callbacks
+        m_planner.flush();
+    }
+
+    if (request.beforeBufferSubmissionCallback.has_value())
+        request.beforeBufferSubmissionCallback.value()(frameTracker.getCurrent().getFrameInFlightIndex());
+
+    if (!request.recordOnce)
+    {
+        request.recordBufferCallback(*request.commandBuffer, frameTracker, currentFrameIndex);
+    }
+
+    return request.submitCommandBuffer(device, frameTracker, queues, m_planner, waitSemaphores);
+}
+
 star::Handle star::CommandBufferContainer::add(
     std::shared_ptr<star::CommandBufferContainer::CompleteRequest> newRequest, const bool &willBeSubmittedEachFrame,
     const star::Queue_Type &type, const star::Command_Buffer_Order &order,
@@ -145,6 +170,7 @@ star::Handle star::CommandBufferContainer::add(
                            .id = count};
     const int bufferIndex = this->allBuffers.size();
 
+    newRequest->subOrder = subOrder;
     this->allBuffers.push_back(std::move(newRequest));
     this->bufferSubmissionStatus.push_back(willBeSubmittedEachFrame ? 2 : 0);
 
@@ -157,6 +183,8 @@ star::Handle star::CommandBufferContainer::add(
 
 void star::CommandBufferContainer::cleanup(core::device::StarDevice &device)
 {
+    m_planner.cleanupRender();
+
     for (auto &request : this->allBuffers)
     {
         request->commandBuffer->cleanupRender(device.getVulkanDevice());
@@ -0,0 +1,137 @@
+#include "internals/SubmissionPlanner.hpp"
+
+#include "core/Exceptions.hpp"
+
+#include <star_common/helper/CastHelpers.hpp>
+
+#include <cassert>
+#include <sstream>
+
+namespace star
+{
+void SubmissionPlanner::prepRender(vk::Device device, const uint8_t &numFramesInFlight)
+{
+    m_device = device;
+    m_fences.resize(numFramesInFlight);
+}
+
+void SubmissionPlanner::cleanupRender()
+{
+    for (auto &frame : m_fences)
+    {
+        for (auto &slot : frame)
+        {
+            m_device.destroyFence(slot.fence);
+        }
+    }
+    m_fences.clear();
+}
+
+void SubmissionPlanner::beginFrame(const uint8_t &frameInFlightIndex)
+{
+    assert(frameInFlightIndex < m_fences.size() && "Planner must be prepared before use");
+
+    flush();
+
+    m_frameInFlightIndex = frameInFlightIndex;
+    m_numSubmissions = 0;
+}
+
+void SubmissionPlanner::add(vk::Queue queue, StarCommandBuffer &commandBuffer,
+                            const std::vector<std::pair<vk::Semaphore, vk::PipelineStageFlags>> *additionalWaits,
+                            const std::vector<std::optional<uint64_t>> *additionalWaitsSignaledValues)
+{
+    if (queue != m_queue)
+    {
+        flush();
+        m_queue = queue;
+    }
+
+    Entry entry{.commandBuffer = &commandBuffer};
+    star::common::casts::SafeCast<size_t, uint32_t>(m_waits.size(), entry.waitOffset);
+    star::common::casts::SafeCast<size_t, uint32_t>(m_signals.size(), entry.signalOffset);
+
+    commandBuffer.appendSubmitInfo(m_frameInFlightIndex, additionalWaits, additionalWaitsSignaledValues, m_waits,
+                                   m_signals);
+
+    entry.waitCount = static_cast<uint32_t>(m_waits.size()) - entry.waitOffset;
+    entry.signalCount = static_cast<uint32_t>(m_signals.size()) - entry.signalOffset;
+    m_entries.push_back(entry);
+}
+
+void SubmissionPlanner::flush()
+{
+    if (m_entries.empty())
+    {
+        return;
+    }
+
+    // the info lists only stop growing here, so pointers into them are taken last
+    m_commandBufferInfos.clear();
+    m_submitInfos.clear();
+    for (const auto &entry : m_entries)
+    {
+        m_commandBufferInfos.push_back(
+            vk::CommandBufferSubmitInfo().setCommandBuffer(entry.commandBuffer->buffer(m_frameInFlightIndex)));
+    }
+    for (size_t i = 0; i < m_entries.size(); i++)
+    {
+        const Entry &entry = m_entries[i];
+        m_submitInfos.push_back(vk::SubmitInfo2()
+                                    .setWaitSemaphoreInfoCount(entry.waitCount)
+                                    .setPWaitSemaphoreInfos(m_waits.data() + entry.waitOffset)
+                                    .setCommandBufferInfoCount(1)
+                                    .setPCommandBufferInfos(&m_commandBufferInfos[i])
+                                    .setSignalSemaphoreInfoCount(entry.signalCount)
+                                    .setPSignalSemaphoreInfos(m_signals.data() + entry.signalOffset));
+    }
+
+    FenceSlot &slot = acquireFence();
+    try
+    {
+        m_queue.submit2(m_submitInfos, slot.fence);
+    }
+    catch (const vk::Error &e)
+    {
+        std::ostringstream oss;
+        oss << "Vulkan error encountered while submitting command buffers. " << e.what();
+        STAR_THROW(oss.str());
+    }
+
+    for (const auto &entry : m_entries)
+    {
+        entry.commandBuffer->setSubmissionFence(m_frameInFlightIndex, slot.fence);
+        slot.commandBuffers.push_back(entry.commandBuffer);
+    }
+
+    m_entries.clear();
+    m_waits.clear();
+    m_signals.clear();
+    m_numSubmissions++;
+}
+
+SubmissionPlanner::FenceSlot &SubmissionPlanner::acquireFence()
+{
+    auto &frame = m_fences[m_frameInFlightIndex];
+    if (m_numSubmissions == frame.size())
+    {
+        frame.push_back(FenceSlot{.fence = m_device.createFence(vk::FenceCreateInfo())});
+        return frame.back();
+    }
+
+    // last signaled for this frame in flight, any buffer still waiting on it no longer needs to once it completes
+    FenceSlot &slot = frame[m_numSubmissions];
+    if (m_device.waitForFences(slot.fence, VK_TRUE, UINT64_MAX) != vk::Result::eSuccess)
+    {
+        STAR_THROW("Failed to wait for submission fence");
+    }
+    for (auto *commandBuffer : slot.commandBuffers)
+    {
+        commandBuffer->releaseSubmissionFence(m_frameInFlightIndex, slot.fence);
+    }
+    slot.commandBuffers.clear();
+    m_device.resetFences(slot.fence);
+
+    return slot;
+}
+} // namespace star
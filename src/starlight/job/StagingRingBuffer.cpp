@@ -0,0 +1,135 @@
+#include "job/StagingRingBuffer.hpp"
+
+#include "Allocator.hpp"
+#include "core/Exceptions.hpp"
+
+#include <algorithm>
+
+namespace star::job
+{
+StagingRingBuffer::StagingRingBuffer(VmaAllocator &allocator, const vk::DeviceSize &capacity) : m_capacity(capacity)
+{
+    if (capacity == 0)
+    {
+        STAR_THROW("Staging ring buffer requires a non-zero capacity");
+    }
+
+    m_buffer = StarBuffers::Buffer::Builder(allocator)
+                   .setAllocationCreateInfo(Allocator::AllocationBuilder()
+                                                .setFlags(VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                                                          VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+                                                .setUsage(VMA_MEMORY_USAGE_AUTO)
+                                                .build(),
+                                            vk::BufferCreateInfo()
+                                                .setSharingMode(vk::SharingMode::eExclusive)
+                                                .setSize(capacity)
+                                                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
+                                            "TransferStagingRing")
+                   .setInstanceCount(1)
+                   .setInstanceSize(capacity)
+                   .buildUnique();
+
+    // keep the memory mapped for the lifetime of the ring, views map on top of this for free
+    void *mapped = nullptr;
+    m_buffer->map(&mapped);
+}
+
+std::optional<std::pair<std::unique_ptr<StarBuffers::Buffer>, StagingRingBuffer::Region>> StagingRingBuffer::allocate(
+    const TransferRequest::StagingLayout &layout)
+{
+    if (layout.size == 0 || layout.size > m_capacity)
+    {
+        return std::nullopt;
+    }
+
+    const vk::DeviceSize alignment = std::max(MinRegionAlignment, layout.minOffsetAlignment);
+    const auto offset = findSpace(layout.size, alignment);
+    if (!offset.has_value())
+    {
+        return std::nullopt;
+    }
+
+    const Region region{.offset = offset.value(), .size = layout.size};
+    m_inFlight.push_back(InFlightRegion{.region = region});
+    m_head = region.offset + region.size;
+
+    auto view = StarBuffers::Buffer::CreateView(m_buffer->shareResources(), m_buffer->getUsageFlags(), region.offset,
+                                                region.size, layout.instanceCount, layout.instanceSize,
+                                                layout.minOffsetAlignment);
+
+    return std::make_pair(std::move(view), region);
+}
+
+void StagingRingBuffer::release(const Region &region)
+{
+    for (auto &inFlight : m_inFlight)
+    {
+        if (inFlight.region.offset == region.offset && !inFlight.released)
+        {
+            inFlight.released = true;
+            break;
+        }
+    }
+
+    while (!m_inFlight.empty() && m_inFlight.front().released)
+    {
+        m_inFlight.pop_front();
+    }
+
+    if (m_inFlight.empty())
+    {
+        m_head = 0;
+    }
+}
+
+void StagingRingBuffer::cleanupRender(vk::Device &device)
+{
+    if (m_buffer)
+    {
+        m_buffer->unmap();
+        m_buffer->cleanupRender(device);
+        m_buffer.reset();
+    }
+
+    m_inFlight.clear();
+    m_head = 0;
+}
+
+std::optional<vk::DeviceSize> StagingRingBuffer::findSpace(const vk::DeviceSize &size,
+                                                           const vk::DeviceSize &alignment) const
+{
+    const vk::DeviceSize alignedHead = AlignUp(m_head, alignment);
+
+    if (m_inFlight.empty())
+    {
+        return size <= m_capacity ? std::optional<vk::DeviceSize>(0) : std::nullopt;
+    }
+
+    const vk::DeviceSize tail = m_inFlight.front().region.offset;
+    if (tail < m_head)
+    {
+        // live regions sit between tail and head, try the end of the buffer then wrap to the start
+        if (alignedHead + size <= m_capacity)
+        {
+            return alignedHead;
+        }
+        if (size <= tail)
+        {
+            return 0;
+        }
+        return std::nullopt;
+    }
+
+    // already wrapped, free space is between head and tail
+    if (alignedHead + size <= tail)
+    {
+        return alignedHead;
+    }
+    return std::nullopt;
+}
+
+vk::DeviceSize StagingRingBuffer::AlignUp(const vk::DeviceSize &value, const vk::DeviceSize &alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace star::job
@@ -60,6 +60,31 @@ void TaskManager::cleanup() noexcept
             w.cleanup();
         }
     }
+
+    if (m_executor)
+    {
+        m_executor->shutdown();
+    }
+}
+
+void TaskManager::initExecutor(size_t numThreads)
+{
+    if (m_executor)
+    {
+        STAR_THROW("Task manager executor has already been initialized");
+    }
+
+    m_executor = std::make_unique<WorkStealingExecutor>(numThreads);
+}
+
+WorkStealingExecutor &TaskManager::getExecutor()
+{
+    if (!m_executor)
+    {
+        STAR_THROW("Task manager executor has not been initialized");
+    }
+
+    return *m_executor;
 }
 
 size_t TaskManager::getNumOfWorkersForType(const Handle &registeredTaskType) const noexcept
@@ -3,6 +3,7 @@
 #include "core/Exceptions.hpp"
 #include "logging/LoggingFactory.hpp"
 
+#include <algorithm>
 #include <sstream>
 
 namespace star::job
@@ -14,9 +15,56 @@ void TransferManagerThread::CreateBuffer(vk::Device device, VmaAllocator allocat
                                          ProcessRequestInfo &processInfo, TransferRequest::Buffer *newBufferRequest,
                                          std::unique_ptr<StarBuffers::Buffer> *resultingBuffer,
                                          boost::atomic<bool> *gpuDoneSignalMain,
-                                         core::graphics::GPUWorkSyncInfo &syncInfo)
+                                         core::graphics::GPUWorkSyncInfo &syncInfo, StagingRingBuffer *stagingRing)
 {
-    auto transferSrcBuffer = newBufferRequest->createStagingBuffer(device, allocator);
+    RecordBuffer(device, allocator, allTransferQueueFamilyIndicesInUse, processInfo, newBufferRequest,
+                 resultingBuffer, stagingRing);
+
+    Submit(queue, processInfo, {&syncInfo});
+}
+
+void TransferManagerThread::CreateTexture(vk::Device device, VmaAllocator allocator, StarQueue &queue,
+                                          const vk::PhysicalDeviceProperties &deviceProperties,
+                                          const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
+                                          ProcessRequestInfo &processInfo, TransferRequest::Texture *newTextureRequest,
+                                          std::unique_ptr<StarTextures::Texture> *resultingTexture,
+                                          boost::atomic<bool> *gpuDoneSignalToMain,
+                                          core::graphics::GPUWorkSyncInfo &syncInfo)
+{
+    RecordTexture(device, allocator, allTransferQueueFamilyIndicesInUse, processInfo, newTextureRequest,
+                  resultingTexture);
+
+    Submit(queue, processInfo, {&syncInfo});
+}
+
+vk::DeviceSize TransferManagerThread::RecordBuffer(vk::Device device, VmaAllocator allocator,
+                                                   const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
+                                                   ProcessRequestInfo &processInfo,
+                                                   TransferRequest::Buffer *newBufferRequest,
+                                                   std::unique_ptr<StarBuffers::Buffer> *resultingBuffer,
+                                                   StagingRingBuffer *stagingRing)
+{
+    // prefer the worker's staging ring, requests which do not fit get their own allocation
+    std::unique_ptr<StarBuffers::Buffer> transferSrcBuffer = nullptr;
+    std::optional<StagingRingBuffer::Region> stagingRegion = std::nullopt;
+    if (stagingRing != nullptr)
+    {
+        const auto layout = newBufferRequest->getStagingLayout();
+        if (layout.has_value())
+        {
+            auto suballocation = stagingRing->allocate(layout.value());
+            if (suballocation.has_value())
+            {
+                transferSrcBuffer = std::move(suballocation.value().first);
+                stagingRegion = suballocation.value().second;
+            }
+        }
+    }
+
+    if (!transferSrcBuffer)
+    {
+        transferSrcBuffer = newBufferRequest->createStagingBuffer(device, allocator);
+    }
     if (transferSrcBuffer->getBufferSize() == 0)
         STAR_THROW("Failed to create transfer src buffer");
 
@@ -34,61 +82,33 @@ void TransferManagerThread::CreateBuffer(vk::Device device, VmaAllocator allocat
     }
 
     newBufferRequest->writeDataToStageBuffer(*transferSrcBuffer);
+    if (stagingRegion.has_value())
+    {
+        // ring memory is not guaranteed to be coherent
+        transferSrcBuffer->flush();
+    }
 
     newBufferRequest->copyFromTransferSRCToDST(*transferSrcBuffer, *resultingBuffer->get(),
                                                processInfo.commandBuffer->buffer(0));
 
-    processInfo.commandBuffer->buffer(0).end();
-
+    const vk::DeviceSize stagedSize = transferSrcBuffer->getBufferSize();
+    if (stagingRegion.has_value())
     {
-        const auto signalInfo = vk::SemaphoreSubmitInfo()
-                                    .setSemaphore(syncInfo.workSignalWhenDone.semaphore)
-                                    .setValue(syncInfo.workSignalWhenDone.signalValue)
-                                    .setStageMask(vk::PipelineStageFlagBits2::eAllCommands);
-
-        uint8_t waitInfoCount{0};
-        vk::SemaphoreSubmitInfo waitInfo;
-        if (syncInfo.workWaitOn.has_value())
-        {
-            const auto &v = syncInfo.workWaitOn.value();
-            waitInfo.setSemaphore(v.semaphore)
-                .setValue(v.signalValue)
-                .setStageMask(vk::PipelineStageFlagBits2::eAllCommands);
-            waitInfoCount++;
-        }
-
-        const auto cbInfo = vk::CommandBufferSubmitInfo().setCommandBuffer(processInfo.commandBuffer->buffer(0));
-
-        const auto submitInfo = vk::SubmitInfo2()
-                                    .setPWaitSemaphoreInfos(&waitInfo)
-                                    .setWaitSemaphoreInfoCount(waitInfoCount)
-                                    .setPCommandBufferInfos(&cbInfo)
-                                    .setCommandBufferInfoCount(1)
-                                    .setPSignalSemaphoreInfos(&signalInfo)
-                                    .setSignalSemaphoreInfoCount(1);
-
-        try
-        {
-            queue.getVulkanQueue().submit2(submitInfo, processInfo.commandBuffer->getFence(0));
-        }
-        catch (const vk::Error &e)
-        {
-            std::ostringstream oss;
-            oss << "Vulkan error encountered while submitting queue. Terminating. " << e.what();
-            STAR_THROW(oss.str());
-        }
+        processInfo.setInProcessDeps(std::move(transferSrcBuffer), stagingRing, stagingRegion.value());
+    }
+    else
+    {
+        processInfo.setInProcessDeps(std::move(transferSrcBuffer));
     }
 
-    processInfo.setInProcessDeps(std::move(transferSrcBuffer));
+    return stagedSize;
 }
 
-void TransferManagerThread::CreateTexture(vk::Device device, VmaAllocator allocator, StarQueue &queue,
-                                          const vk::PhysicalDeviceProperties &deviceProperties,
-                                          const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
-                                          ProcessRequestInfo &processInfo, TransferRequest::Texture *newTextureRequest,
-                                          std::unique_ptr<StarTextures::Texture> *resultingTexture,
-                                          boost::atomic<bool> *gpuDoneSignalToMain,
-                                          core::graphics::GPUWorkSyncInfo &syncInfo)
+vk::DeviceSize TransferManagerThread::RecordTexture(vk::Device device, VmaAllocator allocator,
+                                                    const std::vector<uint32_t> &allTransferQueueFamilyIndicesInUse,
+                                                    ProcessRequestInfo &processInfo,
+                                                    TransferRequest::Texture *newTextureRequest,
+                                                    std::unique_ptr<StarTextures::Texture> *resultingTexture)
 {
     auto transferSrcBuffer = newTextureRequest->createStagingBuffer(device, allocator);
 
@@ -107,49 +127,64 @@ void TransferManagerThread::CreateTexture(vk::Device device, VmaAllocator alloca
     newTextureRequest->copyFromTransferSRCToDST(*transferSrcBuffer, *resultingTexture->get(),
                                                 processInfo.commandBuffer->buffer(0));
 
+    const vk::DeviceSize stagedSize = transferSrcBuffer->getBufferSize();
+    processInfo.setInProcessDeps(std::move(transferSrcBuffer));
+
+    return stagedSize;
+}
+
+void TransferManagerThread::Submit(StarQueue &queue, ProcessRequestInfo &processInfo,
+                                   const std::vector<const core::graphics::GPUWorkSyncInfo *> &syncInfos)
+{
     processInfo.commandBuffer->buffer(0).end();
 
-    {
-        const auto signalInfo = vk::SemaphoreSubmitInfo()
-                                    .setSemaphore(syncInfo.workSignalWhenDone.semaphore)
-                                    .setValue(syncInfo.workSignalWhenDone.signalValue)
-                                    .setStageMask(vk::PipelineStageFlagBits2::eAllCommands);
-
-        uint8_t waitInfoCount{0};
-        vk::SemaphoreSubmitInfo waitInfo;
-        if (syncInfo.workWaitOn.has_value())
+    // timeline semaphores are satisfied by any value at or above the one requested, only the highest value for each
+    // semaphore needs to be part of the submission
+    auto addOrRaise = [](std::vector<vk::SemaphoreSubmitInfo> &infos, const core::graphics::SemaphoreInfo &info) {
+        for (auto &existing : infos)
         {
-            const auto &v = syncInfo.workWaitOn.value();
-            waitInfo.setSemaphore(v.semaphore)
-                .setValue(v.signalValue)
-                .setStageMask(vk::PipelineStageFlagBits2::eAllCommands);
-            waitInfoCount++;
+            if (existing.semaphore == info.semaphore)
+            {
+                existing.value = std::max(existing.value, info.signalValue);
+                return;
+            }
         }
 
-        const auto cbInfo = vk::CommandBufferSubmitInfo().setCommandBuffer(processInfo.commandBuffer->buffer(0));
-
-        const auto submitInfo = vk::SubmitInfo2()
-                                    .setPWaitSemaphoreInfos(&waitInfo)
-                                    .setWaitSemaphoreInfoCount(waitInfoCount)
-                                    .setPCommandBufferInfos(&cbInfo)
-                                    .setCommandBufferInfoCount(1)
-                                    .setPSignalSemaphoreInfos(&signalInfo)
-                                    .setSignalSemaphoreInfoCount(1);
+        infos.push_back(vk::SemaphoreSubmitInfo()
+                            .setSemaphore(info.semaphore)
+                            .setValue(info.signalValue)
+                            .setStageMask(vk::PipelineStageFlagBits2::eAllCommands));
+    };
 
-        try
-        {
-            queue.getVulkanQueue().submit2(submitInfo, processInfo.commandBuffer->getFence(0));
-        }
-        catch (const vk::Error &e)
+    std::vector<vk::SemaphoreSubmitInfo> waitInfos;
+    std::vector<vk::SemaphoreSubmitInfo> signalInfos;
+    for (const auto *syncInfo : syncInfos)
+    {
+        if (syncInfo->workWaitOn.has_value())
         {
-            std::ostringstream oss;
-            oss << "Vulkan error encountered while submitting queue. Terminating. " << e.what();
-            STAR_THROW(oss.str());
+            addOrRaise(waitInfos, syncInfo->workWaitOn.value());
         }
-
+        addOrRaise(signalInfos, syncInfo->workSignalWhenDone);
     }
 
-    processInfo.setInProcessDeps(std::move(transferSrcBuffer));
+    const auto cbInfo = vk::CommandBufferSubmitInfo().setCommandBuffer(processInfo.commandBuffer->buffer(0));
+
+    const auto submitInfo = vk::SubmitInfo2()
+                                .setWaitSemaphoreInfos(waitInfos)
+                                .setPCommandBufferInfos(&cbInfo)
+                                .setCommandBufferInfoCount(1)
+                                .setSignalSemaphoreInfos(signalInfos);
+
+    try
+    {
+        queue.getVulkanQueue().submit2(submitInfo, processInfo.commandBuffer->getFence(0));
+    }
+    catch (const vk::Error &e)
+    {
+        std::ostringstream oss;
+        oss << "Vulkan error encountered while submitting queue. Terminating. " << e.what();
+        STAR_THROW(oss.str());
+    }
 }
 
 void TransferManagerThread::CheckForCleanups(vk::Device device,
@@ -0,0 +1,195 @@
+#include "job/WorkStealingExecutor.hpp"
+
+#include "core/Exceptions.hpp"
+#include "logging/LoggingFactory.hpp"
+
+#include <cassert>
+
+namespace star::job
+{
+thread_local const WorkStealingExecutor *WorkStealingExecutor::s_currentExecutor = nullptr;
+thread_local size_t WorkStealingExecutor::s_currentThreadIndex = 0;
+
+WorkStealingExecutor::WorkStealingExecutor(size_t numThreads)
+{
+    if (numThreads == 0)
+    {
+        STAR_THROW("Work stealing executor requires at least one thread");
+    }
+
+    m_queues.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; i++)
+    {
+        m_queues.push_back(std::make_unique<ThreadQueues>());
+    }
+
+    m_threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; i++)
+    {
+        m_threads.emplace_back([this, i]() { threadFunction(i); });
+    }
+
+    core::logging::info("Work stealing executor started with ", numThreads, " threads");
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    shutdown();
+}
+
+void WorkStealingExecutor::submit(Job job, Priority priority, std::optional<size_t> affinity)
+{
+    assert(job && "Submitted job must be valid");
+
+    size_t target = 0;
+    if (s_currentExecutor == this)
+    {
+        target = s_currentThreadIndex;
+    }
+    else if (affinity.has_value())
+    {
+        target = affinity.value() % m_queues.size();
+    }
+    else
+    {
+        target = reserveAffinity();
+    }
+
+    {
+        auto &queues = *m_queues[target];
+        std::lock_guard<std::mutex> lock(queues.mutex);
+        queues.jobs[static_cast<size_t>(priority)].push_back(std::move(job));
+    }
+
+    // count must be visible before the epoch moves, sleeping threads re-check it after waking
+    m_numQueued.fetch_add(1, std::memory_order_release);
+    m_workEpoch.fetch_add(1, std::memory_order_release);
+    m_workEpoch.notify_one();
+}
+
+size_t WorkStealingExecutor::reserveAffinity() noexcept
+{
+    return m_nextAffinity.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+}
+
+void WorkStealingExecutor::shutdown()
+{
+    if (m_threads.empty())
+    {
+        return;
+    }
+
+    m_shouldRun.store(false, std::memory_order_release);
+    m_workEpoch.fetch_add(1, std::memory_order_release);
+    m_workEpoch.notify_all();
+
+    for (auto &thread : m_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+void WorkStealingExecutor::threadFunction(size_t index)
+{
+    s_currentExecutor = this;
+    s_currentThreadIndex = index;
+
+    while (true)
+    {
+        std::optional<Job> job = findWork(index);
+        if (job.has_value())
+        {
+            m_numQueued.fetch_sub(1, std::memory_order_acq_rel);
+
+            try
+            {
+                job.value()();
+            }
+            catch (const std::exception &ex)
+            {
+                core::logging::error("Work stealing executor job threw an exception: ", ex.what());
+            }
+            continue;
+        }
+
+        const uint32_t epoch = m_workEpoch.load(std::memory_order_acquire);
+        if (m_numQueued.load(std::memory_order_acquire) > 0)
+        {
+            continue;
+        }
+
+        if (!m_shouldRun.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        m_workEpoch.wait(epoch, std::memory_order_acquire);
+    }
+
+    s_currentExecutor = nullptr;
+}
+
+std::optional<WorkStealingExecutor::Job> WorkStealingExecutor::findWork(size_t index)
+{
+    // higher priority work anywhere in the pool wins over lower priority work on the local deque
+    for (size_t priority = 0; priority < NumPriorities; priority++)
+    {
+        if (auto job = popNewest(index, priority))
+        {
+            return job;
+        }
+
+        for (size_t offset = 1; offset < m_queues.size(); offset++)
+        {
+            if (auto job = stealOldest((index + offset) % m_queues.size(), priority))
+            {
+                return job;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<WorkStealingExecutor::Job> WorkStealingExecutor::popNewest(size_t index, size_t priority)
+{
+    auto &queues = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queues.mutex);
+
+    auto &jobs = queues.jobs[priority];
+    if (jobs.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Job> job = std::move(jobs.back());
+    jobs.pop_back();
+    return job;
+}
+
+std::optional<WorkStealingExecutor::Job> WorkStealingExecutor::stealOldest(size_t victim, size_t priority)
+{
+    auto &queues = *m_queues[victim];
+
+    // never block on a victim which is busy with its own deque, move on to the next one instead
+    std::unique_lock<std::mutex> lock(queues.mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        return std::nullopt;
+    }
+
+    auto &jobs = queues.jobs[priority];
+    if (jobs.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Job> job = std::move(jobs.front());
+    jobs.pop_front();
+    return job;
+}
+} // namespace star::job
@@ -59,16 +59,18 @@ void ProcessPipelinesWhichAreNowReadyForBuild(void *device, void *taskSystem, vo
             {
                 compiledShaders.push_back(std::make_pair<StarShader, std::shared_ptr<std::vector<uint32_t>>>(
                     StarShader(gm->shaderManager->get(shader)->request.shader),
-                    gm->shaderManager->get(shader)->giveMeCompiledShader()));
+                    gm->shaderManager->get(shader)->getCompiledShader()));
             }
 
             star::StarPipeline::RenderResourceDependencies deps{.compiledShaders = std::move(compiledShaders),
                                                                 .renderingTargetInfo = record.request.renderingInfo,
                                                                 .swapChainExtent = record.request.resolution};
 
-            ts->submitTask(tasks::build_pipeline::CreateBuildPipeline(d->getVulkanDevice(), handle, std::move(deps),
-                                                                      std::move(record.request.pipeline)),
-                           tasks::build_pipeline::BuildPipelineTaskName);
+            // spread over the build workers so pipelines which became ready together are built in parallel
+            ts->submitTaskRoundRobin(
+                tasks::build_pipeline::CreateBuildPipeline(d->getVulkanDevice(), gm->pipelineCache.get(), handle,
+                                                           std::move(deps), std::move(record.request.pipeline)),
+                tasks::build_pipeline::BuildPipelineTaskName);
         }
     }
 }
@@ -1,6 +1,9 @@
 #include "job/tasks/BuildPipeline.hpp"
 
 #include "starlight/job/complete_tasks/BuildPipeline.hpp"
+
+#include <chrono>
+
 namespace star::job::tasks::build_pipeline
 {
 
@@ -8,7 +11,25 @@ void ExecuteBuildPipeline(void *p)
 {
     auto *payload = static_cast<PipelineBuildPayload *>(p);
 
-    payload->pipeline->prepRender(payload->device, *payload->deps);
+    if (payload->pipelineCache == nullptr)
+    {
+        payload->pipeline->prepRender(payload->device, *payload->deps);
+        return;
+    }
+
+    payload->deps->pipelineCache = payload->pipelineCache->acquire();
+    const auto start = std::chrono::steady_clock::now();
+    try
+    {
+        payload->pipeline->prepRender(payload->device, *payload->deps);
+    }
+    catch (...)
+    {
+        payload->pipelineCache->release(payload->deps->pipelineCache, std::chrono::steady_clock::now() - start);
+        throw;
+    }
+    payload->pipelineCache->release(payload->deps->pipelineCache, std::chrono::steady_clock::now() - start);
+    payload->deps->pipelineCache = VK_NULL_HANDLE;
 }
 
 std::optional<star::job::complete_tasks::CompleteTask> CreateBuildComplete(void *payload)
@@ -21,12 +42,13 @@ std::optional<star::job::complete_tasks::CompleteTask> CreateBuildComplete(void
         job::complete_tasks::CreateBuildPipelineComplete(p->handleID, std::move(p->pipeline)));
 }
 
-BuildPipelineTask CreateBuildPipeline(vk::Device device, Handle handle, StarPipeline::RenderResourceDependencies deps,
-                                      StarPipeline pipeline)
+BuildPipelineTask CreateBuildPipeline(vk::Device device, core::device::PipelineCache *pipelineCache, Handle handle,
+                                      StarPipeline::RenderResourceDependencies deps, StarPipeline pipeline)
 {
     return BuildPipelineTask::Builder<PipelineBuildPayload>()
         .setPayload(PipelineBuildPayload{
             .device = std::move(device),
+            .pipelineCache = pipelineCache,
             .handleID = handle.getID(),
             .deps = std::make_unique<star::StarPipeline::RenderResourceDependencies>(std::move(deps)),
             .pipeline = std::make_unique<StarPipeline>(std::move(pipeline))})
@@ -20,26 +20,47 @@ void Execute(void *p)
 {
     auto *data = static_cast<CompileShaderPayload *>(p);
 
-    data->finalizedShaderObject = std::make_unique<StarShader>(data->path, data->stage);
+    data->finalizedShaderObject = std::make_unique<StarShader>(data->path, data->stage, data->optimization);
 
     {
         const std::string msg = "Beginning compile shader: " + data->path;
         core::logging::log(boost::log::trivial::info, msg);
     }
 
-    data->compiledShaderCode = std::make_shared<std::vector<uint32_t>>(data->compiler->compile(data->path, true));
+    const std::string preprocessed = data->compiler->preprocess(data->path);
+    const std::string key = data->compiler->getCacheKey(data->path, preprocessed, data->optimization);
+
+    if (data->cache != nullptr)
+    {
+        if (auto cached = data->cache->load(key); cached.has_value())
+        {
+            data->compiledShaderCode = std::make_shared<std::vector<uint32_t>>(std::move(cached.value()));
+            core::logging::log(boost::log::trivial::info, "Done, loaded from shader cache");
+            return;
+        }
+    }
+
+    data->compiledShaderCode = std::make_shared<std::vector<uint32_t>>(
+        data->compiler->compilePreprocessed(data->path, preprocessed, data->optimization));
+
+    if (data->cache != nullptr)
+    {
+        data->cache->store(key, *data->compiledShaderCode);
+    }
 
     core::logging::log(boost::log::trivial::info, "Done");
 }
 
-CompileShaderTask Create(const std::string &fileName, const star::Shader_Stage &stage, const Handle &shaderHandle,
-                         Compiler compiler)
+CompileShaderTask Create(const std::string &fileName, const star::Shader_Stage &stage,
+                         const star::Shader_Optimization &optimization, const Handle &shaderHandle, Compiler compiler)
 {
     return CompileShaderTask::Builder<CompileShaderPayload>()
         .setPayload(CompileShaderPayload{.path = fileName,
                                          .stage = stage,
+                                         .optimization = optimization,
                                          .handleID = shaderHandle.getID(),
-                                         .compiler = std::make_unique<Compiler>(std::move(compiler))})
+                                         .compiler = std::make_unique<Compiler>(std::move(compiler)),
+                                         .cache = &ShaderCache::Default()})
         .setExecute(&Execute)
         .setCreateCompleteTaskFunction(&CreateComplete)
         .build();
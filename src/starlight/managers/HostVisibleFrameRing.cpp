@@ -0,0 +1,187 @@
+#include "managers/HostVisibleFrameRing.hpp"
+
+#include "Allocator.hpp"
+#include "core/Exceptions.hpp"
+
+#include <star_common/helper/CastHelpers.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+
+namespace star
+{
+HostVisibleFrameRing::HostVisibleFrameRing(VmaAllocator &allocator, const uint8_t &numFramesInFlight,
+                                           const vk::DeviceSize &minOffsetAlignment,
+                                           std::vector<uint32_t> queueFamilyIndices,
+                                           const vk::DeviceSize &bytesPerFrame)
+    : m_minOffsetAlignment(std::max<vk::DeviceSize>(minOffsetAlignment, 1)),
+      m_bytesPerFrame(AlignUp(bytesPerFrame, m_minOffsetAlignment)), m_frames(numFramesInFlight)
+{
+    if (numFramesInFlight == 0 || bytesPerFrame == 0)
+    {
+        STAR_THROW("Host visible frame ring requires at least one frame in flight and a non-zero size");
+    }
+
+    // shaders on any of the queues may read from the ring, host writes do not need ownership transfers
+    auto bufferInfo = vk::BufferCreateInfo()
+                          .setSize(m_bytesPerFrame * numFramesInFlight)
+                          .setUsage(vk::BufferUsageFlagBits::eUniformBuffer |
+                                    vk::BufferUsageFlagBits::eStorageBuffer |
+                                    vk::BufferUsageFlagBits::eTransferDst);
+    if (queueFamilyIndices.size() > 1)
+    {
+        bufferInfo.setSharingMode(vk::SharingMode::eConcurrent)
+            .setQueueFamilyIndexCount(star::common::casts::size_t_to_unsigned_int(queueFamilyIndices.size()))
+            .setPQueueFamilyIndices(queueFamilyIndices.data());
+    }
+    else
+    {
+        bufferInfo.setSharingMode(vk::SharingMode::eExclusive);
+    }
+
+    m_buffer = StarBuffers::Buffer::Builder(allocator)
+                   .setAllocationCreateInfo(Allocator::AllocationBuilder()
+                                                .setFlags(VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                                                          VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+                                                .setUsage(VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE)
+                                                .build(),
+                                            bufferInfo, "HostVisibleFrameRing")
+                   .setInstanceCount(1)
+                   .setInstanceSize(m_bytesPerFrame * numFramesInFlight)
+                   .buildUnique();
+
+    // keep the memory mapped for the lifetime of the ring, views map on top of this for free
+    void *mapped = nullptr;
+    m_buffer->map(&mapped);
+}
+
+std::unique_ptr<StarBuffers::Buffer> HostVisibleFrameRing::allocate(const uint8_t &frameInFlightIndex,
+                                                                    const TransferRequest::StagingLayout &layout)
+{
+    assert(frameInFlightIndex < m_frames.size() && "Frame in flight index is out of range");
+
+    if (!m_buffer || layout.size == 0 || layout.size > MaxAllocationSize)
+    {
+        return nullptr;
+    }
+
+    auto &frame = m_frames[frameInFlightIndex];
+    const vk::DeviceSize alignment = std::max(m_minOffsetAlignment, layout.minOffsetAlignment);
+
+    // reuse released ranges before growing the region, first fit keeps the free list short
+    std::optional<vk::DeviceSize> offset = std::nullopt;
+    for (size_t i = 0; i < frame.free.size(); i++)
+    {
+        const Range range = frame.free[i];
+        const vk::DeviceSize start = AlignUp(range.offset, alignment);
+        if (start + layout.size > range.offset + range.size)
+        {
+            continue;
+        }
+
+        const Range leading{.offset = range.offset, .size = start - range.offset};
+        const Range trailing{.offset = start + layout.size, .size = range.offset + range.size - start - layout.size};
+        frame.free.erase(frame.free.begin() + i);
+        if (trailing.size > 0)
+        {
+            frame.free.insert(frame.free.begin() + i, trailing);
+        }
+        if (leading.size > 0)
+        {
+            frame.free.insert(frame.free.begin() + i, leading);
+        }
+
+        offset = start;
+        break;
+    }
+
+    if (!offset.has_value())
+    {
+        const vk::DeviceSize start = AlignUp(frame.head, alignment);
+        if (start + layout.size > m_bytesPerFrame)
+        {
+            return nullptr;
+        }
+        frame.head = start + layout.size;
+        offset = start;
+    }
+
+    return StarBuffers::Buffer::CreateView(m_buffer->shareResources(), m_buffer->getUsageFlags(),
+                                           m_bytesPerFrame * frameInFlightIndex + offset.value(), layout.size,
+                                           layout.instanceCount, layout.instanceSize, layout.minOffsetAlignment);
+}
+
+void HostVisibleFrameRing::release(const StarBuffers::Buffer &view)
+{
+    assert(owns(view) && "Released a buffer which was not allocated from this ring");
+
+    const auto frameInFlightIndex = static_cast<size_t>(view.getRangeOffset() / m_bytesPerFrame);
+    const vk::DeviceSize offset = view.getRangeOffset() - frameInFlightIndex * m_bytesPerFrame;
+
+    // every allocation starts on the minimum alignment, so the padding up to the next boundary is never in use
+    const vk::DeviceSize end = std::min(AlignUp(offset + view.getBufferSize(), m_minOffsetAlignment), m_bytesPerFrame);
+    m_frames[frameInFlightIndex].released.push_back(Range{.offset = offset, .size = end - offset});
+}
+
+void HostVisibleFrameRing::reclaim(const uint8_t &frameInFlightIndex)
+{
+    assert(frameInFlightIndex < m_frames.size() && "Frame in flight index is out of range");
+
+    auto &frame = m_frames[frameInFlightIndex];
+    if (frame.released.empty())
+    {
+        return;
+    }
+
+    frame.free.insert(frame.free.end(), frame.released.begin(), frame.released.end());
+    frame.released.clear();
+    std::sort(frame.free.begin(), frame.free.end(),
+              [](const Range &a, const Range &b) { return a.offset < b.offset; });
+
+    std::vector<Range> merged;
+    merged.reserve(frame.free.size());
+    for (const auto &range : frame.free)
+    {
+        if (!merged.empty() && merged.back().offset + merged.back().size == range.offset)
+        {
+            merged.back().size += range.size;
+        }
+        else
+        {
+            merged.push_back(range);
+        }
+    }
+
+    // free space at the end of the region goes back to the head so larger requests can use it again
+    while (!merged.empty() && merged.back().offset + merged.back().size >= frame.head)
+    {
+        frame.head = merged.back().offset;
+        merged.pop_back();
+    }
+
+    frame.free = std::move(merged);
+}
+
+bool HostVisibleFrameRing::owns(const StarBuffers::Buffer &buffer) const
+{
+    return m_buffer && buffer.isView() && buffer.shareResources() == m_buffer->shareResources();
+}
+
+void HostVisibleFrameRing::cleanupRender(vk::Device &device)
+{
+    if (m_buffer)
+    {
+        m_buffer->unmap();
+        m_buffer->cleanupRender(device);
+        m_buffer.reset();
+    }
+
+    std::fill(m_frames.begin(), m_frames.end(), FrameRegion{});
+}
+
+vk::DeviceSize HostVisibleFrameRing::AlignUp(const vk::DeviceSize &value, const vk::DeviceSize &alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace star
@@ -4,6 +4,8 @@
 #include "job/tasks/TransferTask.hpp"
 #include "starlight/command/transfer/SubmitTransferTask.hpp"
 
+#include <algorithm>
+
 std::unordered_map<star::Handle, star::core::device::StarDevice *, star::HandleHash>
     star::ManagerRenderResource::devices;
 std::unordered_map<star::Handle, std::set<boost::atomic<bool> *>, star::HandleHash>
@@ -18,10 +20,12 @@ std::unordered_map<star::Handle,
                        star::ManagerRenderResource::FinalizedResourceRequest<star::StarTextures::Texture>, 20000>>,
                    star::HandleHash>
     star::ManagerRenderResource::textureStorage;
+std::unordered_map<star::Handle, std::unique_ptr<star::HostVisibleFrameRing>, star::HandleHash>
+    star::ManagerRenderResource::frameRings;
 star::core::CommandBus *star::ManagerRenderResource::s_cmdBus = nullptr;
 
 void star::ManagerRenderResource::init(const Handle &deviceID, star::core::device::StarDevice *device,
-                                       star::core::CommandBus &cmdBus)
+                                       star::core::CommandBus &cmdBus, const uint8_t &numFramesInFlight)
 {
     devices.insert(std::make_pair(deviceID, std::move(device)));
     bufferStorage.insert(std::make_pair(
@@ -35,6 +39,18 @@ void star::ManagerRenderResource::init(const Handle &deviceID, star::core::devic
 
     highPriorityRequestCompleteFlags.insert(std::make_pair(deviceID, std::set<boost::atomic<bool> *>()));
 
+    {
+        // views in the ring are bound as both uniform and storage buffers
+        const auto limits = device->getPhysicalDevice().getProperties().limits;
+        const auto &families = device->getQueueInfo().getUniques();
+
+        frameRings.insert(std::make_pair(
+            deviceID, std::make_unique<HostVisibleFrameRing>(
+                          device->getAllocator().get(), numFramesInFlight,
+                          std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment),
+                          std::vector<uint32_t>(families.begin(), families.end()))));
+    }
+
     s_cmdBus = &cmdBus;
 }
 
@@ -113,9 +129,62 @@ star::Handle star::ManagerRenderResource::addRequest(const Handle &deviceID,
     return newHandle;
 }
 
+std::optional<star::Handle> star::ManagerRenderResource::addHostWrittenRequest(
+    const Handle &deviceID, const uint8_t &frameInFlightIndex, const TransferRequest::Buffer &newRequest)
+{
+    assert(devices.contains(deviceID) && "Device has not been properly initialized");
+
+    const auto layout = newRequest.getStagingLayout();
+    if (!layout.has_value())
+    {
+        return std::nullopt;
+    }
+
+    auto view = frameRings.at(deviceID)->allocate(frameInFlightIndex, layout.value());
+    if (!view)
+    {
+        return std::nullopt;
+    }
+
+    newRequest.writeDataToStageBuffer(*view);
+    // ring memory is not guaranteed to be coherent
+    view->flush();
+
+    FinalizedResourceRequest<star::StarBuffers::Buffer> newFull;
+    newFull.resource = std::move(view);
+
+    Handle newBufferHandle = bufferStorage.at(deviceID)->insert(std::move(newFull));
+    bufferStorage.at(deviceID)->get(newBufferHandle).cpuWorkDoneByTransferThread.store(true);
+
+    return newBufferHandle;
+}
+
+bool star::ManagerRenderResource::writeFromHost(const Handle &deviceID, const TransferRequest::Buffer &newRequest,
+                                                const Handle &handle)
+{
+    auto &container = bufferStorage.at(deviceID)->get(handle);
+    if (!container.resource || !container.resource->isView() || !container.cpuWorkDoneByTransferThread.load())
+    {
+        return false;
+    }
+
+    const auto layout = newRequest.getStagingLayout();
+    if (!layout.has_value() || layout->size > container.resource->getBufferSize() ||
+        layout->instanceSize != container.resource->getInstanceSize())
+    {
+        return false;
+    }
+
+    newRequest.writeDataToStageBuffer(*container.resource);
+    container.resource->flush();
+
+    return true;
+}
+
 void star::ManagerRenderResource::frameUpdate(const Handle &deviceID, const uint8_t &frameInFlightIndex)
 {
-    (void)frameInFlightIndex;
+    frameRings.at(deviceID)->reclaim(frameInFlightIndex);
+
     for (auto &request : highPriorityRequestCompleteFlags.at(deviceID))
     {
         if (!request->load())
@@ -141,6 +210,14 @@ void star::ManagerRenderResource::updateRequest(const Handle &deviceID,
     }
     container.cpuWorkDoneByTransferThread.store(false);
 
+    if (container.resource && frameRings.at(deviceID)->owns(*container.resource))
+    {
+        // the data outgrew its place in the frame ring, give the range back and upload to device local memory
+        frameRings.at(deviceID)->release(*container.resource);
+        container.resource->cleanupRender(devices.at(deviceID)->getVulkanDevice());
+        container.resource.reset();
+    }
+
     auto request = std::make_unique<job::TransferManagerThread::InterThreadRequest>(
         &container.cpuWorkDoneByTransferThread, std::move(newRequest), container.resource,
         waitInfo.has_value() ? star::core::graphics::GPUWorkSyncInfo{.workWaitOn = waitInfo.value()}
@@ -268,5 +345,9 @@ void star::ManagerRenderResource::cleanup(const Handle &deviceID, core::device::
     textureStorage.at(deviceID)->cleanupAll(&device);
     textureStorage.at(deviceID).reset();
 
+    // views handed out from the ring were released with the buffer storage above
+    frameRings.at(deviceID)->cleanupRender(device.getVulkanDevice());
+    frameRings.erase(deviceID);
+
     s_cmdBus = nullptr;
 }
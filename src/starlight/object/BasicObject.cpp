@@ -8,6 +8,7 @@
 #include "TransferRequest_VertInfo.hpp"
 #include "VertColorMaterial.hpp"
 #include "core/helper/queue/QueueHelpers.hpp"
+#include "starlight/object/ObjFileCache.hpp"
 
 #include <star_common/helper/CastHelpers.hpp>
 
@@ -26,44 +27,19 @@ static std::optional<std::filesystem::path> LookForTextureFile(const std::filesy
     return found;
 }
 
-static std::vector<std::shared_ptr<star::StarMaterial>> LoadMaterials(
-    const std::filesystem::path &filePath, std::optional<std::filesystem::path> mediaSearchPath = std::nullopt)
+static std::filesystem::path DefaultMaterialSearchDir(const std::filesystem::path &filePath)
 {
-    auto searchDir = mediaSearchPath.has_value() ? mediaSearchPath.value() : filePath.parent_path();
-
-    if (!std::filesystem::exists(filePath))
-    {
-        std::ostringstream oss;
-        oss << "Attempted to load object file which does not exist: " << filePath.string();
-        STAR_THROW(oss.str());
-    }
-
-    /* Load Object From File */
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> fileMaterials;
-    std::string warn, err;
+    return filePath.parent_path();
+}
 
-    if (!tinyobj::LoadObj(&attrib, &shapes, &fileMaterials, &warn, &err, filePath.string().c_str(),
-                          searchDir.string().c_str()))
-    {
-        std::ostringstream oss;
-        oss << "An error occurred while loading obj file: " << filePath << "\n";
-        oss << "Msg: " << warn + err;
-        STAR_THROW(oss.str());
-    }
-    if (warn != "")
-    {
-        std::ostringstream oss;
-        oss << "An error occurred while loading obj file" << std::endl;
-        oss << warn << std::endl;
-        oss << "Loading will continue..." << std::endl;
-        star::core::logging::warning(oss.str());
-    }
+static std::vector<std::shared_ptr<star::StarMaterial>> LoadMaterials(const std::filesystem::path &filePath,
+                                                                      const std::filesystem::path &searchDir)
+{
+    const auto parsed = star::object::ObjFileCache::GetParsed(filePath, searchDir);
 
     std::vector<std::shared_ptr<star::StarMaterial>> materials;
 
-    for (auto &fMaterial : fileMaterials)
+    for (auto fMaterial : parsed->materials)
     {
         const bool isTextureMaterial = !fMaterial.diffuse_texname.empty();
         const bool isBumpMaterial = isTextureMaterial && !fMaterial.bump_texname.empty();
@@ -125,16 +101,20 @@ static std::vector<std::shared_ptr<star::StarMaterial>> LoadMaterials(
     return materials;
 }
 
-star::BasicObject::BasicObject(std::string objFilePath, ShaderResolver &shaderResolver)
-    : StarObject(LoadMaterials(objFilePath)), m_objFilePath(std::move(objFilePath))
+star::BasicObject::BasicObject(std::string objFilePath, ShaderResolver &shaderResolver,
+                               object::ObjLoadOptions loadOptions)
+    : StarObject(LoadMaterials(objFilePath, DefaultMaterialSearchDir(objFilePath))),
+      m_objFilePath(std::move(objFilePath)), m_materialSearchDir(DefaultMaterialSearchDir(m_objFilePath)),
+      m_loadOptions(std::move(loadOptions))
 {
     m_vertexShaderHandle = shaderResolver.resolve(Shader_Stage::vertex);
     m_fragmentShaderHandle = shaderResolver.resolve(Shader_Stage::fragment);
 }
 
 star::BasicObject::BasicObject(std::string objFilePath, const std::filesystem::path &materialDir,
-                               ShaderResolver &shaderResolver)
-    : StarObject(LoadMaterials(objFilePath, materialDir)), m_objFilePath(std::move(objFilePath))
+                               ShaderResolver &shaderResolver, object::ObjLoadOptions loadOptions)
+    : StarObject(LoadMaterials(objFilePath, materialDir)), m_objFilePath(std::move(objFilePath)),
+      m_materialSearchDir(materialDir), m_loadOptions(std::move(loadOptions))
 {
     m_vertexShaderHandle = shaderResolver.resolve(Shader_Stage::vertex);
     m_fragmentShaderHandle = shaderResolver.resolve(Shader_Stage::fragment);
@@ -182,7 +162,7 @@ static std::pair<std::string, std::string> selectShaderPaths(const std::vector<s
 
 star::ShaderResolver star::BasicObject::PrepareResolver(const std::string &objFilePath, core::CommandBus &bus)
 {
-    auto materials = LoadMaterials(objFilePath);
+    auto materials = LoadMaterials(objFilePath, DefaultMaterialSearchDir(objFilePath));
     auto [vertPath, fragPath] = selectShaderPaths(materials);
     return ShaderResolver::Builder{bus}
         .setShader(Shader_Stage::vertex, vertPath)
@@ -203,105 +183,46 @@ star::ShaderResolver star::BasicObject::PrepareResolver(const std::string &objFi
 
 std::vector<star::StarMesh> star::BasicObject::loadMeshes(core::device::DeviceContext &context)
 {
-    auto parent = file_helpers::GetParentDirectory(m_objFilePath).value().string();
-
-    std::cout << "Loading object file: " << m_objFilePath << std::endl;
+    // parse and vertex generation are shared with every other object using the same file
+    const auto parsed = object::ObjFileCache::GetParsed(m_objFilePath, m_materialSearchDir);
+    auto &taskManager = context.getTaskManager();
+    const auto cooked = object::ObjFileCache::GetCooked(m_objFilePath, m_materialSearchDir, m_loadOptions,
+                                                        taskManager.hasExecutor() ? &taskManager.getExecutor()
+                                                                                  : nullptr);
+    const auto &shapes = parsed->shapes;
+    const auto &materials = parsed->materials;
 
-    /* Load Object From File */
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string warn, err;
-
-    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, m_objFilePath.c_str(), parent.c_str(), true))
-    {
-        throw std::runtime_error(warn + err);
-    }
-    if (warn != "")
-    {
-        std::ostringstream oss;
-        oss << "An error occurred while loading obj file" << std::endl;
-        oss << "TinyObjLoaderMessage: " << warn << std::endl;
-        oss << "Loading will contine..." << std::endl;
-        star::core::logging::warning(oss.str());
-    }
-
-    size_t shapeCounter = 0;
-    Handle loadMaterialTexture;
-    std::unique_ptr<std::vector<Vertex>> verticies;
-    std::unique_ptr<std::vector<uint32_t>> indicies;
-    std::unique_ptr<std::vector<std::pair<unsigned int, unsigned int>>> sortedIds;
     std::vector<StarMesh> meshes;
     meshes.reserve(shapes.size());
 
-    tinyobj::material_t *currMaterial = nullptr;
-    std::unique_ptr<StarMaterial> objectMaterial;
-    std::vector<std::shared_ptr<StarMaterial>> preparedMaterials;
-
     const auto graphicsQueueFamilyIndex =
         core::helper::GetEngineDefaultQueue(context.getEventBus(), context.getGraphicsManagers().queueManager,
                                             star::Queue_Type::Tgraphics)
             ->getParentQueueFamilyIndex();
 
-    // need to scale object so that it fits on screen
-    // combine all attributes into a single object
-    int dIndex = 0;
-    for (const auto &shape : shapes)
+    for (size_t shapeCounter = 0; shapeCounter < shapes.size(); shapeCounter++)
     {
-        // tinyobj ensures three verticies per triangle  -- assuming unique vertices
-        const std::vector<tinyobj::index_t> &indicies = shape.mesh.indices;
-        std::vector<uint32_t> fullInd;
-        fullInd.reserve(fullInd.size());
-        std::vector<Vertex> vertices;
-        vertices.reserve(shape.mesh.indices.size());
-
-        for (size_t faceIndex = 0; faceIndex < shape.mesh.material_ids.size(); faceIndex++)
-        {
-            for (int i = 0; i < 3; i++)
-            {
-                dIndex = (3 * faceIndex) + i;
-                auto newVertex = Vertex();
-                newVertex.pos = glm::vec3{attrib.vertices[3 * indicies[dIndex].vertex_index + 0],
-                                          attrib.vertices[3 * indicies[dIndex].vertex_index + 1],
-                                          attrib.vertices[3 * indicies[dIndex].vertex_index + 2]};
-                newVertex.color = glm::vec3{
-                    attrib.colors[3 * indicies[dIndex].vertex_index + 0],
-                    attrib.colors[3 * indicies[dIndex].vertex_index + 1],
-                    attrib.colors[3 * indicies[dIndex].vertex_index + 2],
-                };
-
-                if (attrib.normals.size() > 0)
-                {
-                    newVertex.normal = {
-                        attrib.normals[3 * indicies[dIndex].normal_index + 0],
-                        attrib.normals[3 * indicies[dIndex].normal_index + 1],
-                        attrib.normals[3 * indicies[dIndex].normal_index + 2],
-                    };
-                }
-
-                newVertex.texCoord = {attrib.texcoords[2 * indicies[dIndex].texcoord_index + 0],
-                                      1.0f - attrib.texcoords[2 * indicies[dIndex].texcoord_index + 1]};
-
-                vertices.emplace_back(std::move(newVertex));
-                fullInd.emplace_back(star::common::casts::size_t_to_unsigned_int(vertices.size() - 1));
-            }
-        }
+        const auto &shape = shapes[shapeCounter];
+        const auto &cookedShape = cooked->shapes[shapeCounter];
 
         if (shape.mesh.material_ids.at(shapeCounter) != -1)
         {
             const Handle meshVertBuffer = ManagerRenderResource::addRequest(
                 context.getDeviceID(),
-                std::make_unique<TransferRequest::VertInfo>(graphicsQueueFamilyIndex, vertices));
+                std::make_unique<TransferRequest::VertInfo>(graphicsQueueFamilyIndex, cookedShape.vertices,
+                                                            m_loadOptions.vertexLayout));
 
             const Handle meshIndBuffer = ManagerRenderResource::addRequest(
                 context.getDeviceID(),
-                std::make_unique<TransferRequest::IndicesInfo>(graphicsQueueFamilyIndex, fullInd));
+                std::make_unique<TransferRequest::IndicesInfo>(graphicsQueueFamilyIndex, cookedShape.indices,
+                                                               cookedShape.compactIndices));
 
             // apply material from files to mesh -- will ignore passed values
-            meshes.emplace_back(meshVertBuffer, meshIndBuffer, vertices, fullInd,
-                                m_meshMaterials.at(shape.mesh.material_ids[0]), false);
+            meshes.emplace_back(meshVertBuffer, meshIndBuffer, cookedShape.vertices, cookedShape.indices,
+                                m_meshMaterials.at(shape.mesh.material_ids[0]), m_loadOptions.packAdjacency,
+                                cookedShape.compactIndices ? vk::IndexType::eUint16 : vk::IndexType::eUint32,
+                                m_loadOptions.vertexLayout);
         }
-        shapeCounter++;
     }
 
     if (materials.size() != meshes.size() || materials.size() != m_meshMaterials.size())
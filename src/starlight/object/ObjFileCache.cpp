@@ -0,0 +1,313 @@
+#include "starlight/object/ObjFileCache.hpp"
+
+#include "GeometryHelpers.hpp"
+#include "core/Exceptions.hpp"
+#include "job/WorkStealingExecutor.hpp"
+
+#include <star_common/helper/CastHelpers.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+
+namespace star::object
+{
+std::mutex ObjFileCache::m_lock;
+absl::flat_hash_map<std::string, ObjFileCache::Entry> ObjFileCache::m_entries;
+
+/// Shared by the calling thread and the executor jobs of one cook. Jobs may still start after the cook returned, they
+/// then find no shape left, so everything they touch is owned here rather than by the caller's stack.
+struct ObjFileCache::ShapeBatch
+{
+    std::shared_ptr<const ParsedObjFile> parsed;
+    ObjLoadOptions options;
+    std::vector<CookedObjShape> shapes;
+    std::atomic<size_t> nextShape{0};
+    std::atomic<size_t> numDone{0};
+    std::mutex failureLock;
+    std::exception_ptr failure = nullptr;
+};
+
+std::shared_ptr<const ParsedObjFile> ObjFileCache::GetParsed(const std::filesystem::path &objFilePath,
+                                                             const std::filesystem::path &materialSearchDir)
+{
+    return getParsedFuture(objFilePath, materialSearchDir).get();
+}
+
+std::shared_ptr<const CookedObjFile> ObjFileCache::GetCooked(const std::filesystem::path &objFilePath,
+                                                             const std::filesystem::path &materialSearchDir,
+                                                             const ObjLoadOptions &options,
+                                                             job::WorkStealingExecutor *executor)
+{
+    std::shared_ptr<const ParsedObjFile> parsed = nullptr;
+    std::promise<std::shared_ptr<const CookedObjFile>> promise;
+    CookedFuture cooked;
+    bool shouldCook = false;
+    while (!cooked.valid())
+    {
+        parsed = getParsedFuture(objFilePath, materialSearchDir).get();
+
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        auto &entry = getEntry(objFilePath, materialSearchDir);
+        if (!entry.parsed.valid())
+        {
+            // the file changed after it was parsed, cook the new contents instead
+            continue;
+        }
+
+        auto &slot = entry.cooked[options.getKey()];
+        if (!slot.valid())
+        {
+            slot = promise.get_future().share();
+            shouldCook = true;
+        }
+        cooked = slot;
+    }
+
+    if (shouldCook)
+    {
+        try
+        {
+            promise.set_value(Cook(objFilePath, std::move(parsed), options, executor));
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    return cooked.get();
+}
+
+void ObjFileCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    m_entries.clear();
+}
+
+ObjFileCache::Entry &ObjFileCache::getEntry(const std::filesystem::path &objFilePath,
+                                            const std::filesystem::path &materialSearchDir)
+{
+    if (!std::filesystem::exists(objFilePath))
+    {
+        std::ostringstream oss;
+        oss << "Attempted to load object file which does not exist: " << objFilePath.string();
+        STAR_THROW(oss.str());
+    }
+
+    const auto writeTime = std::filesystem::last_write_time(objFilePath);
+    const std::string key = objFilePath.lexically_normal().string() + "|" + materialSearchDir.lexically_normal().string();
+
+    auto &entry = m_entries[key];
+    if (entry.lastWriteTime != writeTime || !entry.parsed.valid())
+    {
+        // requests still waiting on the replaced futures keep them alive and receive the old results
+        entry = Entry{.lastWriteTime = writeTime};
+    }
+
+    return entry;
+}
+
+ObjFileCache::ParsedFuture ObjFileCache::getParsedFuture(const std::filesystem::path &objFilePath,
+                                                         const std::filesystem::path &materialSearchDir)
+{
+    std::promise<std::shared_ptr<const ParsedObjFile>> promise;
+    ParsedFuture parsed;
+    bool shouldParse = false;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        auto &entry = getEntry(objFilePath, materialSearchDir);
+        if (!entry.parsed.valid())
+        {
+            entry.parsed = promise.get_future().share();
+            shouldParse = true;
+        }
+        parsed = entry.parsed;
+    }
+
+    if (shouldParse)
+    {
+        try
+        {
+            promise.set_value(Parse(objFilePath, materialSearchDir));
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    return parsed;
+}
+
+std::shared_ptr<const ParsedObjFile> ObjFileCache::Parse(const std::filesystem::path &objFilePath,
+                                                         const std::filesystem::path &materialSearchDir)
+{
+    core::logging::info("Loading object file: ", objFilePath.string());
+
+    auto parsed = std::make_shared<ParsedObjFile>();
+    std::string warn, err;
+
+    if (!tinyobj::LoadObj(&parsed->attrib, &parsed->shapes, &parsed->materials, &warn, &err,
+                          objFilePath.string().c_str(), materialSearchDir.string().c_str()))
+    {
+        std::ostringstream oss;
+        oss << "An error occurred while loading obj file: " << objFilePath << "\n";
+        oss << "Msg: " << warn + err;
+        STAR_THROW(oss.str());
+    }
+    if (warn != "")
+    {
+        std::ostringstream oss;
+        oss << "An error occurred while loading obj file" << std::endl;
+        oss << warn << std::endl;
+        oss << "Loading will continue..." << std::endl;
+        core::logging::warning(oss.str());
+    }
+
+    return parsed;
+}
+
+std::shared_ptr<const CookedObjFile> ObjFileCache::Cook(const std::filesystem::path &objFilePath,
+                                                        std::shared_ptr<const ParsedObjFile> parsed,
+                                                        const ObjLoadOptions &options,
+                                                        job::WorkStealingExecutor *executor)
+{
+    const size_t numShapes = parsed->shapes.size();
+
+    auto batch = std::make_shared<ShapeBatch>();
+    batch->parsed = std::move(parsed);
+    batch->options = options;
+    batch->shapes.resize(numShapes);
+
+    // shapes do not depend on each other, spread them over the executor while this thread cooks as well
+    const size_t numHelpers =
+        executor != nullptr && numShapes > 1 ? std::min<size_t>(numShapes - 1, executor->getNumThreads()) : 0;
+    for (size_t i = 0; i < numHelpers; i++)
+    {
+        executor->submit(job::WorkStealingExecutor::Job([batch]() { CookRemainingShapes(*batch); }),
+                         job::WorkStealingExecutor::Priority::Normal);
+    }
+
+    CookRemainingShapes(*batch);
+
+    // every shape has been claimed, wait for the ones still being cooked by the executor
+    for (size_t done = batch->numDone.load(std::memory_order_acquire); done != numShapes;
+         done = batch->numDone.load(std::memory_order_acquire))
+    {
+        batch->numDone.wait(done, std::memory_order_acquire);
+    }
+
+    if (batch->failure != nullptr)
+    {
+        std::rethrow_exception(batch->failure);
+    }
+
+    auto cooked = std::make_shared<CookedObjFile>();
+    cooked->shapes = std::move(batch->shapes);
+
+    size_t numSourceVerts = 0, numFinalVerts = 0, numCompactShapes = 0;
+    for (size_t i = 0; i < numShapes; i++)
+    {
+        numSourceVerts += batch->parsed->shapes[i].mesh.indices.size();
+        numFinalVerts += cooked->shapes[i].vertices.size();
+        numCompactShapes += cooked->shapes[i].compactIndices ? 1 : 0;
+    }
+
+    core::logging::info("Prepared mesh data for ", objFilePath.string(), " -- vertices: ", numSourceVerts, " -> ",
+                        numFinalVerts, ", shapes with 16 bit indices: ", numCompactShapes, "/", cooked->shapes.size());
+
+    return cooked;
+}
+
+void ObjFileCache::CookRemainingShapes(ShapeBatch &batch)
+{
+    const size_t numShapes = batch.shapes.size();
+    for (size_t i = batch.nextShape++; i < numShapes; i = batch.nextShape++)
+    {
+        try
+        {
+            batch.shapes[i] = CookShape(batch.parsed->attrib, batch.parsed->shapes[i], batch.options);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(batch.failureLock);
+            if (batch.failure == nullptr)
+            {
+                batch.failure = std::current_exception();
+            }
+        }
+
+        if (batch.numDone.fetch_add(1, std::memory_order_acq_rel) + 1 == numShapes)
+        {
+            batch.numDone.notify_all();
+        }
+    }
+}
+
+CookedObjShape ObjFileCache::CookShape(const tinyobj::attrib_t &attrib, const tinyobj::shape_t &shape,
+                                       const ObjLoadOptions &options)
+{
+    // tinyobj ensures three verticies per triangle  -- assuming unique vertices
+    const std::vector<tinyobj::index_t> &indicies = shape.mesh.indices;
+    CookedObjShape cookedShape;
+    cookedShape.vertices.reserve(indicies.size());
+    cookedShape.indices.reserve(indicies.size());
+
+    for (size_t faceIndex = 0; faceIndex < shape.mesh.material_ids.size(); faceIndex++)
+    {
+        for (size_t i = 0; i < 3; i++)
+        {
+            const auto &index = indicies[(3 * faceIndex) + i];
+            auto newVertex = Vertex();
+            newVertex.pos = glm::vec3{attrib.vertices[3 * index.vertex_index + 0],
+                                      attrib.vertices[3 * index.vertex_index + 1],
+                                      attrib.vertices[3 * index.vertex_index + 2]};
+            newVertex.color = glm::vec3{
+                attrib.colors[3 * index.vertex_index + 0],
+                attrib.colors[3 * index.vertex_index + 1],
+                attrib.colors[3 * index.vertex_index + 2],
+            };
+
+            if (attrib.normals.size() > 0)
+            {
+                newVertex.normal = {
+                    attrib.normals[3 * index.normal_index + 0],
+                    attrib.normals[3 * index.normal_index + 1],
+                    attrib.normals[3 * index.normal_index + 2],
+                };
+            }
+
+            newVertex.texCoord = {attrib.texcoords[2 * index.texcoord_index + 0],
+                                  1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
+
+            cookedShape.vertices.emplace_back(std::move(newVertex));
+            cookedShape.indices.emplace_back(
+                star::common::casts::size_t_to_unsigned_int(cookedShape.vertices.size() - 1));
+        }
+    }
+
+    if (options.deduplicateVertices)
+    {
+        GeometryHelpers::deduplicateVertices(cookedShape.vertices, cookedShape.indices);
+    }
+    if (options.optimizeVertexCache)
+    {
+        GeometryHelpers::optimizeVertexCacheOrder(cookedShape.vertices, cookedShape.indices);
+    }
+    if (options.packAdjacency)
+    {
+        GeometryHelpers::packTriangleAdjacency(cookedShape.vertices, cookedShape.indices);
+    }
+    if (options.allowCompactIndices && GeometryHelpers::canUseCompactIndices(cookedShape.vertices.size()))
+    {
+        cookedShape.compactIndices = true;
+    }
+
+    return cookedShape;
+}
+} // namespace star::object
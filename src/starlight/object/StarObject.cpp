@@ -11,6 +11,8 @@
 #include <glm/glm.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 std::unique_ptr<star::StarDescriptorSetLayout> star::StarObject::instanceDescriptorLayout =
     std::unique_ptr<star::StarDescriptorSetLayout>();
@@ -145,14 +147,22 @@ void star::StarObject::cleanupRender(core::device::DeviceContext &context)
     {
         material->cleanupRender(context);
     }
+
+    if (m_gpuCulling)
+    {
+        m_gpuCulling->cleanupRender(context);
+    }
 }
 
 star::Handle star::StarObject::buildPipeline(core::device::DeviceContext &context, vk::Extent2D swapChainExtent,
                                              vk::PipelineLayout pipelineLayout,
                                              core::renderer::RenderingTargetInfo renderInfo)
 {
+    StarPipeline::GraphicsPipelineConfigSettings settings;
+    settings.vertexLayout = getVertexLayout();
+
     return context.getPipelineManager().submit(core::device::manager::PipelineRequest(
-        StarPipeline(StarPipeline::GraphicsPipelineConfigSettings(), pipelineLayout,
+        StarPipeline(std::move(settings), pipelineLayout,
                      std::vector<Handle>{m_vertexShaderHandle, m_fragmentShaderHandle}),
         swapChainExtent, renderInfo));
 }
@@ -209,6 +219,10 @@ void star::StarObject::prepStarObject(core::device::DeviceContext &context)
 
         calculateBoundingBox(bbVerts, bbInds);
 
+        const std::array<glm::vec3, 2> localBounds = calculateLocalBounds();
+        m_localBoundsCenter = (localBounds[0] + localBounds[1]) * 0.5f;
+        m_localBoundsExtent = (localBounds[1] - localBounds[0]) * 0.5f;
+
         this->boundingBoxVertBuffer = ManagerRenderResource::addRequest(
             m_deviceID, std::make_unique<TransferRequest::VertInfo>(graphicsFamilyIndex, std::move(bbVerts)));
 
@@ -217,6 +231,28 @@ void star::StarObject::prepStarObject(core::device::DeviceContext &context)
     }
 
     prepareMeshes(context);
+
+    if (m_gpuCulling)
+    {
+        const uint8_t numFramesInFlight = context.frameTracker().getSetup().getNumFramesInFlight();
+
+        std::vector<Handle> modelHandles, normalHandles;
+        for (uint8_t i = 0; i < numFramesInFlight; i++)
+        {
+            modelHandles.push_back(m_instanceInfo.getControllerModel().getHandle(i));
+            normalHandles.push_back(m_instanceInfo.getControllerNormal().getHandle(i));
+        }
+
+        std::vector<vk::DrawIndexedIndirectCommand> draws;
+        draws.reserve(this->meshes.size());
+        for (const auto &mesh : this->meshes)
+        {
+            draws.emplace_back(mesh.getNumIndices(), 0, 0, 0, 0);
+        }
+
+        m_gpuCulling->prepRender(context, numFramesInFlight, modelHandles, normalHandles, std::move(draws),
+                                 m_instanceInfo.getSize());
+    }
 }
 
 star::core::renderer::RenderingContext star::StarObject::buildRenderingContext(
@@ -231,30 +267,70 @@ void star::StarObject::recordPreRenderPassCommands(vk::CommandBuffer &commandBuf
     if (!isKnownToBeReadyForRecordRender(swapChainIndexNum))
         return;
 
-    recordDependentDataPipelineBarriers(commandBuffer, swapChainIndexNum, frameIndex);
+    if (m_gpuCulling)
+    {
+        m_gpuCulling->recordCullCommands(commandBuffer, swapChainIndexNum, getNumDrawableInstances(swapChainIndexNum),
+                                         m_localBoundsCenter, m_localBoundsExtent);
+    }
 }
 
-void star::StarObject::recordRenderPassCommands(vk::CommandBuffer &commandBuffer, vk::PipelineLayout &pipelineLayout,
-                                                const uint8_t &swapChainIndexNum, const uint64_t &frameIndex)
+void star::StarObject::hashRecordState(core::renderer::RecordState &state, const uint8_t &frameInFlightIndex,
+                                       const uint64_t &frameIndex)
 {
-    if (!isKnownToBeReadyForRecordRender(swapChainIndexNum))
+    const bool isReady = isKnownToBeReadyForRecordRender(frameInFlightIndex);
+    state.add(isReady);
+    if (!isReady)
+        return;
+
+    if (m_gpuCulling)
+    {
+        m_gpuCulling->hashRecordState(state, frameInFlightIndex, getNumDrawableInstances(frameInFlightIndex),
+                                      m_localBoundsCenter, m_localBoundsExtent);
+    }
+}
+
+void star::StarObject::collectDraws(DrawList &drawList, const vk::PipelineLayout &pipelineLayout,
+                                    const uint8_t &frameInFlightIndex)
+{
+    if (!isKnownToBeReadyForRecordRender(frameInFlightIndex))
         return;
 
     assert(renderingContext.pipeline != nullptr && "Pipeline needs to be included in creating the rendering context");
 
-    renderingContext.pipeline->bind(commandBuffer);
+    uint32_t instanceCount = 0;
+    if (!m_gpuCulling)
+    {
+        star::common::casts::SafeCast<size_t, uint32_t>(getNumDrawableInstances(frameInFlightIndex), instanceCount);
+        if (instanceCount == 0)
+        {
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < this->meshes.size(); i++)
+    {
+        drawList.add(DrawList::Draw{.pipeline = renderingContext.pipeline,
+                                    .pipelineLayout = pipelineLayout,
+                                    .material = &this->meshes[i].getMaterial(),
+                                    .mesh = &this->meshes[i],
+                                    .instanceCount = instanceCount,
+                                    .gpuCulling = m_gpuCulling.get(),
+                                    .gpuDrawIndex = static_cast<uint32_t>(i),
+                                    .depth = m_sortDepth});
+    }
 
-    for (auto &rmesh : this->meshes)
+    if (this->drawNormals || this->drawBoundingBox)
     {
-        uint32_t instanceCount;
-        star::common::casts::SafeCast<size_t, uint32_t>(m_instanceInfo.getSize(), instanceCount);
-        rmesh.recordRenderPassCommands(commandBuffer, pipelineLayout, swapChainIndexNum, instanceCount);
+        drawList.addDebug(this);
     }
+}
 
+void star::StarObject::recordDebugCommands(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex)
+{
     if (this->drawNormals)
         recordDrawCommandNormals(commandBuffer);
     if (this->drawBoundingBox)
-        recordDrawCommandBoundingBox(commandBuffer, swapChainIndexNum);
+        recordDrawCommandBoundingBox(commandBuffer, frameInFlightIndex);
 }
 
 star::StarEntity &star::StarObject::createInstance()
@@ -274,7 +350,103 @@ void star::StarObject::frameUpdate(core::device::DeviceContext &context, const u
         renderingContext = buildRenderingContext(context);
 
         updateDependentData(context, frameInFlightIndex, targetCommandBuffer, transferReuqestSyncInfo);
+
+        if (m_gpuCulling)
+        {
+            m_gpuCulling->frameUpdate(context, frameInFlightIndex, getNumDrawableInstances(frameInFlightIndex));
+        }
+    }
+}
+
+star::CullingStats star::StarObject::cullInstances(const Frustum &frustum)
+{
+    const auto &instances = m_instanceInfo.getInstances();
+
+    if (m_gpuCulling)
+    {
+        // every instance stays in the buffers, the results only come back to the CPU when they are being checked
+        m_gpuCulling->setFrustum(frustum);
+        if (!m_gpuCulling->isValidating())
+        {
+            return CullingStats();
+        }
+    }
+
+    m_cullBoxes.resize(instances.size());
+    for (size_t i = 0; i < instances.size(); i++)
+    {
+        m_cullBoxes.set(i, instances[i].getDisplayMatrix(), m_localBoundsCenter, m_localBoundsExtent);
+    }
+
+    frustum.testBoxes(m_cullBoxes, m_cullResults);
+
+    if (m_gpuCulling)
+    {
+        const auto numVisible = static_cast<size_t>(
+            std::count_if(m_cullResults.begin(), m_cullResults.end(), [](const uint8_t &hit) { return hit != 0; }));
+        m_gpuCulling->setExpectedVisibleCount(numVisible);
+        return CullingStats();
     }
+
+    // visible instances are compacted to the front of the instance buffers in their original order
+    auto &visible = m_instanceInfo.getVisibleInstances();
+    visible.clear();
+    const glm::vec4 nearPlane = frustum.getPlanes()[Frustum::NearPlaneIndex];
+    float nearestDepth = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < m_cullResults.size(); i++)
+    {
+        if (m_cullResults[i] != 0)
+        {
+            visible.push_back(static_cast<uint32_t>(i));
+
+            const float depth = nearPlane.x * m_cullBoxes.centerX[i] + nearPlane.y * m_cullBoxes.centerY[i] +
+                                nearPlane.z * m_cullBoxes.centerZ[i] + nearPlane.w -
+                                (std::abs(nearPlane.x) * m_cullBoxes.extentX[i] +
+                                 std::abs(nearPlane.y) * m_cullBoxes.extentY[i] +
+                                 std::abs(nearPlane.z) * m_cullBoxes.extentZ[i]);
+            nearestDepth = std::min(nearestDepth, depth);
+        }
+    }
+    m_sortDepth = visible.empty() ? 0.0f : std::max(nearestDepth, 0.0f);
+
+    return CullingStats{.numTested = instances.size(), .numVisible = visible.size()};
+}
+
+void star::StarObject::enableGpuCulling(const uint32_t &maxInstances)
+{
+    assert(this->meshes.empty() && "GPU culling must be enabled before the object is prepared");
+
+    m_gpuCulling = std::make_unique<GpuCullingPass>(maxInstances);
+}
+
+std::vector<star::service::command_order::ResourceUse> star::StarObject::getResourceUses(
+    const uint8_t &numFramesInFlight) const
+{
+    std::vector<service::command_order::ResourceUse> uses;
+    for (uint8_t i = 0; i < numFramesInFlight; i++)
+    {
+        // instance data is uploaded by updateInstanceData between frames, gpu culling reads it before the draws do
+        for (const auto &handle :
+             {m_instanceInfo.getControllerModel().getHandle(i), m_instanceInfo.getControllerNormal().getHandle(i)})
+        {
+            uses.push_back(service::command_order::ResourceUse{
+                .resource = handle,
+                .type = service::command_order::ResourceUse::Type::buffer,
+                .stages = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader |
+                          vk::PipelineStageFlagBits2::eFragmentShader,
+                .access = vk::AccessFlagBits2::eShaderStorageRead,
+                .frameInFlightIndex = i,
+                .isUploaded = true});
+        }
+
+        if (m_gpuCulling)
+        {
+            const auto cullUses = m_gpuCulling->getResourceUses(i);
+            uses.insert(uses.end(), cullUses.begin(), cullUses.end());
+        }
+    }
+
+    return uses;
 }
 
 std::vector<std::shared_ptr<star::StarDescriptorSetLayout>> star::StarObject::getDescriptorSetLayouts(
@@ -285,8 +457,8 @@ std::vector<std::shared_ptr<star::StarDescriptorSetLayout>> star::StarObject::ge
 
     StarDescriptorSetLayout::Builder updateSetBuilder =
         StarDescriptorSetLayout::Builder()
-            .addBinding(0, vk::DescriptorType::eUniformBuffer, vk::ShaderStageFlagBits::eVertex)
-            .addBinding(1, vk::DescriptorType::eUniformBuffer, vk::ShaderStageFlagBits::eVertex);
+            .addBinding(0, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eVertex)
+            .addBinding(1, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eVertex);
     allSets.emplace_back(updateSetBuilder.build());
 
     assert(m_meshMaterials.size() > 0 && "Materials should always exist");
@@ -321,8 +493,17 @@ void star::StarObject::prepMaterials(star::core::device::DeviceContext &context,
 
         frameBuilder.startOnFrameIndex(i);
         frameBuilder.startSet();
-        frameBuilder.add(StarShaderInfo::BufferInfo{instanceModelHandle});
-        frameBuilder.add(StarShaderInfo::BufferInfo{instanceNormalHandle});
+        if (m_gpuCulling)
+        {
+            // drawing reads the instances compacted by the cull pass, in the same layout as the instance buffers
+            frameBuilder.add(StarShaderInfo::BufferInfo{m_gpuCulling->getVisibleModels(i)});
+            frameBuilder.add(StarShaderInfo::BufferInfo{m_gpuCulling->getVisibleNormals(i)});
+        }
+        else
+        {
+            frameBuilder.add(StarShaderInfo::BufferInfo{instanceModelHandle});
+            frameBuilder.add(StarShaderInfo::BufferInfo{instanceNormalHandle});
+        }
     }
 
     for (auto &material : m_meshMaterials)
@@ -336,35 +517,32 @@ void star::StarObject::createInstanceBuffers(star::core::device::DeviceContext &
 {
     assert(m_instanceInfo.getSize() > 0 &&
            "Call to create instance buffers made but this object does not have any instances");
-    assert(m_instanceInfo.getSize() < 1024 && "Max number of supported instances is 1024");
 
     m_instanceInfo.prepRender(context, context.frameTracker().getSetup().getNumFramesInFlight());
 }
 
 void star::StarObject::createBoundingBox(std::vector<Vertex> &verts, std::vector<uint32_t> &inds)
 {
+    const std::array<glm::vec3, 2> bbBounds = calculateLocalBounds();
+
+    star::GeometryHelpers::calculateAxisAlignedBoundingBox(bbBounds[0], bbBounds[1], verts, inds, true);
+}
+
+std::array<glm::vec3, 2> star::StarObject::calculateLocalBounds() const
+{
+    assert(this->meshes.size() > 0 && "This function must be called after meshes are loaded");
+
     std::array<glm::vec3, 2> bbBounds = this->meshes.front().getBoundingBoxCoords();
 
     for (size_t i = 1; i < this->meshes.size(); i++)
     {
-        std::array<glm::vec3, 2> curbbBounds = this->meshes.at(i).getBoundingBoxCoords();
-
-        if (curbbBounds[0].x < bbBounds[0].x)
-            bbBounds[0].x = curbbBounds[0].x;
-        if (curbbBounds[0].y < bbBounds[0].y)
-            bbBounds[0].y = curbbBounds[0].y;
-        if (curbbBounds[0].z < curbbBounds[0].z)
-            bbBounds[0].z = curbbBounds[0].z;
-
-        if (curbbBounds[1].x > bbBounds[1].x)
-            bbBounds[1].x = curbbBounds[1].x;
-        if (curbbBounds[1].y > bbBounds[1].y)
-            bbBounds[1].y = curbbBounds[1].y;
-        if (curbbBounds[1].z > bbBounds[1].z)
-            bbBounds[1].z = curbbBounds[1].z;
+        const std::array<glm::vec3, 2> curbbBounds = this->meshes.at(i).getBoundingBoxCoords();
+
+        bbBounds[0] = glm::min(bbBounds[0], curbbBounds[0]);
+        bbBounds[1] = glm::max(bbBounds[1], curbbBounds[1]);
     }
 
-    star::GeometryHelpers::calculateAxisAlignedBoundingBox(bbBounds[0], bbBounds[1], verts, inds, true);
+    return bbBounds;
 }
 
 void star::StarObject::recordDrawCommandNormals(vk::CommandBuffer &commandBuffer)
@@ -441,6 +619,10 @@ bool star::StarObject::isRenderReady(core::device::DeviceContext &context)
     {
         return false;
     }
+    if (m_gpuCulling && !m_gpuCulling->isRenderReady(context))
+    {
+        return false;
+    }
     for (size_t i{0}; i < meshes.size(); i++)
     {
         if (!meshes[i].isKnownToBeReady(context.frameTracker().getCurrent().getFrameInFlightIndex()))
@@ -463,21 +645,18 @@ void star::StarObject::updateInstanceData(core::device::DeviceContext &context,
                                           const Handle &targetCommandBuffer,
                                           const star::core::graphics::SemaphoreInfo &transferReuqestSyncInfo)
 {
-    bool updateInstanceModel = false, updateInstanceNormal = false;
-
     CommandBufferContainer::CompleteRequest &request =
         context.getManagerCommandBuffer().m_manager.get(targetCommandBuffer);
 
     {
         const auto [submitted, semaphore] = m_instanceInfo.getControllerModel().submitUpdateIfNeeded(
             context, frameInFlightIndex, transferReuqestSyncInfo);
-        if (submitted)
+        if (submitted && semaphore != nullptr)
         {
-            updateInstanceModel = true;
-
             request.oneTimeWaitSemaphoreInfo.insert(
                 m_instanceInfo.getControllerModel().getHandle(frameInFlightIndex), semaphore->vkSemaphore,
-                vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader,
+                vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eVertexShader |
+                    vk::PipelineStageFlagBits::eFragmentShader,
                 semaphore->signalValue);
         }
     }
@@ -485,28 +664,15 @@ void star::StarObject::updateInstanceData(core::device::DeviceContext &context,
     {
         const auto [submitted, semaphore] = m_instanceInfo.getControllerNormal().submitUpdateIfNeeded(
             context, frameInFlightIndex, transferReuqestSyncInfo);
-        if (submitted)
+        if (submitted && semaphore != nullptr)
         {
-            updateInstanceNormal = true;
-
             request.oneTimeWaitSemaphoreInfo.insert(
                 m_instanceInfo.getControllerNormal().getHandle(frameInFlightIndex), semaphore->vkSemaphore,
-                vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader,
+                vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eVertexShader |
+                    vk::PipelineStageFlagBits::eFragmentShader,
                 semaphore->signalValue);
         }
     }
-
-    if (updateInstanceNormal)
-    {
-        renderingContext.addBufferToRenderingContext(
-            context, m_instanceInfo.getControllerNormal().getHandle(frameInFlightIndex));
-    }
-
-    if (updateInstanceModel)
-    {
-        renderingContext.addBufferToRenderingContext(context,
-                                                     m_instanceInfo.getControllerModel().getHandle(frameInFlightIndex));
-    }
 }
 
 bool star::StarObject::isKnownToBeReadyForRecordRender(const uint8_t &frameInFlightIndex)
@@ -527,48 +693,13 @@ bool star::StarObject::isKnownToBeReadyForRecordRender(const uint8_t &frameInFli
     return true;
 }
 
-void star::StarObject::recordDependentDataPipelineBarriers(vk::CommandBuffer &commandBuffer,
-                                                           const uint8_t &frameInFlightIndex,
-                                                           const uint64_t &frameIndex)
+size_t star::StarObject::getNumDrawableInstances(const uint8_t &frameInFlightIndex)
 {
-    auto barriers = std::vector<vk::BufferMemoryBarrier2>();
+    const auto &modelBuffer =
+        ManagerRenderResource::getBuffer(m_deviceID, m_instanceInfo.getControllerModel().getHandle(frameInFlightIndex));
+    const auto &normalBuffer = ManagerRenderResource::getBuffer(
+        m_deviceID, m_instanceInfo.getControllerNormal().getHandle(frameInFlightIndex));
 
-    if (m_instanceInfo.getControllerModel().willBeUpdatedThisFrame(frameIndex, frameInFlightIndex))
-    {
-        barriers.emplace_back(
-            vk::BufferMemoryBarrier2()
-                .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
-                .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
-                .setDstStageMask(vk::PipelineStageFlagBits2::eVertexShader |
-                                 vk::PipelineStageFlagBits2::eFragmentShader)
-                .setDstAccessMask(vk::AccessFlagBits2::eUniformRead | vk::AccessFlagBits2::eShaderRead)
-                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
-                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
-                .setBuffer(renderingContext.bufferTransferRecords.get(
-                    m_instanceInfo.getControllerModel().getHandle(frameInFlightIndex)))
-                .setSize(vk::WholeSize));
-    }
-
-    if (m_instanceInfo.getControllerNormal().willBeUpdatedThisFrame(frameIndex, frameInFlightIndex))
-    {
-        barriers.emplace_back(
-            vk::BufferMemoryBarrier2()
-                .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
-                .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
-                .setDstStageMask(vk::PipelineStageFlagBits2::eVertexShader |
-                                 vk::PipelineStageFlagBits2::eFragmentShader)
-                .setDstAccessMask(vk::AccessFlagBits2::eUniformRead | vk::AccessFlagBits2::eShaderRead)
-                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
-                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
-                .setBuffer(renderingContext.bufferTransferRecords.get(
-                    m_instanceInfo.getControllerNormal().getHandle(frameInFlightIndex)))
-                .setSize(vk::WholeSize));
-    }
-
-    if (barriers.size() > 0)
-    {
-        commandBuffer.pipelineBarrier2(vk::DependencyInfo()
-                                           .setBufferMemoryBarrierCount(barriers.size())
-                                           .setPBufferMemoryBarriers(barriers.data()));
-    }
+    return std::min<size_t>(
+        {m_instanceInfo.getNumVisible(), modelBuffer.getInstanceCount(), normalBuffer.getInstanceCount()});
 }
\ No newline at end of file
@@ -1,20 +1,29 @@
 #include "starlight/service/CommandOrderService.hpp"
 
+#include "starlight/core/Exceptions.hpp"
+
 #include <starlight/command/frames/GetFrameTracker.hpp>
+#include <star_common/helper/CastHelpers.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
 
 namespace star::service
 {
 CommandOrderService::CommandOrderService()
-    : m_passes(), m_listenForDeclareDependency(*this), m_listenForDeclarePass(*this), m_listenForTriggerPass(*this),
-      m_listenForGetPassInfo(*this), m_listenForInitPhaseComplete(*this), m_listenForStartOfNextFrame(*this)
+    : m_passes(), m_listenForDeclareDependency(*this), m_listenForDeclarePass(*this),
+      m_listenForDeclareResourceUse(*this), m_listenForTriggerPass(*this), m_listenForGetPassInfo(*this),
+      m_listenForInitPhaseComplete(*this), m_listenForStartOfNextFrame(*this)
 {
 }
 
 CommandOrderService::CommandOrderService(CommandOrderService &&other)
     : m_passes(std::move(other.m_passes)), m_listenForDeclareDependency(*this), m_listenForDeclarePass(*this),
-      m_listenForTriggerPass(*this), m_listenForGetPassInfo(*this), m_listenForInitPhaseComplete(*this),
-      m_listenForStartOfNextFrame(*this), m_cmdBus(other.m_cmdBus), m_evtBus(other.m_evtBus), m_ft(other.m_ft),
-      m_sem(other.m_sem)
+      m_listenForDeclareResourceUse(*this), m_listenForTriggerPass(*this), m_listenForGetPassInfo(*this),
+      m_listenForInitPhaseComplete(*this), m_listenForStartOfNextFrame(*this), m_cmdBus(other.m_cmdBus),
+      m_evtBus(other.m_evtBus), m_ft(other.m_ft), m_sem(other.m_sem), m_cmdBufferManager(other.m_cmdBufferManager)
 {
     if (m_cmdBus != nullptr && m_evtBus != nullptr)
     {
@@ -35,6 +44,7 @@ CommandOrderService &CommandOrderService::operator=(CommandOrderService &&other)
         m_evtBus = other.m_evtBus;
         m_ft = other.m_ft;
         m_sem = other.m_sem;
+        m_cmdBufferManager = other.m_cmdBufferManager;
 
         if (m_cmdBus != nullptr && m_evtBus != nullptr)
         {
@@ -68,6 +78,7 @@ void CommandOrderService::setInitParameters(star::service::InitParameters &param
     m_cmdBus = &params.commandBus;
     m_evtBus = &params.eventBus;
     m_sem = params.graphicsManagers.semaphoreManager.get();
+    m_cmdBufferManager = &params.commandBufferManager;
 
     star::frames::GetFrameTracker ftCmd{};
     m_cmdBus->submit(ftCmd);
@@ -89,6 +100,8 @@ void CommandOrderService::onDeclareDependency(star::command_order::DeclareDepend
     assert(m_passes.contains(cmd.getSrc()) && m_passes.contains(cmd.getDep()));
 
     addEdgeRecord(cmd.getSrc(), cmd.getDep());
+    m_declaredEdges.emplace_back(command_order::EdgeDescription{.producer = cmd.getSrc(), .consumer = cmd.getDep()});
+    m_isDirty = true;
 }
 
 void CommandOrderService::onDeclarePass(star::command_order::DeclarePass &cmd)
@@ -97,10 +110,24 @@ void CommandOrderService::onDeclarePass(star::command_order::DeclarePass &cmd)
     const uint32_t queueFamilyIndex = cmd.getQueueFamily();
     auto mem = std::vector<bool>(m_ft->getSetup().getNumFramesInFlight(), false);
 
-    m_passes.insert(std::make_pair(
-        passHandle, PassDescription{.queueFamilyIndex = queueFamilyIndex, .wasProcessedOnLastFrame = std::move(mem)}));
+    uint32_t declarationIndex = 0;
+    star::common::casts::SafeCast<size_t, uint32_t>(m_passes.size(), declarationIndex);
 
-    m_notTriggeredPasses.emplace_back(passHandle);
+    m_passes.insert(std::make_pair(passHandle, PassDescription{.queueFamilyIndex = queueFamilyIndex,
+                                                               .wasProcessedOnLastFrame = std::move(mem),
+                                                               .declarationIndex = declarationIndex,
+                                                               .orderIndex = declarationIndex}));
+    m_isDirty = true;
+}
+
+void CommandOrderService::onDeclareResourceUse(star::command_order::DeclareResourceUse &cmd)
+{
+    auto pass = m_passes.find(cmd.getPassHandle());
+    assert(pass != m_passes.end() && "Resource use must be declared for a pass which has been declared");
+    assert(cmd.getUse().resource.isInitialized() && "Resource use must name a resource");
+
+    pass->second.uses.push_back(cmd.getUse());
+    m_isDirty = true;
 }
 
 void CommandOrderService::onInitEnginePhaseComplete(const star::event::EnginePhaseComplete &event, bool &keepAlive)
@@ -122,77 +149,83 @@ void CommandOrderService::onTriggerPass(star::command_order::TriggerPass &cmd)
     assert(cmd.description.passDefinition.isInitialized() && "No handle was provided to TriggerPass command");
     assert(m_passes.contains(cmd.description.passDefinition) && "Pass handle is not valid");
 
-    Handle passHandle = cmd.description.passDefinition;
-    m_triggeredPasses.emplace_back(std::move(cmd.description));
-
-    removeElementFromNotTriggeredPasses(passHandle);
+    m_passes[cmd.description.passDefinition].trigger = std::move(cmd.description);
 }
 
 void CommandOrderService::onStartOfNextFrame(const event::StartOfNextFrame &event, bool &keepAlive)
 {
     assert(m_ft != nullptr);
 
-    for (size_t i{0}; i < m_notTriggeredPasses.size(); i++)
+    for (auto &[handle, pass] : m_passes)
     {
-        m_passes[m_notTriggeredPasses[i]].wasProcessedOnLastFrame[m_lastFrameInFlightIndex] = false;
-    }
+        pass.wasProcessedOnLastFrame[m_lastFrameInFlightIndex] = pass.trigger.has_value();
+        if (!pass.trigger.has_value())
+        {
+            continue;
+        }
 
-    for (auto &record : m_triggeredPasses)
-    {
         // update semaphore manager records for timeilnes
+        const auto &record = pass.trigger.value();
         if (std::holds_alternative<command_order::TriggerDescription::TimelineSemaphore>(record.semaphoreInfo))
         {
             const auto &rec = std::get<command_order::TriggerDescription::TimelineSemaphore>(record.semaphoreInfo);
             m_sem->get(rec.record)->timelineValue.value() = rec.signalValue;
         }
+        pass.trigger.reset();
+    }
 
-        m_passes[record.passDefinition].wasProcessedOnLastFrame[m_lastFrameInFlightIndex] = true;
-        m_notTriggeredPasses.emplace_back(record.passDefinition);
+    // the previous frame is done asking for pass info, so the compiled records can be replaced
+    if (m_isDirty && m_currentPhase == Phase::Compiled)
+    {
+        compileOrder();
     }
 
-    m_triggeredPasses.clear();
     m_lastFrameInFlightIndex = m_ft->getCurrent().getFrameInFlightIndex();
     keepAlive = true;
 }
 
 void CommandOrderService::onGetPassInfo(star::command_order::GetPassInfo &cmd)
 {
-    assert(m_passes.contains(*cmd.pass) && "Provided pass does not exist");
+    auto pass = m_passes.find(*cmd.pass);
+    assert(pass != m_passes.end() && "Provided pass does not exist");
+    const auto &info = pass->second;
 
     bool isTriggered = false;
     vk::Semaphore signaledSemaphore{VK_NULL_HANDLE};
     uint64_t signaledValue{0};
     uint64_t currentSignalValue{0};
 
-    for (const auto &triggered : m_triggeredPasses)
+    if (info.trigger.has_value())
     {
-        if (triggered.passDefinition == *cmd.pass)
+        const auto &triggered = info.trigger.value();
+        if (std::holds_alternative<command_order::TriggerDescription::TimelineSemaphore>(triggered.semaphoreInfo))
         {
-            if (std::holds_alternative<command_order::TriggerDescription::TimelineSemaphore>(triggered.semaphoreInfo))
-            {
-                const auto &r = std::get<command_order::TriggerDescription::TimelineSemaphore>(triggered.semaphoreInfo);
-                const auto *sr = m_sem->get(r.record);
+            const auto &r = std::get<command_order::TriggerDescription::TimelineSemaphore>(triggered.semaphoreInfo);
+            const auto *sr = m_sem->get(r.record);
 
-                assert(sr != nullptr && "Failed to obtain semaphore record from manager");
-                signaledSemaphore = sr->semaphore;
-                assert(sr->timelineValue.has_value() &&
-                       "Stored timeline record does not have a timeline value implying that it is a binary semaphore");
-
-                signaledValue = r.signalValue;
-                currentSignalValue = sr->timelineValue.value();
-            }
-            else
-            {
-                const auto &r = std::get<command_order::TriggerDescription::BinarySemaphore>(triggered.semaphoreInfo);
-                signaledSemaphore = r.semaphore;
-            }
+            assert(sr != nullptr && "Failed to obtain semaphore record from manager");
+            signaledSemaphore = sr->semaphore;
+            assert(sr->timelineValue.has_value() &&
+                   "Stored timeline record does not have a timeline value implying that it is a binary semaphore");
 
-            isTriggered = true;
-            break;
+            signaledValue = r.signalValue;
+            currentSignalValue = sr->timelineValue.value();
         }
+        else
+        {
+            const auto &r = std::get<command_order::TriggerDescription::BinarySemaphore>(triggered.semaphoreInfo);
+            signaledSemaphore = r.semaphore;
+        }
+
+        isTriggered = true;
     }
 
-    const auto &info = m_passes[*cmd.pass];
+    // ownership released by the previous use of this frame in flight can only be acquired once that use was recorded
+    // from the current graph
+    const bool hasReleasedFromLastFrame =
+        m_ft->getCurrent().getGlobalFrameCounter() >= m_compiledOnFrame + m_ft->getSetup().getNumFramesInFlight();
+
+    auto edges = m_edges.find(*cmd.pass);
     cmd.getReply().set(star::command_order::get_pass_info::GatheredPassInfo{
         .signaledSemaphore = std::move(signaledSemaphore),
         .toSignalValue = std::move(signaledValue),
@@ -200,13 +233,18 @@ void CommandOrderService::onGetPassInfo(star::command_order::GetPassInfo &cmd)
         .isTriggeredThisFrame = isTriggered,
         .queueFamilyIndex = &info.queueFamilyIndex,
         .wasProcessedOnLastFrame = &info.wasProcessedOnLastFrame,
-        .edges = m_edges.contains(*cmd.pass) ? &m_edges[*cmd.pass] : nullptr});
+        .edges = edges != m_edges.end() ? &edges->second : nullptr,
+        .orderIndex = info.orderIndex,
+        .isCulled = info.isCulled,
+        .acquireTransitions = hasReleasedFromLastFrame ? &info.acquireTransitions : &info.firstFramesAcquireTransitions,
+        .releaseTransitions = &info.releaseTransitions});
 }
 
 void CommandOrderService::initListeners(core::CommandBus &cmdBus)
 {
     m_listenForDeclareDependency.init(cmdBus);
     m_listenForDeclarePass.init(cmdBus);
+    m_listenForDeclareResourceUse.init(cmdBus);
     m_listenForTriggerPass.init(cmdBus);
     m_listenForGetPassInfo.init(cmdBus);
 }
@@ -221,6 +259,7 @@ void CommandOrderService::cleanupListeners(core::CommandBus &cmdBus)
 {
     m_listenForDeclareDependency.cleanup(cmdBus);
     m_listenForDeclarePass.cleanup(cmdBus);
+    m_listenForDeclareResourceUse.cleanup(cmdBus);
     m_listenForTriggerPass.cleanup(cmdBus);
     m_listenForGetPassInfo.cleanup(cmdBus);
 }
@@ -233,23 +272,328 @@ void CommandOrderService::cleanupListeners(common::EventBus &evtBus)
 
 void CommandOrderService::compileOrder()
 {
-    assert(m_currentPhase != Phase::Compiled && "Cannot be compiled more than once");
+    // edges from each pass to the passes which must complete before it
+    absl::flat_hash_map<Handle, std::vector<Handle>, star::HandleHash> producers;
+    for (const auto &edge : m_declaredEdges)
+    {
+        producers[edge.consumer].push_back(edge.producer);
+    }
 
+    {
+        struct ResourceUsers
+        {
+            std::vector<std::pair<uint32_t, Handle>> writers;
+            std::vector<std::pair<uint32_t, Handle>> readers;
+        };
+        absl::flat_hash_map<Handle, ResourceUsers, star::HandleHash> resources;
+        for (const auto &[handle, pass] : m_passes)
+        {
+            for (const auto &use : pass.uses)
+            {
+                auto &users = resources[use.resource];
+                (use.isWrite() ? users.writers : users.readers).emplace_back(pass.declarationIndex, handle);
+            }
+        }
+
+        // writers follow each other in declaration order and every reader follows the last of them
+        for (auto &[resource, users] : resources)
+        {
+            std::sort(users.writers.begin(), users.writers.end(),
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+            for (size_t i = 1; i < users.writers.size(); i++)
+            {
+                if (users.writers[i - 1].second != users.writers[i].second)
+                {
+                    producers[users.writers[i].second].push_back(users.writers[i - 1].second);
+                }
+            }
+
+            if (users.writers.empty())
+            {
+                continue;
+            }
+            for (const auto &reader : users.readers)
+            {
+                if (reader.second != users.writers.back().second)
+                {
+                    producers[reader.second].push_back(users.writers.back().second);
+                }
+            }
+        }
+    }
+
+    sortPasses(producers);
+    cullPasses(producers);
+
+    m_edges.clear();
+    for (const auto &edge : m_declaredEdges)
+    {
+        addEdgeRecord(edge.producer, edge.consumer);
+    }
+    deriveTransitions();
+
+    m_compiledOnFrame = m_ft->getCurrent().getGlobalFrameCounter();
     m_currentPhase = Phase::Compiled;
+    m_isDirty = false;
 }
 
-void CommandOrderService::removeElementFromNotTriggeredPasses(const Handle &handle)
+void CommandOrderService::sortPasses(
+    const absl::flat_hash_map<Handle, std::vector<Handle>, star::HandleHash> &producers)
 {
-    size_t index = 0;
-    for (size_t i{0}; i < m_notTriggeredPasses.size(); i++)
+    std::vector<Handle> byDeclaration(m_passes.size());
+    for (const auto &[handle, pass] : m_passes)
     {
-        if (m_notTriggeredPasses[i] == handle)
+        byDeclaration[pass.declarationIndex] = handle;
+    }
+
+    absl::flat_hash_map<Handle, std::vector<Handle>, star::HandleHash> consumers;
+    absl::flat_hash_map<Handle, size_t, star::HandleHash> numWaitingOn;
+    for (const auto &[consumer, passProducers] : producers)
+    {
+        numWaitingOn[consumer] = passProducers.size();
+        for (const auto &producer : passProducers)
         {
-            index = i;
-            break;
+            consumers[producer].push_back(consumer);
         }
     }
-    m_notTriggeredPasses.erase(m_notTriggeredPasses.begin() + static_cast<std::ptrdiff_t>(index));
+
+    // among the passes which are ready, the one in the earliest submission slot goes next and the one declared first
+    // breaks the remaining ties so that the order is stable
+    using ReadyPass = std::pair<uint32_t, uint32_t>;
+    const auto toReady = [&](const Handle &handle) {
+        return ReadyPass{getSubmissionSlot(handle).value_or(0), m_passes[handle].declarationIndex};
+    };
+    std::priority_queue<ReadyPass, std::vector<ReadyPass>, std::greater<ReadyPass>> ready;
+    for (const auto &handle : byDeclaration)
+    {
+        if (!numWaitingOn.contains(handle))
+        {
+            ready.push(toReady(handle));
+        }
+    }
+
+    m_order.clear();
+    while (!ready.empty())
+    {
+        const Handle handle = byDeclaration[ready.top().second];
+        ready.pop();
+
+        auto &pass = m_passes[handle];
+        star::common::casts::SafeCast<size_t, uint32_t>(m_order.size(), pass.orderIndex);
+        m_order.push_back(handle);
+
+        auto passConsumers = consumers.find(handle);
+        if (passConsumers == consumers.end())
+        {
+            continue;
+        }
+        for (const auto &consumer : passConsumers->second)
+        {
+            if (--numWaitingOn[consumer] == 0)
+            {
+                ready.push(toReady(consumer));
+            }
+        }
+    }
+
+    if (m_order.size() != m_passes.size())
+    {
+        STAR_THROW("Declared passes contain a dependency cycle and cannot be ordered");
+    }
+
+    // command buffers are submitted by their slots, and the barriers are derived from this order, so a pass may not
+    // depend on one which is submitted after it
+    std::optional<uint32_t> lastSlot = std::nullopt;
+    for (const auto &handle : m_order)
+    {
+        const auto slot = getSubmissionSlot(handle);
+        if (!slot.has_value())
+        {
+            continue;
+        }
+        if (lastSlot.has_value() && slot.value() < lastSlot.value())
+        {
+            STAR_THROW("Declared resource uses require command buffer " + std::to_string(handle.getID()) +
+                       " to follow a command buffer submitted after it. Move the buffers to submission slots which "
+                       "match their dependencies");
+        }
+        lastSlot = slot;
+    }
+}
+
+std::optional<uint32_t> CommandOrderService::getSubmissionSlot(const Handle &pass) const
+{
+    if (m_cmdBufferManager == nullptr ||
+        pass.getType() != common::HandleTypeRegistry::instance().getTypeGuaranteedExist(
+                              common::special_types::CommandBufferTypeName))
+    {
+        return std::nullopt;
+    }
+
+    const auto &request = m_cmdBufferManager->get(pass);
+    constexpr uint32_t numSubOrders = static_cast<uint32_t>(Command_Buffer_Order_Index::fifth) + 1;
+    return static_cast<uint32_t>(request.order) * numSubOrders + static_cast<uint32_t>(request.subOrder);
+}
+
+void CommandOrderService::cullPasses(
+    const absl::flat_hash_map<Handle, std::vector<Handle>, star::HandleHash> &producers)
+{
+    // passes which declare nothing about their resources cannot be judged and are always kept
+    for (auto &[handle, pass] : m_passes)
+    {
+        pass.isCulled = !pass.uses.empty() && std::none_of(pass.uses.begin(), pass.uses.end(),
+                                                           [](const auto &use) { return use.isExternal; });
+    }
+
+    // consumers come after their producers, so walking backwards reaches every consumer first
+    for (auto handle = m_order.rbegin(); handle != m_order.rend(); handle++)
+    {
+        auto passProducers = producers.find(*handle);
+        if (m_passes[*handle].isCulled || passProducers == producers.end())
+        {
+            continue;
+        }
+        for (const auto &producer : passProducers->second)
+        {
+            m_passes[producer].isCulled = false;
+        }
+    }
+
+    if (m_cmdBufferManager == nullptr)
+    {
+        return;
+    }
+
+    const auto commandBufferType = common::HandleTypeRegistry::instance().getTypeGuaranteedExist(
+        common::special_types::CommandBufferTypeName);
+    for (const auto &[handle, pass] : m_passes)
+    {
+        // passes are usually declared with the handle of the command buffer recording them
+        if (handle.getType() == commandBufferType)
+        {
+            m_cmdBufferManager->get(handle).isCulled = pass.isCulled;
+        }
+    }
+}
+
+void CommandOrderService::deriveTransitions()
+{
+    struct OrderedUse
+    {
+        Handle pass;
+        command_order::ResourceUse use;
+    };
+
+    absl::flat_hash_map<Handle, std::vector<OrderedUse>, star::HandleHash> resources;
+    for (const auto &handle : m_order)
+    {
+        auto &pass = m_passes[handle];
+        pass.acquireTransitions.clear();
+        pass.releaseTransitions.clear();
+        if (pass.isCulled)
+        {
+            continue;
+        }
+
+        for (const auto &use : pass.uses)
+        {
+            auto &uses = resources[use.resource];
+            if (!uses.empty() && uses.back().pass == handle)
+            {
+                // several uses of a resource within one pass act as one
+                assert(uses.back().use.layout == use.layout && "A pass can only use an image in one layout");
+                uses.back().use.stages |= use.stages;
+                uses.back().use.access |= use.access;
+                uses.back().use.isExternal |= use.isExternal;
+                uses.back().use.isUploaded |= use.isUploaded;
+                uses.back().use.discardsContents &= use.discardsContents;
+                continue;
+            }
+            uses.push_back(OrderedUse{.pass = handle, .use = use});
+        }
+    }
+
+    for (const auto &[resource, uses] : resources)
+    {
+        for (size_t i = 0; i < uses.size(); i++)
+        {
+            // the first use of a frame follows the last use of the frame before
+            const bool wrapsFrame = i == 0;
+            const OrderedUse &previous = uses[wrapsFrame ? uses.size() - 1 : i - 1];
+            const OrderedUse &current = uses[i];
+
+            const bool isImage = current.use.type == command_order::ResourceUse::Type::image;
+            const bool waitsOnUpload = wrapsFrame && current.use.isUploaded;
+            if (!waitsOnUpload && !previous.use.isWrite() && !current.use.isWrite() &&
+                (!isImage || previous.use.layout == current.use.layout))
+            {
+                continue;
+            }
+
+            command_order::ResourceTransition transition{
+                .resource = resource,
+                .type = current.use.type,
+                .srcStages = previous.use.stages,
+                .srcAccess = previous.use.isWrite() ? previous.use.access : vk::AccessFlagBits2::eNone,
+                .dstStages = current.use.stages,
+                .dstAccess = current.use.access,
+                .oldLayout = isImage && !(wrapsFrame && current.use.discardsContents) ? previous.use.layout
+                                                                                     : vk::ImageLayout::eUndefined,
+                .newLayout = isImage ? current.use.layout : vk::ImageLayout::eUndefined,
+                .aspect = current.use.aspect,
+                .frameInFlightIndex = current.use.frameInFlightIndex};
+
+            if (waitsOnUpload)
+            {
+                // uploads between frames are ordered by semaphores, their writes still need to be made visible
+                transition.srcStages |= vk::PipelineStageFlagBits2::eTransfer;
+                transition.srcAccess |= vk::AccessFlagBits2::eTransferWrite;
+            }
+
+            const uint32_t srcFamily = m_passes[previous.pass].queueFamilyIndex;
+            const uint32_t dstFamily = m_passes[current.pass].queueFamilyIndex;
+            if (srcFamily != dstFamily && !(wrapsFrame && current.use.discardsContents))
+            {
+                // ownership moves with a release on the producing queue and an acquire on the consuming one, which
+                // must be ordered by a semaphore. Between frames that is the wait on the last submission of the frame
+                // in flight, which only orders resources owned by a single frame in flight.
+                if (wrapsFrame && !current.use.frameInFlightIndex.has_value())
+                {
+                    STAR_THROW("A resource shared by every frame in flight changes queue family between frames. "
+                               "Declare one resource per frame in flight or discard its contents on its first use");
+                }
+
+                transition.srcQueueFamilyIndex = srcFamily;
+                transition.dstQueueFamilyIndex = dstFamily;
+
+                auto release = transition;
+                release.dstStages = vk::PipelineStageFlagBits2::eNone;
+                release.dstAccess = vk::AccessFlagBits2::eNone;
+                m_passes[previous.pass].releaseTransitions.push_back(release);
+
+                transition.srcStages = vk::PipelineStageFlagBits2::eNone;
+                transition.srcAccess = vk::AccessFlagBits2::eNone;
+                transition.isFromLastFrame = wrapsFrame;
+
+                const auto &existing = m_edges[previous.pass];
+                if (!wrapsFrame && std::none_of(existing.begin(), existing.end(),
+                                                [&](const auto &edge) { return edge.consumer == current.pass; }))
+                {
+                    addEdgeRecord(previous.pass, current.pass);
+                }
+            }
+
+            m_passes[current.pass].acquireTransitions.push_back(transition);
+        }
+    }
+
+    for (auto &[handle, pass] : m_passes)
+    {
+        pass.firstFramesAcquireTransitions.clear();
+        std::copy_if(pass.acquireTransitions.begin(), pass.acquireTransitions.end(),
+                     std::back_inserter(pass.firstFramesAcquireTransitions),
+                     [](const auto &transition) { return !transition.isFromLastFrame; });
+    }
 }
 
 void CommandOrderService::addEdgeRecord(const Handle &producer, const Handle &consumer)
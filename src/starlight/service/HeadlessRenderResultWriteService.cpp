@@ -1,5 +1,7 @@
 #include "starlight/service/HeadlessRenderResultWriteService.hpp"
 
+#include "starlight/command/GetScreenCaptureSyncInfo.hpp"
+#include "starlight/command/command_order/DeclareResourceUse.hpp"
 #include "starlight/command/frames/GetFrameTracker.hpp"
 #include "starlight/common/helpers/FileHelpers.hpp"
 #include "starlight/core/logging/LoggingFactory.hpp"
@@ -30,16 +32,18 @@ static void CheckAndCreateImageDir(const std::filesystem::path &dir)
 
 star::service::HeadlessRenderResultWriteService::HeadlessRenderResultWriteService()
     : m_outputDir(), m_screenshotRegistrations(), GraphicsListen(*this), m_renderReady(*this),
-      m_triggerCapturePolicy(*this), m_listenForGetFileNamePolicy(*this), m_listenForSetOutput(*this)
+      m_triggerCapturePolicy(*this), m_listenForLoadComplete(*this), m_listenForGetFileNamePolicy(*this),
+      m_listenForSetOutput(*this)
 {
 }
 
 star::service::HeadlessRenderResultWriteService::HeadlessRenderResultWriteService(
     HeadlessRenderResultWriteService &&other) noexcept
     : m_outputDir(std::move(other.m_outputDir)), m_screenshotRegistrations(std::move(other.m_screenshotRegistrations)),
-      GraphicsListen(*this), m_renderReady(*this), m_triggerCapturePolicy(*this), m_listenForGetFileNamePolicy(*this),
-      m_listenForSetOutput(*this), m_eventBus(other.m_eventBus), m_cmdBus(other.m_cmdBus),
-      m_frameTracker(other.m_frameTracker), m_managerCommandBuffer(other.m_managerCommandBuffer),
+      GraphicsListen(*this), m_renderReady(*this), m_triggerCapturePolicy(*this), m_listenForLoadComplete(*this),
+      m_listenForGetFileNamePolicy(*this), m_listenForSetOutput(*this), m_eventBus(other.m_eventBus),
+      m_cmdBus(other.m_cmdBus), m_frameTracker(other.m_frameTracker),
+      m_managerCommandBuffer(other.m_managerCommandBuffer),
       m_managerGraphicsContainer(other.m_managerGraphicsContainer), m_mainGraphicsRenderer(other.m_mainGraphicsRenderer)
 {
     if (m_eventBus != nullptr && m_cmdBus != nullptr)
@@ -138,6 +142,7 @@ void star::service::HeadlessRenderResultWriteService::cleanupListeners(common::E
     GraphicsListen::cleanup(eventBus);
     m_renderReady.cleanup(eventBus);
     m_triggerCapturePolicy.cleanup(eventBus);
+    m_listenForLoadComplete.cleanup(eventBus);
 }
 
 void star::service::HeadlessRenderResultWriteService::cleanupListeners(core::CommandBus &commandBus)
@@ -169,6 +174,7 @@ void star::service::HeadlessRenderResultWriteService::initListeners(common::Even
     GraphicsListen::init(eventBus);
     m_renderReady.init(eventBus);
     m_triggerCapturePolicy.init(eventBus);
+    m_listenForLoadComplete.init(eventBus);
 }
 
 void star::service::HeadlessRenderResultWriteService::onStartOfNextFrame(const event::StartOfNextFrame &event,
@@ -182,15 +188,15 @@ void star::service::HeadlessRenderResultWriteService::onStartOfNextFrame(const e
 
     const size_t index = static_cast<size_t>(m_frameTracker->getCurrent().getFrameInFlightIndex());
     // vk::Semaphore semaphore = m_managerCommandBuffer->getDefault().commandBuffer->getCompleteSemaphores()[index];
-    star::StarTextures::Texture targetImage =
-        m_managerGraphicsContainer->imageManager.get(m_mainGraphicsRenderer->getRenderToColorImages()[index])->texture;
+    const Handle &targetResource = m_mainGraphicsRenderer->getRenderToColorImages()[index];
+    star::StarTextures::Texture targetImage = m_managerGraphicsContainer->imageManager.get(targetResource)->texture;
     auto commandBuffer = m_mainGraphicsRenderer->getCommandBuffer();
 
     const auto path = m_outputDir.has_value() ? m_outputDir.value() / getFileName(*m_frameTracker)
                                               : GetDefaultImageDirectory() / getFileName(*m_frameTracker);
 
     m_eventBus->emit(event::TriggerScreenshot{std::move(targetImage), path.string(), commandBuffer,
-                                              m_screenshotRegistrations[index]});
+                                              m_screenshotRegistrations[index], targetResource});
 
     keepAlive = true;
 }
@@ -235,6 +241,53 @@ void star::service::HeadlessRenderResultWriteService::onRenderReadyForFinalizati
     keepAlive = true;
 }
 
+void star::service::HeadlessRenderResultWriteService::onEnginePhaseComplete(const event::EnginePhaseComplete &event,
+                                                                           bool &keepAlive)
+{
+    if (event.getPhase() != star::event::EnginePhaseComplete::Phase::load)
+    {
+        keepAlive = true;
+        return;
+    }
+
+    // declared before the first frame compiles the graph, so the first capture already finds its target in order
+    declareCaptureResourceUses();
+    keepAlive = false;
+}
+
+void star::service::HeadlessRenderResultWriteService::declareCaptureResourceUses() const
+{
+    assert(m_cmdBus != nullptr);
+    if (m_mainGraphicsRenderer == nullptr)
+    {
+        return;
+    }
+
+    star::command::GetScreenCaptureCommandBufferInfo getCapture{};
+    m_cmdBus->submit(getCapture);
+    const Handle *copyCommandBuffer = getCapture.getReply().get().cmdBuffer;
+    if (copyCommandBuffer == nullptr)
+    {
+        return;
+    }
+
+    const auto &colorImages = m_mainGraphicsRenderer->getRenderToColorImages();
+    for (size_t i = 0; i < colorImages.size(); i++)
+    {
+        // the copied buffer is read on the host, which keeps the copy from being culled
+        m_cmdBus->submit(star::command_order::DeclareResourceUse{
+            *copyCommandBuffer, star::service::command_order::ResourceUse{
+                                    .resource = colorImages[i],
+                                    .type = star::service::command_order::ResourceUse::Type::image,
+                                    .stages = vk::PipelineStageFlagBits2::eTransfer,
+                                    .access = vk::AccessFlagBits2::eTransferRead,
+                                    .layout = vk::ImageLayout::eTransferSrcOptimal,
+                                    .aspect = vk::ImageAspectFlagBits::eColor,
+                                    .frameInFlightIndex = static_cast<uint8_t>(i),
+                                    .isExternal = true}});
+    }
+}
+
 std::string star::service::HeadlessRenderResultWriteService::getFileName(const common::FrameTracker &ft) const
 {
     return "Frame-" + std::to_string(ft.getCurrent().getGlobalFrameCounter()) + ".png";
@@ -1,25 +1,27 @@
 #include "starlight/service/SceneLoaderService.hpp"
 
 #include "starlight/command/CreateObject.hpp"
-#include "starlight/common/io/JSONFileWriter.hpp"
+#include "starlight/command/FileIO/WriteToFile.hpp"
+#include "starlight/job/tasks/IOTask.hpp"
 #include "starlight/service/detail/scene_loader/LightReader.hpp"
-#include "starlight/service/detail/scene_loader/LightWriter.hpp"
 #include "starlight/service/detail/scene_loader/ObjectReader.hpp"
-#include "starlight/service/detail/scene_loader/ObjectWriter.hpp"
 
 #include <nlohmann/json.hpp>
 
 namespace star::service
 {
-SceneLoaderService::SceneLoaderService(std::string sceneFilePath)
-    : m_sceneFilePath(std::move(sceneFilePath)), m_objectTracker(), m_onCreate(*this), m_onSceneSave(*this),
-      m_onCreateLight(*this)
+SceneLoaderService::SceneLoaderService(std::string sceneFilePath, bool onlySaveDirtyEntities)
+    : m_sceneFilePath(std::move(sceneFilePath)), m_sceneCache(m_sceneFilePath), m_objectTracker(),
+      m_onlySaveDirtyEntities(onlySaveDirtyEntities), m_onCreate(*this), m_onSceneSave(*this), m_onCreateLight(*this)
 {
 }
 
 SceneLoaderService::SceneLoaderService(SceneLoaderService &&other) noexcept
-    : m_sceneFilePath(std::move(other.m_sceneFilePath)), m_objectTracker(std::move(other.m_objectTracker)),
-      m_onCreate(*this), m_onSceneSave(*this), m_onCreateLight(*this), m_deviceCommandBus(other.m_deviceCommandBus)
+    : m_sceneFilePath(std::move(other.m_sceneFilePath)), m_sceneCache(std::move(other.m_sceneCache)),
+      m_objectTracker(std::move(other.m_objectTracker)), m_lightTracker(std::move(other.m_lightTracker)),
+      m_lastSavedObjectStates(std::move(other.m_lastSavedObjectStates)), m_sceneWriter(std::move(other.m_sceneWriter)),
+      m_onlySaveDirtyEntities(other.m_onlySaveDirtyEntities), m_onCreate(*this), m_onSceneSave(*this),
+      m_onCreateLight(*this), m_deviceCommandBus(other.m_deviceCommandBus)
 {
 
     if (m_deviceCommandBus != nullptr)
@@ -34,7 +36,12 @@ SceneLoaderService &SceneLoaderService::operator=(SceneLoaderService &&other) no
     if (this != &other)
     {
         m_objectTracker = std::move(other.m_objectTracker);
+        m_lightTracker = std::move(other.m_lightTracker);
+        m_lastSavedObjectStates = std::move(other.m_lastSavedObjectStates);
+        m_sceneWriter = std::move(other.m_sceneWriter);
+        m_onlySaveDirtyEntities = other.m_onlySaveDirtyEntities;
         m_sceneFilePath = std::move(other.m_sceneFilePath);
+        m_sceneCache = std::move(other.m_sceneCache);
         m_deviceCommandBus = other.m_deviceCommandBus;
         if (m_deviceCommandBus != nullptr)
         {
@@ -80,30 +87,6 @@ void SceneLoaderService::cleanupListeners(core::CommandBus &commandBus) noexcept
     m_onSceneSave.cleanup(commandBus);
 }
 
-std::optional<nlohmann::json> TryReadFile(const std::string &path)
-{
-    // Load file
-    std::ifstream ifs(path, std::ios::binary);
-    if (!ifs)
-        return std::nullopt;
-
-    nlohmann::json root;
-    try
-    {
-        ifs >> root;
-    }
-    catch (const std::exception &ex)
-    {
-        return std::nullopt;
-    }
-
-    // Navigate to /Scene/objects/<name>
-    if (!root.contains("Scene") || !root["Scene"].contains("Objects"))
-        return std::nullopt;
-
-    return root;
-}
-
 void SceneLoaderService::onCreateObject(command::CreateObject &event)
 {
     const auto &uniqueName = event.getUniqueName();
@@ -117,15 +100,14 @@ void SceneLoaderService::onCreateObject(command::CreateObject &event)
     newObject->createInstance();
 
     m_objectTracker.insert(std::make_pair(uniqueName, newObject));
-    auto data = TryReadFile(m_sceneFilePath);
-    if (data.has_value())
+    if (m_sceneCache.refresh())
     {
-        auto reader = scene_loader::ObjectLoader();
-        const auto &objectData = data.value()["Scene"]["Objects"];
+        const auto reader = scene_loader::ObjectLoader();
+        const auto *objectData = m_sceneCache.findObject(uniqueName);
 
-        if (reader.canLoad(objectData, uniqueName))
+        if (objectData != nullptr && reader.canLoad(*objectData))
         {
-            reader.load(objectData, uniqueName, *newObject);
+            reader.load(*objectData, *newObject);
         }
         else
         {
@@ -143,57 +125,68 @@ void SceneLoaderService::onCreateObject(command::CreateObject &event)
 void SceneLoaderService::onSaveSceneState(command::SaveSceneState &event)
 {
     (void)event;
+    assert(m_deviceCommandBus != nullptr);
 
-    // Start with the existing scene file data, or an empty object
-    nlohmann::json root = nlohmann::json::object();
-    // Read existing scene data to preserve objects not in the current run
-    auto existingScene = TryReadFile(m_sceneFilePath);
-    if (existingScene.has_value())
+    auto snapshot = createSnapshot();
+    if (snapshot->empty())
     {
-        root = existingScene.value();
-        // Preserve existing scene Objects/Lights and overlay tracked ones
-        if (root.contains("Objects"))
-        {
-            root["Scene"]["Objects"] = root["Objects"];
-        }
-        if (root.contains("Lights"))
-        {
-            root["Scene"]["Lights"] = root["Lights"];
-        }
-        else
-        {
-            root["Scene"]["Lights"] = nlohmann::json::object();
-        }
+        return;
     }
-    else
+
+    if (m_sceneWriter == nullptr)
     {
-        root["Scene"] = nlohmann::json::object();
-        root["Scene"]["Objects"] = nlohmann::json::object();
+        m_sceneWriter = std::make_shared<scene_loader::SceneStateWriter>();
     }
 
-    for (const auto &ele : m_objectTracker)
+    // serialization and the file commit happen on the IO worker
+    using CommitPayload = job::tasks::io::WritePayload<scene_loader::SceneStateWriter::Commit>;
+    m_deviceCommandBus->submit(command::file_io::WriteToFile{job::tasks::io::CreateWriteTask(
+        CommitPayload{.filePath = m_sceneFilePath,
+                      .writeFunction = scene_loader::SceneStateWriter::Commit{.writer = m_sceneWriter,
+                                                                              .snapshot = std::move(snapshot)}})});
+}
+
+void SceneLoaderService::applyCommittedObjectStates()
+{
+    if (m_sceneWriter == nullptr)
     {
-        const std::string &name = ele.first;
-        const auto &obj = ele.second;
-        const auto writer = scene_loader::ObjectWriter();
-        auto data = writer.write(*obj);
+        return;
+    }
 
-        root["Scene"]["Objects"][name] = std::move(data);
+    for (auto &[name, state] : m_sceneWriter->takeCommittedObjectStates())
+    {
+        m_lastSavedObjectStates.insert_or_assign(std::move(name), state);
     }
+}
+
+std::unique_ptr<scene_loader::SceneStateSnapshot> SceneLoaderService::createSnapshot()
+{
+    applyCommittedObjectStates();
+
+    auto snapshot = std::make_unique<scene_loader::SceneStateSnapshot>();
+    snapshot->objects.reserve(m_objectTracker.size());
+    snapshot->lights.reserve(m_lightTracker.size());
 
-    for (const auto &ele : m_lightTracker)
+    for (const auto &[name, obj] : m_objectTracker)
     {
-        const std::string &name = ele.first;
-        const auto &light = ele.second;
+        const auto state = scene_loader::ObjectState::FromObject(*obj);
+        // the saved states are only updated once a commit succeeded, an object stays dirty until its write lands
+        auto lastSaved = m_lastSavedObjectStates.find(name);
+        if (m_onlySaveDirtyEntities && lastSaved != m_lastSavedObjectStates.end() && lastSaved->second == state)
+        {
+            continue;
+        }
 
-        scene_loader::LightWriter writer;
-        auto data = writer.write(*light);
+        snapshot->objects.emplace_back(name, state);
+    }
 
-        root["Scene"]["Lights"][name] = std::move(data);
+    // lights are few and carry more than a transform, always capture them
+    for (const auto &[name, light] : m_lightTracker)
+    {
+        snapshot->lights.emplace_back(name, *light);
     }
 
-    auto writerPayload = star::common::io::JSONFileWriter(std::move(root));
-    writerPayload(m_sceneFilePath);
+    return snapshot;
 }
 
 void SceneLoaderService::onCreateLight(star::command::CreateLight &cmd)
@@ -206,20 +199,14 @@ void SceneLoaderService::onCreateLight(star::command::CreateLight &cmd)
     auto newLight = std::make_shared<std::vector<Light>>();
     command::create_light::SceneAddResult result{command::create_light::fail};
 
-    auto data = TryReadFile(m_sceneFilePath);
-    if (data.has_value())
+    if (m_sceneCache.refresh())
     {
-        const auto &sData = data.value()["Scene"];
-        if (sData.contains("Lights"))
+        const scene_loader::LightReader reader;
+        const auto *lData = m_sceneCache.findLight(name);
+        if (lData != nullptr && reader.canLoad(*lData))
         {
-            const auto &lData = sData["Lights"];
-
-            const scene_loader::LightReader reader;
-            if (reader.canLoad(lData, name))
-            {
-                result = command::create_light::success;
-                reader.load(lData, name, *newLight);
-            }
+            result = command::create_light::success;
+            reader.load(*lData, *newLight);
         }
     }
     else
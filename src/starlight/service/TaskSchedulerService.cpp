@@ -1,5 +1,7 @@
 #include "starlight/service/TaskSchedulerService.hpp"
 
+#include <algorithm>
+
 namespace star::service
 {
 TaskSchedulerService::TaskSchedulerService() : m_listenForSubmitTask(*this)
@@ -43,8 +45,24 @@ void TaskSchedulerService::init()
 
 void TaskSchedulerService::negotiateWorkers(core::WorkerPool &pool, job::TaskManager &tm)
 {
-    (void)pool;
     m_taskManager = &tm;
+
+    if (!tm.hasExecutor())
+    {
+        // the shared executor takes half of the system threads, the rest stay available for services which need a
+        // dedicated thread such as the transfer workers
+        size_t numExecutorThreads = std::max<size_t>(1, pool.getNumAvailableWorkers() / 2);
+        for (size_t i = 0; i < numExecutorThreads; i++)
+        {
+            if (!pool.allocateWorker())
+            {
+                numExecutorThreads = std::max<size_t>(1, i);
+                break;
+            }
+        }
+
+        tm.initExecutor(numExecutorThreads);
+    }
 }
 
 void TaskSchedulerService::setInitParameters(InitParameters &params)
@@ -100,7 +100,7 @@ void TransferService::init()
     assert(m_cmdBus != nullptr);
 
     selectQueueFamiliesToUse();
-    dispatchCreateWorkersFromConfig();
+    createAndRegisterTransferWorkers();
     initSemaphores();
     initListeners(*m_cmdBus);
 }
@@ -182,68 +182,6 @@ void TransferService::onSubmitTransfer(star::command::transfer::SubmitTransferTa
     });
 }
 
-void TransferService::dispatchCreateWorkersFromConfig()
-{
-    const auto hi = m_config.highPrioritySize;
-    const auto std = m_config.standardPrioritySize;
-
-    switch (hi)
-    {
-    case star::TransferQueueCapacity::Low:
-        switch (std)
-        {
-        case star::TransferQueueCapacity::Low:
-            return dispatchCreateWorkers<64, 64>();
-        case star::TransferQueueCapacity::Medium:
-            return dispatchCreateWorkers<64, 128>();
-        case star::TransferQueueCapacity::High:
-            return dispatchCreateWorkers<64, 256>();
-        case star::TransferQueueCapacity::Ultra:
-            return dispatchCreateWorkers<64, 512>();
-        }
-        break;
-    case star::TransferQueueCapacity::Medium:
-        switch (std)
-        {
-        case star::TransferQueueCapacity::Low:
-            return dispatchCreateWorkers<128, 64>();
-        case star::TransferQueueCapacity::Medium:
-            return dispatchCreateWorkers<128, 128>();
-        case star::TransferQueueCapacity::High:
-            return dispatchCreateWorkers<128, 256>();
-        case star::TransferQueueCapacity::Ultra:
-            return dispatchCreateWorkers<128, 512>();
-        }
-        break;
-    case star::TransferQueueCapacity::High:
-        switch (std)
-        {
-        case star::TransferQueueCapacity::Low:
-            return dispatchCreateWorkers<256, 64>();
-        case star::TransferQueueCapacity::Medium:
-            return dispatchCreateWorkers<256, 128>();
-        case star::TransferQueueCapacity::High:
-            return dispatchCreateWorkers<256, 256>();
-        case star::TransferQueueCapacity::Ultra:
-            return dispatchCreateWorkers<256, 512>();
-        }
-        break;
-    case star::TransferQueueCapacity::Ultra:
-        switch (std)
-        {
-        case star::TransferQueueCapacity::Low:
-            return dispatchCreateWorkers<512, 64>();
-        case star::TransferQueueCapacity::Medium:
-            return dispatchCreateWorkers<512, 128>();
-        case star::TransferQueueCapacity::High:
-            return dispatchCreateWorkers<512, 256>();
-        case star::TransferQueueCapacity::Ultra:
-            return dispatchCreateWorkers<512, 512>();
-        }
-        break;
-    }
-}
-
 void TransferService::cleanupListeners(star::core::CommandBus &cmdBus)
 {
     m_listenerTransferTask.cleanup(cmdBus);
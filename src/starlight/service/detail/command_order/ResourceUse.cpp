@@ -0,0 +1 @@
+#include "starlight/service/detail/command_order/ResourceUse.hpp"
\ No newline at end of file
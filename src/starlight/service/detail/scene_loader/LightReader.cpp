@@ -9,6 +9,11 @@ bool LightReader::canLoad(const nlohmann::json &lightData, const std::string &un
     return lightData.contains(uniqueName);
 }
 
+bool LightReader::canLoad(const nlohmann::json &lightData) const noexcept
+{
+    return lightData.is_array();
+}
+
 void LightReader::load(const nlohmann::json &lightDatas, const std::string &uniqueName, std::vector<Light> &light) const noexcept
 {
     if (!lightDatas.contains(uniqueName))
@@ -16,8 +21,12 @@ void LightReader::load(const nlohmann::json &lightDatas, const std::string &uniq
         return;
     }
 
-    const auto &lData = lightDatas[uniqueName]; 
-    light = lData.get<std::vector<Light>>(); 
+    load(lightDatas[uniqueName], light);
+}
+
+void LightReader::load(const nlohmann::json &lightData, std::vector<Light> &light) const noexcept
+{
+    light = lightData.get<std::vector<Light>>(); 
 
     //TODO: need to properly handle rotation applications like the object reader... omitting due to time constraints
 }
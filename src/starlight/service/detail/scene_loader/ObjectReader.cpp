@@ -14,8 +14,12 @@ bool ObjectLoader::canLoad(const nlohmann::json &objectDatas, const std::string
         return false;
     }
 
-    const auto &jData = objectDatas[uniqueName];
-    return jData.contains("position") && jData.contains("scale") && jData.contains("rotation_deg");
+    return canLoad(objectDatas[uniqueName]);
+}
+
+bool ObjectLoader::canLoad(const nlohmann::json &objectData) const noexcept
+{
+    return objectData.contains("position") && objectData.contains("scale") && objectData.contains("rotation_deg");
 }
 
 void ObjectLoader::load(const nlohmann::json &objectDatas, const std::string &uniqueName,
@@ -26,10 +30,14 @@ void ObjectLoader::load(const nlohmann::json &objectDatas, const std::string &un
         return;
     }
 
-    auto &jData = objectDatas[uniqueName];
-    glm::vec3 position = jData["position"];
-    glm::vec3 scale = jData["scale"];
-    glm::vec3 rotation = jData["rotation_deg"];
+    load(objectDatas[uniqueName], obj);
+}
+
+void ObjectLoader::load(const nlohmann::json &objectData, StarObject &obj) const noexcept
+{
+    glm::vec3 position = objectData["position"];
+    glm::vec3 scale = objectData["scale"];
+    glm::vec3 rotation = objectData["rotation_deg"];
 
     const auto rotToApply = core::helper::star_object::ConvertFromEulerToGlobalRotations(rotation);
 
@@ -40,4 +48,4 @@ void ObjectLoader::load(const nlohmann::json &objectDatas, const std::string &un
         obj.getInstance().rotateRelative(rot.first, rot.second, true);
     }
 }
-} // namespace star::service::scene_loader
\ No newline at end of file
+} // namespace star::service::scene_loader
@@ -1,21 +1,21 @@
 #include "starlight/service/detail/scene_loader/ObjectWriter.hpp"
 
-#include "starlight/core/helper/star_object/ObjectHelpers.hpp"
 #include "starlight/core/json/glm_json.hpp"
 
 namespace star::service::scene_loader
 {
 nlohmann::json ObjectWriter::write(const StarObject &object) const noexcept
 {
-    nlohmann::json j;
+    return write(ObjectState::FromObject(object));
+}
 
-    const auto pos = object.getInstance().getPosition();
-    const auto rotDeg = core::helper::star_object::ExtractRotationDegrees(object.getInstance().getRotationMat());
-    const auto scale = object.getInstance().getScale();
+nlohmann::json ObjectWriter::write(const ObjectState &state) const noexcept
+{
+    nlohmann::json j;
 
-    j["position"] = pos;
-    j["rotation_deg"] = rotDeg;
-    j["scale"] = scale;
+    j["position"] = state.position;
+    j["rotation_deg"] = state.rotationDeg;
+    j["scale"] = state.scale;
 
     return j;
 }
@@ -0,0 +1,139 @@
+#include "starlight/service/detail/scene_loader/SceneDocumentCache.hpp"
+
+#include "starlight/core/logging/LoggingFactory.hpp"
+
+#include <fstream>
+
+namespace star::service::scene_loader
+{
+SceneDocumentCache::SceneDocumentCache(std::string sceneFilePath) : m_sceneFilePath(std::move(sceneFilePath))
+{
+}
+
+SceneDocumentCache::SceneDocumentCache(SceneDocumentCache &&other) noexcept
+    : m_sceneFilePath(std::move(other.m_sceneFilePath)), m_lastWriteTime(std::move(other.m_lastWriteTime)),
+      m_root(std::move(other.m_root))
+{
+    other.invalidate();
+    buildIndex();
+}
+
+SceneDocumentCache &SceneDocumentCache::operator=(SceneDocumentCache &&other) noexcept
+{
+    if (this != &other)
+    {
+        m_sceneFilePath = std::move(other.m_sceneFilePath);
+        m_lastWriteTime = std::move(other.m_lastWriteTime);
+        m_root = std::move(other.m_root);
+
+        other.invalidate();
+        buildIndex();
+    }
+
+    return *this;
+}
+
+bool SceneDocumentCache::refresh()
+{
+    std::error_code ec;
+    const auto writeTime = std::filesystem::last_write_time(m_sceneFilePath, ec);
+    if (ec)
+    {
+        invalidate();
+        return false;
+    }
+
+    if (m_lastWriteTime.has_value() && m_lastWriteTime.value() == writeTime)
+    {
+        return isValid();
+    }
+
+    invalidate();
+    m_lastWriteTime = writeTime;
+
+    std::ifstream ifs(m_sceneFilePath, std::ios::binary);
+    if (!ifs)
+    {
+        return false;
+    }
+
+    nlohmann::json root;
+    try
+    {
+        ifs >> root;
+    }
+    catch (const std::exception &ex)
+    {
+        core::logging::warning("Failed to parse scene file: ", m_sceneFilePath, " -- ", ex.what());
+        return false;
+    }
+
+    if (!root.contains("Scene") || !root["Scene"].contains("Objects"))
+    {
+        return false;
+    }
+
+    m_root = std::move(root);
+    buildIndex();
+
+    return true;
+}
+
+void SceneDocumentCache::invalidate() noexcept
+{
+    m_lastWriteTime.reset();
+    m_root.reset();
+    m_objectIndex.clear();
+    m_lightIndex.clear();
+}
+
+const nlohmann::json *SceneDocumentCache::findObject(const std::string &uniqueName) const noexcept
+{
+    return Find(m_objectIndex, uniqueName);
+}
+
+const nlohmann::json *SceneDocumentCache::findLight(const std::string &uniqueName) const noexcept
+{
+    return Find(m_lightIndex, uniqueName);
+}
+
+void SceneDocumentCache::buildIndex()
+{
+    m_objectIndex.clear();
+    m_lightIndex.clear();
+
+    if (!m_root.has_value())
+    {
+        return;
+    }
+
+    const auto &scene = m_root.value()["Scene"];
+
+    const auto &objects = scene["Objects"];
+    if (objects.is_object())
+    {
+        m_objectIndex.reserve(objects.size());
+        for (const auto &[key, value] : objects.items())
+        {
+            m_objectIndex.emplace(key, &value);
+        }
+    }
+
+    if (scene.contains("Lights") && scene["Lights"].is_object())
+    {
+        const auto &lights = scene["Lights"];
+        m_lightIndex.reserve(lights.size());
+        for (const auto &[key, value] : lights.items())
+        {
+            m_lightIndex.emplace(key, &value);
+        }
+    }
+}
+
+const nlohmann::json *SceneDocumentCache::Find(const absl::flat_hash_map<std::string, const nlohmann::json *> &index,
+                                               const std::string &uniqueName) noexcept
+{
+    const auto it = index.find(uniqueName);
+    return it != index.end() ? it->second : nullptr;
+}
+} // namespace star::service::scene_loader
@@ -0,0 +1,18 @@
+#include "starlight/service/detail/scene_loader/SceneStateSnapshot.hpp"
+
+#include "starlight/core/helper/star_object/ObjectHelpers.hpp"
+#include "starlight/object/StarObject.hpp"
+
+namespace star::service::scene_loader
+{
+ObjectState ObjectState::FromObject(const StarObject &object)
+{
+    const auto &instance = object.getInstance();
+
+    return ObjectState{
+        .position = instance.getPosition(),
+        .rotationDeg = core::helper::star_object::ExtractRotationDegrees(instance.getRotationMat()),
+        .scale = instance.getScale(),
+    };
+}
+} // namespace star::service::scene_loader
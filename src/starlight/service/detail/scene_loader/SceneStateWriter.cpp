@@ -0,0 +1,99 @@
+#include "starlight/service/detail/scene_loader/SceneStateWriter.hpp"
+
+#include "starlight/common/io/JSONFileWriter.hpp"
+#include "starlight/core/logging/LoggingFactory.hpp"
+#include "starlight/service/detail/scene_loader/LightWriter.hpp"
+#include "starlight/service/detail/scene_loader/ObjectWriter.hpp"
+
+#include <fstream>
+
+namespace star::service::scene_loader
+{
+int SceneStateWriter::write(SceneStateSnapshot snapshot, const std::filesystem::path &path)
+{
+    std::lock_guard<std::mutex> lock(m_writeLock);
+
+    auto existing = LoadExistingDocument(path);
+    if (!existing.has_value())
+    {
+        return 1;
+    }
+
+    nlohmann::json document = std::move(existing.value());
+    auto &scene = document["Scene"];
+
+    const ObjectWriter objectWriter;
+    for (const auto &[name, state] : snapshot.objects)
+    {
+        scene["Objects"][name] = objectWriter.write(state);
+    }
+
+    const LightWriter lightWriter;
+    for (const auto &[name, lights] : snapshot.lights)
+    {
+        scene["Lights"][name] = lightWriter.write(lights);
+    }
+
+    const int result = common::io::JSONFileWriter::Write(document, path, true);
+    if (result == 0)
+    {
+        std::lock_guard<std::mutex> committedLock(m_committedLock);
+        for (auto &object : snapshot.objects)
+        {
+            m_committedObjectStates.push_back(std::move(object));
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::pair<std::string, ObjectState>> SceneStateWriter::takeCommittedObjectStates()
+{
+    std::lock_guard<std::mutex> lock(m_committedLock);
+
+    return std::exchange(m_committedObjectStates, {});
+}
+
+std::optional<nlohmann::json> SceneStateWriter::LoadExistingDocument(const std::filesystem::path &path)
+{
+    nlohmann::json root = nlohmann::json::object();
+
+    std::ifstream ifs(path, std::ios::binary);
+    if (ifs)
+    {
+        try
+        {
+            ifs >> root;
+        }
+        catch (const std::exception &ex)
+        {
+            core::logging::error("Scene file could not be parsed, not saving over it: ", path.string(), ": ",
+                                 ex.what());
+            return std::nullopt;
+        }
+    }
+
+    if (!root.is_object() || !root.contains("Scene") || !root["Scene"].contains("Objects"))
+    {
+        root = nlohmann::json::object();
+        root["Scene"] = nlohmann::json::object();
+        root["Scene"]["Objects"] = nlohmann::json::object();
+    }
+
+    // Preserve existing scene Objects/Lights and overlay tracked ones
+    if (root.contains("Objects"))
+    {
+        root["Scene"]["Objects"] = root["Objects"];
+    }
+    if (root.contains("Lights"))
+    {
+        root["Scene"]["Lights"] = root["Lights"];
+    }
+    else if (!root["Scene"].contains("Lights"))
+    {
+        root["Scene"]["Lights"] = nlohmann::json::object();
+    }
+
+    return root;
+}
+} // namespace star::service::scene_loader
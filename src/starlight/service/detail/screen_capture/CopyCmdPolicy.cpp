@@ -42,10 +42,14 @@ static vk::BufferMemoryBarrier2 GetBarrierPrepForCPURead(vk::Buffer buffer) noex
 
 void CopyCmdPolicy::addMemoryDependenciesToCleanupFromCopy(vk::CommandBuffer &commandBuffer)
 {
+    // the host reads the buffer outside of the graph. A target texture in the graph is only released when the graph
+    // moves it to another queue family, any other target is returned to the layout it was handed over in.
     const vk::BufferMemoryBarrier2 buffBarrier[1]{GetBarrierPrepForCPURead(m_inUseInfo->buffer)};
+    const auto imageBarriers =
+        m_inUseInfo->isTargetInGraph ? m_inUseInfo->graphReleaseBarriers : getImageBarriersForCleanup();
 
     commandBuffer.pipelineBarrier2(
-        vk::DependencyInfo().setBufferMemoryBarriers(buffBarrier));
+        vk::DependencyInfo().setBufferMemoryBarriers(buffBarrier).setImageMemoryBarriers(imageBarriers));
 }
 
 void CopyCmdPolicy::init(core::device::StarDevice &device)
@@ -227,7 +231,15 @@ void CopyCmdPolicy::recordCommandBuffer(StarCommandBuffer &commandBuffer,
 
 void CopyCmdPolicy::addMemoryDependenciesToPrepForCopy(vk::CommandBuffer &commandBuffer)
 {
-    // assuming that the target image is not in the proper layout for transfer SRC
+    // the graph moves a declared target texture to transfer src from whichever pass rendered it, any other target is
+    // assumed to not be in the proper layout yet
+    if (m_inUseInfo->isTargetInGraph)
+    {
+        commandBuffer.pipelineBarrier2(
+            vk::DependencyInfo().setImageMemoryBarriers(m_inUseInfo->graphAcquireBarriers));
+        return;
+    }
+
     auto imageBarriers = getImageBarriersForPrep();
     uint32_t numImageBarriers;
     star::common::casts::SafeCast<size_t, uint32_t>(imageBarriers.size(), numImageBarriers);
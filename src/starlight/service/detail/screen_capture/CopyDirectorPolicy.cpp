@@ -4,6 +4,7 @@
 #include "core/helper/queue/QueueHelpers.hpp"
 #include "logging/LoggingFactory.hpp"
 #include "starlight/command/command_order/DeclarePass.hpp"
+#include "starlight/command/command_order/GetPassInfo.hpp"
 #include "starlight/command/command_order/TriggerPass.hpp"
 
 #include <star_common/HandleTypeRegistry.hpp>
@@ -144,6 +145,39 @@ void DefaultCopyPolicy::prepareInProgressResources(CopyPlan &copyPlan) noexcept
     }
 
     m_inUseResources->queueToUse = getQueueToUse().getVulkanQueue();
+
+    m_inUseResources->graphAcquireBarriers.clear();
+    m_inUseResources->graphReleaseBarriers.clear();
+    if (copyPlan.targetTextureResource.has_value())
+    {
+        // the layout of a declared target texture is tracked by the graph, only its own transitions apply to it
+        auto cmd = star::command_order::GetPassInfo{m_copyCmds.getCommandBuffer()};
+        m_deviceInfo->cmdBus->submit(cmd);
+        const auto &info = cmd.getReply().get();
+        const auto frameInFlight = m_deviceInfo->flightTracker->getCurrent().getFrameInFlightIndex();
+        const Handle &target = copyPlan.targetTextureResource.value();
+
+        const auto resolve = [&](const std::vector<star::service::command_order::ResourceTransition> *transitions,
+                                 std::vector<vk::ImageMemoryBarrier2> &barriers) {
+            if (transitions == nullptr)
+            {
+                return;
+            }
+
+            for (const auto &transition : *transitions)
+            {
+                if (transition.resource == target && transition.appliesTo(frameInFlight) &&
+                    transition.type == star::service::command_order::ResourceUse::Type::image)
+                {
+                    barriers.push_back(transition.toImageBarrier(m_inUseResources->targetTexture.getVulkanImage()));
+                }
+            }
+        };
+
+        resolve(info.acquireTransitions, m_inUseResources->graphAcquireBarriers);
+        resolve(info.releaseTransitions, m_inUseResources->graphReleaseBarriers);
+    }
+    m_inUseResources->isTargetInGraph = !m_inUseResources->graphAcquireBarriers.empty();
 }
 
 StarQueue &DefaultCopyPolicy::getQueueToUse() const
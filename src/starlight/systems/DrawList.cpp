@@ -0,0 +1,245 @@
+#include "DrawList.hpp"
+
+#include "starlight/object/StarObject.hpp"
+
+#include <star_common/helper/CastHelpers.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <optional>
+
+namespace star
+{
+void DrawList::clear()
+{
+    m_draws.clear();
+    m_resolved.clear();
+    m_order.clear();
+    m_materialSets.clear();
+    m_descriptorSets.clear();
+    m_debugObjects.clear();
+    m_pipelineIds.clear();
+    m_materialIds.clear();
+    m_geometryIds.clear();
+}
+
+void DrawList::sort(const uint8_t &frameInFlightIndex)
+{
+    m_resolved.resize(m_draws.size());
+    m_order.resize(m_draws.size());
+    for (size_t i = 0; i < m_draws.size(); i++)
+    {
+        m_resolved[i] = resolve(m_draws[i], frameInFlightIndex);
+        m_order[i].key = makeKey(m_draws[i], m_resolved[i]);
+        star::common::casts::SafeCast<size_t, uint32_t>(i, m_order[i].index);
+    }
+
+    RadixSort(m_order, m_scratch);
+}
+
+DrawStats DrawList::record(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex, const size_t &first,
+                           const size_t &count) const
+{
+    assert(m_order.size() == m_draws.size() && "Draw list must be sorted before it is recorded");
+    assert(first + count <= m_order.size() && "Requested draws are beyond the size of the list");
+
+    DrawStats stats;
+
+    const StarPipeline *boundPipeline = nullptr;
+    vk::PipelineLayout boundLayout{VK_NULL_HANDLE};
+    std::optional<uint32_t> boundMaterial = std::nullopt;
+    vk::Buffer boundVertexBuffer{VK_NULL_HANDLE}, boundIndexBuffer{VK_NULL_HANDLE};
+    vk::IndexType boundIndexType = vk::IndexType::eUint32;
+
+    for (size_t i = first; i < first + count; i++)
+    {
+        const Draw &draw = m_draws[m_order[i].index];
+        const ResolvedDraw &resolved = m_resolved[m_order[i].index];
+
+        if (draw.pipeline != boundPipeline)
+        {
+            draw.pipeline->bind(commandBuffer);
+            boundPipeline = draw.pipeline;
+            stats.numPipelineBinds++;
+        }
+        else
+        {
+            stats.numBindsSaved++;
+        }
+
+        // sets bound against a different layout may have been disturbed, so the layout is part of the state
+        if (resolved.materialID != boundMaterial || draw.pipelineLayout != boundLayout)
+        {
+            const DescriptorRange &sets = m_materialSets[resolved.materialID];
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, draw.pipelineLayout, 0, sets.count,
+                                             m_descriptorSets.data() + sets.offset, 0, nullptr);
+            boundMaterial = resolved.materialID;
+            boundLayout = draw.pipelineLayout;
+            stats.numDescriptorBinds++;
+        }
+        else
+        {
+            stats.numBindsSaved++;
+        }
+
+        if (resolved.vertexBuffer != boundVertexBuffer)
+        {
+            draw.mesh->bindVertexBuffers(commandBuffer, resolved.vertexBuffer);
+            boundVertexBuffer = resolved.vertexBuffer;
+            stats.numVertexBufferBinds++;
+        }
+        else
+        {
+            stats.numBindsSaved++;
+        }
+
+        if (resolved.indexBuffer != boundIndexBuffer || draw.mesh->getIndexType() != boundIndexType)
+        {
+            draw.mesh->bindIndexBuffer(commandBuffer, resolved.indexBuffer);
+            boundIndexBuffer = resolved.indexBuffer;
+            boundIndexType = draw.mesh->getIndexType();
+            stats.numIndexBufferBinds++;
+        }
+        else
+        {
+            stats.numBindsSaved++;
+        }
+
+        if (draw.gpuCulling != nullptr)
+        {
+            draw.gpuCulling->recordDraw(commandBuffer, frameInFlightIndex, draw.gpuDrawIndex);
+        }
+        else
+        {
+            draw.mesh->recordDraw(commandBuffer, draw.instanceCount);
+        }
+        stats.numDraws++;
+    }
+
+    return stats;
+}
+
+void DrawList::recordDebug(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex) const
+{
+    for (auto *object : m_debugObjects)
+    {
+        object->recordDebugCommands(commandBuffer, frameInFlightIndex);
+    }
+}
+
+DrawList::ResolvedDraw DrawList::resolve(const Draw &draw, const uint8_t &frameInFlightIndex)
+{
+    ResolvedDraw resolved{.vertexBuffer = draw.mesh->getVertexBuffer(),
+                          .indexBuffer = draw.mesh->getIndexBuffer(),
+                          .materialID = GetID<const void *>(m_materialIds, draw.material)};
+
+    // first draw of the material this frame
+    if (resolved.materialID == m_materialSets.size())
+    {
+        const auto sets = draw.material->getDescriptorSets(frameInFlightIndex);
+        DescriptorRange range{.offset = m_descriptorSets.size(),
+                              .numWrites = draw.material->getNumDescriptorWrites(frameInFlightIndex)};
+        star::common::casts::SafeCast<size_t, uint32_t>(sets.size(), range.count);
+
+        m_materialSets.push_back(range);
+        m_descriptorSets.insert(m_descriptorSets.end(), sets.begin(), sets.end());
+    }
+
+    return resolved;
+}
+
+void DrawList::hashRecordState(core::renderer::RecordState &state) const
+{
+    assert(m_order.size() == m_draws.size() && "Draw list must be sorted before it is hashed");
+
+    state.add(m_draws.size());
+    for (const auto &entry : m_order)
+    {
+        const Draw &draw = m_draws[entry.index];
+        const ResolvedDraw &resolved = m_resolved[entry.index];
+        const DescriptorRange &sets = m_materialSets[resolved.materialID];
+
+        state.add(draw.pipeline->getVulkanPipeline())
+            .add(draw.pipelineLayout)
+            .add(resolved.vertexBuffer)
+            .add(resolved.indexBuffer)
+            .add(draw.mesh->getIndexType())
+            .add(draw.mesh->getNumIndices())
+            .add(draw.instanceCount)
+            .add(draw.gpuCulling)
+            .add(draw.gpuDrawIndex);
+        for (size_t i = 0; i < sets.count; i++)
+        {
+            state.add(m_descriptorSets[sets.offset + i]);
+        }
+        state.add(sets.numWrites);
+    }
+
+    state.add(m_debugObjects.size());
+    for (const auto *object : m_debugObjects)
+    {
+        state.add(object).add(object->drawNormals).add(object->drawBoundingBox);
+    }
+}
+
+uint64_t DrawList::makeKey(const Draw &draw, const ResolvedDraw &resolved)
+{
+    const uint64_t pipeline = ClampID(GetID<const void *>(m_pipelineIds, draw.pipeline), PipelineBits);
+    const uint64_t material = ClampID(resolved.materialID, MaterialBits);
+    const uint64_t geometry =
+        ClampID(GetID<VkBuffer>(m_geometryIds, static_cast<VkBuffer>(resolved.vertexBuffer)), GeometryBits);
+    const uint64_t depth = QuantizeDepth(draw.depth);
+
+    return (pipeline << (MaterialBits + GeometryBits + DepthBits)) | (material << (GeometryBits + DepthBits)) |
+           (geometry << DepthBits) | depth;
+}
+
+uint32_t DrawList::QuantizeDepth(const float &depth)
+{
+    // the bits of a non-negative float sort the same as its value, the top bits keep the exponent and some mantissa
+    const float clamped = std::max(depth, 0.0f);
+    return std::bit_cast<uint32_t>(clamped) >> (32 - DepthBits);
+}
+
+void DrawList::RadixSort(std::vector<SortEntry> &entries, std::vector<SortEntry> &scratch)
+{
+    if (entries.size() < 2)
+    {
+        return;
+    }
+
+    scratch.resize(entries.size());
+
+    // least significant digit first, every pass is stable so earlier passes break ties for later ones
+    for (uint32_t shift = 0; shift < 64; shift += RadixBits)
+    {
+        std::array<size_t, RadixSize> counts{};
+        for (const auto &entry : entries)
+        {
+            counts[(entry.key >> shift) & (RadixSize - 1)]++;
+        }
+
+        // a digit shared by every key would leave the order untouched
+        if (counts[(entries.front().key >> shift) & (RadixSize - 1)] == entries.size())
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (auto &count : counts)
+        {
+            const size_t digitCount = count;
+            count = offset;
+            offset += digitCount;
+        }
+
+        for (const auto &entry : entries)
+        {
+            scratch[counts[(entry.key >> shift) & (RadixSize - 1)]++] = entry;
+        }
+        entries.swap(scratch);
+    }
+}
+} // namespace star
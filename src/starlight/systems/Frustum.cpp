@@ -0,0 +1,118 @@
+#include "Frustum.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace star
+{
+void Frustum::BoxBatch::resize(const size_t &count)
+{
+    centerX.resize(count);
+    centerY.resize(count);
+    centerZ.resize(count);
+    extentX.resize(count);
+    extentY.resize(count);
+    extentZ.resize(count);
+}
+
+void Frustum::BoxBatch::set(const size_t &index, const glm::mat4 &transform, const glm::vec3 &localCenter,
+                            const glm::vec3 &localExtent)
+{
+    const glm::vec4 center = transform * glm::vec4(localCenter, 1.0f);
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+
+    // extent of the rotated box along each world axis is the projection of the local extents onto that axis
+    extentX[index] = std::abs(transform[0][0]) * localExtent.x + std::abs(transform[1][0]) * localExtent.y +
+                     std::abs(transform[2][0]) * localExtent.z;
+    extentY[index] = std::abs(transform[0][1]) * localExtent.x + std::abs(transform[1][1]) * localExtent.y +
+                     std::abs(transform[2][1]) * localExtent.z;
+    extentZ[index] = std::abs(transform[0][2]) * localExtent.x + std::abs(transform[1][2]) * localExtent.y +
+                     std::abs(transform[2][2]) * localExtent.z;
+}
+
+Frustum Frustum::FromViewProjection(const glm::mat4 &viewProjection)
+{
+    // glm is column major, rows of the matrix are gathered across the columns
+    const auto row = [&viewProjection](const int &index) {
+        return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index],
+                         viewProjection[3][index]);
+    };
+
+    const std::array<glm::vec4, NumPlanes> planes{
+        row(3) + row(0), // left
+        row(3) - row(0), // right
+        row(3) + row(1), // bottom
+        row(3) - row(1), // top
+        row(2),          // near
+        row(3) - row(2)  // far
+    };
+
+    Frustum result;
+    for (size_t i = 0; i < NumPlanes; i++)
+    {
+        const float length = glm::length(glm::vec3(planes[i]));
+        const glm::vec4 plane = length > 0.0f ? planes[i] / length : planes[i];
+
+        result.m_normalX[i] = plane.x;
+        result.m_normalY[i] = plane.y;
+        result.m_normalZ[i] = plane.z;
+        result.m_distance[i] = plane.w;
+    }
+
+    return result;
+}
+
+void Frustum::testBoxes(const BoxBatch &boxes, std::vector<uint8_t> &visible) const
+{
+    visible.resize(boxes.size());
+
+    for (size_t first = 0; first < boxes.size(); first += BatchSize)
+    {
+        testRange(boxes, first, std::min(BatchSize, boxes.size() - first), visible.data() + first);
+    }
+}
+
+std::array<glm::vec4, Frustum::NumPlanes> Frustum::getPlanes() const
+{
+    std::array<glm::vec4, NumPlanes> planes;
+    for (size_t i = 0; i < NumPlanes; i++)
+    {
+        planes[i] = glm::vec4(m_normalX[i], m_normalY[i], m_normalZ[i], m_distance[i]);
+    }
+    return planes;
+}
+
+void Frustum::testRange(const BoxBatch &boxes, const size_t &first, const size_t &count, uint8_t *visible) const
+{
+    const float *cx = boxes.centerX.data() + first;
+    const float *cy = boxes.centerY.data() + first;
+    const float *cz = boxes.centerZ.data() + first;
+    const float *ex = boxes.extentX.data() + first;
+    const float *ey = boxes.extentY.data() + first;
+    const float *ez = boxes.extentZ.data() + first;
+
+    std::array<float, BatchSize> inside;
+    std::fill(inside.begin(), inside.begin() + count, 1.0f);
+
+    // plane outer, box inner: each pass is branch free over contiguous floats so it maps onto SIMD lanes
+    for (size_t p = 0; p < NumPlanes; p++)
+    {
+        const float nx = m_normalX[p], ny = m_normalY[p], nz = m_normalZ[p], d = m_distance[p];
+        const float anx = std::abs(nx), any = std::abs(ny), anz = std::abs(nz);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const float distance = nx * cx[i] + ny * cy[i] + nz * cz[i] + d;
+            const float radius = anx * ex[i] + any * ey[i] + anz * ez[i];
+            inside[i] = distance + radius >= 0.0f ? inside[i] : 0.0f;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        visible[i] = inside[i] != 0.0f ? 1 : 0;
+    }
+}
+} // namespace star
@@ -0,0 +1,465 @@
+#include "GpuCullingPass.hpp"
+
+#include "Allocator.hpp"
+#include "ConfigFile.hpp"
+#include "FileHelpers.hpp"
+#include "core/Exceptions.hpp"
+#include "logging/LoggingFactory.hpp"
+#include "managers/ManagerRenderResource.hpp"
+#include "starlight/ShaderResolver.hpp"
+
+#include <star_common/helper/CastHelpers.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+namespace star
+{
+static std::unique_ptr<StarBuffers::Buffer> CreateDeviceBuffer(VmaAllocator &allocator, const uint32_t &count,
+                                                               const vk::DeviceSize &elementSize,
+                                                               const vk::BufferUsageFlags &usage,
+                                                               const std::string &name)
+{
+    return StarBuffers::Buffer::Builder(allocator)
+        .setAllocationCreateInfo(Allocator::AllocationBuilder().setUsage(VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE).build(),
+                                 vk::BufferCreateInfo()
+                                     .setSharingMode(vk::SharingMode::eExclusive)
+                                     .setSize(elementSize * count)
+                                     .setUsage(usage),
+                                 name)
+        .setInstanceCount(count)
+        .setInstanceSize(elementSize)
+        .buildUnique();
+}
+
+/// Place a compacted instance buffer behind a handle so descriptors follow it when it is replaced by a larger one
+static void SetVisibleBuffer(core::device::DeviceContext &context, const Handle &handle, const uint32_t &capacity,
+                             const std::string &name)
+{
+    auto *record = context.getManagerRenderResource().get<StarBuffers::Buffer>(context.getDeviceID(), handle);
+    if (record->resource)
+    {
+        record->resource->cleanupRender(context.getDevice().getVulkanDevice());
+    }
+    record->resource = CreateDeviceBuffer(context.getDevice().getAllocator().get(), capacity, sizeof(glm::mat3x4),
+                                          vk::BufferUsageFlagBits::eStorageBuffer, name);
+}
+
+void GpuCullingPass::prepRender(core::device::DeviceContext &context, const uint8_t &numFramesInFlight,
+                                const std::vector<Handle> &modelHandles, const std::vector<Handle> &normalHandles,
+                                std::vector<vk::DrawIndexedIndirectCommand> draws, const size_t &numInstances)
+{
+    assert(modelHandles.size() == numFramesInFlight && normalHandles.size() == numFramesInFlight &&
+           "Instance buffers are needed for every frame in flight");
+
+    // draws are reset with an inline update every frame, which is limited to 64KB
+    if (draws.empty() || draws.size() > MaxDraws)
+    {
+        STAR_THROW("GPU culling requires at least one draw and no more than fit in a single inline buffer update");
+    }
+    for (auto &draw : draws)
+    {
+        draw.instanceCount = 0;
+        draw.firstInstance = 0;
+    }
+    m_drawTemplate = std::move(draws);
+
+    if (m_capacity == 0)
+    {
+        star::common::casts::SafeCast<size_t, uint32_t>(std::max<size_t>(numInstances, 1), m_capacity);
+    }
+    m_useDrawCount = context.getDevice().isFeatureEnabled(Rendering_Device_Features::draw_indirect_count);
+    m_isValidating = ConfigFile::getInt(Config_Settings::gpu_culling_validation, 0) != 0;
+    m_deviceID = context.getDeviceID();
+
+    uint32_t numDraws = 0;
+    star::common::casts::SafeCast<size_t, uint32_t>(m_drawTemplate.size(), numDraws);
+
+    auto &allocator = context.getDevice().getAllocator().get();
+    const auto indirectUsage = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
+                               vk::BufferUsageFlagBits::eTransferDst;
+
+    m_frames.resize(numFramesInFlight);
+    for (auto &frame : m_frames)
+    {
+        frame.capacity = m_capacity;
+        frame.visibleModels = context.getManagerRenderResource().addRequest(context.getDeviceID());
+        SetVisibleBuffer(context, frame.visibleModels, frame.capacity, "GpuCulling_VisibleModels");
+        frame.visibleNormals = context.getManagerRenderResource().addRequest(context.getDeviceID());
+        SetVisibleBuffer(context, frame.visibleNormals, frame.capacity, "GpuCulling_VisibleNormals");
+
+        frame.draws = CreateDeviceBuffer(allocator, numDraws, DrawCommandStride,
+                                         indirectUsage | vk::BufferUsageFlagBits::eTransferSrc, "GpuCulling_Draws");
+        frame.drawCount = CreateDeviceBuffer(allocator, 1, sizeof(uint32_t), indirectUsage, "GpuCulling_DrawCount");
+
+        if (m_isValidating)
+        {
+            frame.readback =
+                StarBuffers::Buffer::Builder(allocator)
+                    .setAllocationCreateInfo(
+                        Allocator::AllocationBuilder()
+                            .setFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT)
+                            .setUsage(VMA_MEMORY_USAGE_AUTO)
+                            .build(),
+                        vk::BufferCreateInfo()
+                            .setSharingMode(vk::SharingMode::eExclusive)
+                            .setSize(DrawCommandStride)
+                            .setUsage(vk::BufferUsageFlagBits::eTransferDst),
+                        "GpuCulling_Readback")
+                    .setInstanceCount(1)
+                    .setInstanceSize(DrawCommandStride)
+                    .buildUnique();
+        }
+    }
+
+    m_setLayout = StarDescriptorSetLayout::Builder()
+                      .addBinding(0, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                      .addBinding(1, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                      .addBinding(2, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                      .addBinding(3, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                      .addBinding(4, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                      .addBinding(5, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute)
+                      .build();
+    m_setLayout->prepRender(context.getDevice());
+
+    m_descriptorPool = StarDescriptorPool::Builder(context.getDevice())
+                           .setMaxSets(numFramesInFlight)
+                           .addPoolSize(vk::DescriptorType::eStorageBuffer, 6 * numFramesInFlight)
+                           .build();
+
+    auto builder =
+        StarShaderInfo::Builder(context.getDeviceID(), context.getDevice(), *m_descriptorPool, numFramesInFlight);
+    builder.addSetLayout(m_setLayout);
+    for (uint8_t i = 0; i < numFramesInFlight; i++)
+    {
+        builder.startOnFrameIndex(i)
+            .startSet()
+            .add(StarShaderInfo::BufferInfo{modelHandles[i]})
+            .add(StarShaderInfo::BufferInfo{normalHandles[i]})
+            .add(StarShaderInfo::BufferInfo{m_frames[i].visibleModels})
+            .add(StarShaderInfo::BufferInfo{m_frames[i].visibleNormals})
+            .add(StarShaderInfo::BufferInfo{m_frames[i].draws.get()})
+            .add(StarShaderInfo::BufferInfo{m_frames[i].drawCount.get()});
+    }
+    m_shaderInfo = builder.build();
+
+    {
+        const auto pushConstantRange = vk::PushConstantRange()
+                                           .setStageFlags(vk::ShaderStageFlagBits::eCompute)
+                                           .setOffset(0)
+                                           .setSize(sizeof(PushConstants));
+        const vk::DescriptorSetLayout setLayout = m_setLayout->getDescriptorSetLayout();
+
+        m_pipelineLayout = context.getDevice().getVulkanDevice().createPipelineLayout(
+            vk::PipelineLayoutCreateInfo().setSetLayouts(setLayout).setPushConstantRanges(pushConstantRange));
+    }
+
+    // a copy in the media directory takes precedence over the one shipped with the library
+    std::string shaderPath = ConfigFile::getSetting(Config_Settings::mediadirectory) + "/shaders/" + ShaderPath;
+    if (!file_helpers::FileExists(shaderPath))
+    {
+        shaderPath = std::string(STARLIGHT_SHADER_DIRECTORY) + "/" + ShaderPath;
+    }
+    const Handle shader = ShaderResolver::Builder{context.getCmdBus()}
+                              .setShader(Shader_Stage::compute, shaderPath)
+                              .build()
+                              .resolve(Shader_Stage::compute);
+
+    m_pipeline = context.getPipelineManager().submit(core::device::manager::PipelineRequest(StarPipeline(
+        StarPipeline::ComputePipelineConfigSettings(), m_pipelineLayout, std::vector<Handle>{shader})));
+}
+
+void GpuCullingPass::cleanupRender(core::device::DeviceContext &context)
+{
+    // the compacted instance buffers are owned by the render resource manager like every other handle
+    for (auto &frame : m_frames)
+    {
+        frame.draws->cleanupRender(context.getDevice().getVulkanDevice());
+        frame.drawCount->cleanupRender(context.getDevice().getVulkanDevice());
+        if (frame.readback)
+        {
+            frame.readback->cleanupRender(context.getDevice().getVulkanDevice());
+        }
+    }
+    m_frames.clear();
+
+    if (m_shaderInfo)
+    {
+        m_shaderInfo->cleanupRender(context.getDevice());
+        m_shaderInfo.reset();
+    }
+    m_descriptorPool.reset();
+    m_setLayout.reset();
+
+    context.getDevice().getVulkanDevice().destroyPipelineLayout(m_pipelineLayout);
+    m_pipelineLayout = VK_NULL_HANDLE;
+    m_boundPipeline = nullptr;
+}
+
+bool GpuCullingPass::isRenderReady(core::device::DeviceContext &context)
+{
+    if (m_boundPipeline != nullptr)
+    {
+        return true;
+    }
+
+    auto *record = context.getPipelineManager().get(m_pipeline);
+    if (!record->isReady())
+    {
+        return false;
+    }
+
+    m_boundPipeline = &record->request.pipeline;
+    return true;
+}
+
+void GpuCullingPass::frameUpdate(core::device::DeviceContext &context, const uint8_t &frameInFlightIndex,
+                                 const size_t &numInstances)
+{
+    auto &frame = m_frames[frameInFlightIndex];
+
+    if (frame.readback && frame.wasCulled && frame.expectedVisibleCount.has_value())
+    {
+        frame.readback->invalidate();
+
+        vk::DrawIndexedIndirectCommand result{};
+        void *mapped = nullptr;
+        frame.readback->map(&mapped);
+        std::memcpy(&result, mapped, sizeof(result));
+        frame.readback->unmap();
+
+        // instances touching a plane can land on either side through rounding, a consistent difference is a bug
+        if (result.instanceCount != frame.expectedVisibleCount.value() && !m_hasWarnedMismatch)
+        {
+            core::logging::warning("GPU culling found ", result.instanceCount,
+                                   " visible instances where the CPU found ", frame.expectedVisibleCount.value());
+            m_hasWarnedMismatch = true;
+        }
+    }
+    frame.expectedVisibleCount = m_expectedVisibleCount;
+    m_expectedVisibleCount.reset();
+
+    if (numInstances <= frame.capacity)
+    {
+        return;
+    }
+
+    // doubled so an object which keeps gaining instances does not reallocate every frame
+    uint32_t newCapacity = 0;
+    if (!star::common::casts::SafeCast<size_t, uint32_t>(
+            std::max<size_t>(numInstances, static_cast<size_t>(frame.capacity) * 2), newCapacity))
+    {
+        STAR_THROW("GPU culled object has more instances than a buffer can index");
+    }
+
+    core::logging::info("Growing GPU culling buffers from ", frame.capacity, " to ", newCapacity, " instances");
+
+    frame.capacity = newCapacity;
+    SetVisibleBuffer(context, frame.visibleModels, frame.capacity, "GpuCulling_VisibleModels");
+    SetVisibleBuffer(context, frame.visibleNormals, frame.capacity, "GpuCulling_VisibleNormals");
+}
+
+bool GpuCullingPass::recordCullCommands(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
+                                        const size_t &numInstances, const glm::vec3 &localBoundsCenter,
+                                        const glm::vec3 &localBoundsExtent)
+{
+    auto &frame = m_frames[frameInFlightIndex];
+    frame.wasCulled = false;
+
+    if (m_boundPipeline == nullptr || !m_shaderInfo->isReady(frameInFlightIndex))
+    {
+        return false;
+    }
+
+    assert(numInstances <= frame.capacity && "frameUpdate must grow the buffers before culling");
+
+    PushConstants constants;
+    constants.planes = m_planes;
+    constants.boundsCenter = localBoundsCenter;
+    constants.boundsExtent = localBoundsExtent;
+    star::common::casts::SafeCast<size_t, uint32_t>(std::min<size_t>(numInstances, frame.capacity),
+                                                    constants.instanceCount);
+    star::common::casts::SafeCast<size_t, uint32_t>(m_drawTemplate.size(), constants.numDraws);
+
+    commandBuffer.updateBuffer(frame.draws->getVulkanBuffer(), 0, m_drawTemplate.size() * DrawCommandStride,
+                               m_drawTemplate.data());
+    commandBuffer.fillBuffer(frame.drawCount->getVulkanBuffer(), 0, sizeof(uint32_t), 0);
+
+    {
+        const std::array<vk::BufferMemoryBarrier2, 2> barriers{
+            vk::BufferMemoryBarrier2()
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setDstAccessMask(vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite)
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setBuffer(frame.draws->getVulkanBuffer())
+                .setSize(vk::WholeSize),
+            vk::BufferMemoryBarrier2()
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setDstAccessMask(vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite)
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setBuffer(frame.drawCount->getVulkanBuffer())
+                .setSize(vk::WholeSize)};
+        commandBuffer.pipelineBarrier2(vk::DependencyInfo().setBufferMemoryBarriers(barriers));
+    }
+
+    m_boundPipeline->bind(commandBuffer);
+    const auto descriptors = m_shaderInfo->getDescriptors(frameInFlightIndex);
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_pipelineLayout, 0, descriptors, {});
+    commandBuffer.pushConstants(m_pipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(PushConstants),
+                                &constants);
+    if (constants.instanceCount > 0)
+    {
+        commandBuffer.dispatch((constants.instanceCount + WorkgroupSize - 1) / WorkgroupSize, 1, 1);
+    }
+
+    {
+        const std::array<vk::BufferMemoryBarrier2, 4> barriers{
+            vk::BufferMemoryBarrier2()
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setSrcAccessMask(vk::AccessFlagBits2::eShaderStorageWrite)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eDrawIndirect)
+                .setDstAccessMask(vk::AccessFlagBits2::eIndirectCommandRead)
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setBuffer(frame.draws->getVulkanBuffer())
+                .setSize(vk::WholeSize),
+            vk::BufferMemoryBarrier2()
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setSrcAccessMask(vk::AccessFlagBits2::eShaderStorageWrite)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eDrawIndirect)
+                .setDstAccessMask(vk::AccessFlagBits2::eIndirectCommandRead)
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setBuffer(frame.drawCount->getVulkanBuffer())
+                .setSize(vk::WholeSize),
+            vk::BufferMemoryBarrier2()
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setSrcAccessMask(vk::AccessFlagBits2::eShaderStorageWrite)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eVertexShader)
+                .setDstAccessMask(vk::AccessFlagBits2::eShaderStorageRead)
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setBuffer(ManagerRenderResource::getBuffer(m_deviceID, frame.visibleModels).getVulkanBuffer())
+                .setSize(vk::WholeSize),
+            vk::BufferMemoryBarrier2()
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setSrcAccessMask(vk::AccessFlagBits2::eShaderStorageWrite)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eVertexShader)
+                .setDstAccessMask(vk::AccessFlagBits2::eShaderStorageRead)
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setBuffer(ManagerRenderResource::getBuffer(m_deviceID, frame.visibleNormals).getVulkanBuffer())
+                .setSize(vk::WholeSize)};
+        commandBuffer.pipelineBarrier2(vk::DependencyInfo().setBufferMemoryBarriers(barriers));
+    }
+
+    if (frame.readback)
+    {
+        // the visible count lives in the first draw, it is read on the host once the frame comes around again
+        const auto toCopy = vk::BufferMemoryBarrier2()
+                                .setSrcStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                                .setSrcAccessMask(vk::AccessFlagBits2::eShaderStorageWrite)
+                                .setDstStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                                .setDstAccessMask(vk::AccessFlagBits2::eTransferRead)
+                                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                                .setBuffer(frame.draws->getVulkanBuffer())
+                                .setSize(vk::WholeSize);
+        commandBuffer.pipelineBarrier2(vk::DependencyInfo().setBufferMemoryBarriers(toCopy));
+
+        const auto region = vk::BufferCopy().setSrcOffset(0).setDstOffset(0).setSize(DrawCommandStride);
+        commandBuffer.copyBuffer(frame.draws->getVulkanBuffer(), frame.readback->getVulkanBuffer(), region);
+
+        const auto toHost = vk::BufferMemoryBarrier2()
+                                .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                                .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
+                                .setDstStageMask(vk::PipelineStageFlagBits2::eHost)
+                                .setDstAccessMask(vk::AccessFlagBits2::eHostRead)
+                                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                                .setBuffer(frame.readback->getVulkanBuffer())
+                                .setSize(vk::WholeSize);
+        commandBuffer.pipelineBarrier2(vk::DependencyInfo().setBufferMemoryBarriers(toHost));
+    }
+
+    frame.wasCulled = true;
+    return true;
+}
+
+std::vector<service::command_order::ResourceUse> GpuCullingPass::getResourceUses(
+    const uint8_t &frameInFlightIndex) const
+{
+    std::vector<service::command_order::ResourceUse> uses;
+    for (const auto &handle : {m_frames[frameInFlightIndex].visibleModels, m_frames[frameInFlightIndex].visibleNormals})
+    {
+        uses.push_back(service::command_order::ResourceUse{
+            .resource = handle,
+            .type = service::command_order::ResourceUse::Type::buffer,
+            .stages = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader,
+            .access = vk::AccessFlagBits2::eShaderStorageWrite | vk::AccessFlagBits2::eShaderStorageRead,
+            .frameInFlightIndex = frameInFlightIndex});
+    }
+
+    return uses;
+}
+
+void GpuCullingPass::hashRecordState(core::renderer::RecordState &state, const uint8_t &frameInFlightIndex,
+                                     const size_t &numInstances, const glm::vec3 &localBoundsCenter,
+                                     const glm::vec3 &localBoundsExtent)
+{
+    const bool isReady = m_boundPipeline != nullptr && m_shaderInfo->isReady(frameInFlightIndex);
+    state.add(isReady);
+    if (!isReady)
+    {
+        return;
+    }
+
+    // the planes and bounds are recorded as push constants
+    state.add(m_boundPipeline->getVulkanPipeline())
+        .add(std::min<size_t>(numInstances, m_frames[frameInFlightIndex].capacity))
+        .add(m_isValidating);
+    for (const auto &plane : m_planes)
+    {
+        state.add(plane.x).add(plane.y).add(plane.z).add(plane.w);
+    }
+    for (glm::length_t i = 0; i < 3; i++)
+    {
+        state.add(localBoundsCenter[i]).add(localBoundsExtent[i]);
+    }
+    for (const auto &set : m_shaderInfo->getDescriptors(frameInFlightIndex))
+    {
+        state.add(set);
+    }
+    state.add(m_shaderInfo->getNumWrites(frameInFlightIndex));
+}
+
+void GpuCullingPass::recordDraw(vk::CommandBuffer &commandBuffer, const uint8_t &frameInFlightIndex,
+                                const uint32_t &drawIndex) const
+{
+    const auto &frame = m_frames[frameInFlightIndex];
+    if (!frame.wasCulled)
+    {
+        return;
+    }
+
+    const vk::DeviceSize offset = static_cast<vk::DeviceSize>(drawIndex) * DrawCommandStride;
+    if (m_useDrawCount)
+    {
+        // the count stays 0 when nothing survived, so the device skips the draw without reading it
+        commandBuffer.drawIndexedIndirectCount(frame.draws->getVulkanBuffer(), offset,
+                                               frame.drawCount->getVulkanBuffer(), 0, 1, DrawCommandStride);
+    }
+    else
+    {
+        commandBuffer.drawIndexedIndirect(frame.draws->getVulkanBuffer(), offset, 1, DrawCommandStride);
+    }
+}
+} // namespace star
@@ -70,6 +70,21 @@ void StarRenderGroup::frameUpdate(core::device::DeviceContext &context, const ui
     }
 }
 
+CullingStats StarRenderGroup::cullInstances(const Frustum &frustum)
+{
+    CullingStats stats;
+    for (auto &group : groups)
+    {
+        stats += group.baseObject.object->cullInstances(frustum);
+        for (auto &obj : group.objects)
+        {
+            stats += obj.object->cullInstances(frustum);
+        }
+    }
+
+    return stats;
+}
+
 void StarRenderGroup::prepRender(core::device::DeviceContext &context)
 {
     prepareObjects(context);
@@ -80,11 +95,12 @@ void StarRenderGroup::addObject(std::shared_ptr<StarObject> newObject)
     // check if any other object can share the same Pipeline
     Group *targetGroup = nullptr;
 
-    // for now only check if they share the same shader handles
+    // for now only check if they share the same shader handles and vertex input
     for (auto &group : this->groups)
     {
         if (group.baseObject.object->getVertexShaderHandle() == newObject->getVertexShaderHandle() &&
-            group.baseObject.object->getFragmentShaderHandle() == newObject->getFragmentShaderHandle())
+            group.baseObject.object->getFragmentShaderHandle() == newObject->getFragmentShaderHandle() &&
+            group.baseObject.object->getVertexLayout() == newObject->getVertexLayout())
         {
             targetGroup = &group;
             break;
@@ -136,17 +152,27 @@ void StarRenderGroup::addObject(std::shared_ptr<StarObject> newObject)
     this->largestDescriptorSet = combinedSet;
 }
 
-void StarRenderGroup::recordRenderPassCommands(vk::CommandBuffer &mainDrawBuffer, const uint8_t &frameInFlightIndex,
-                                               const uint64_t &frameIndex)
+void StarRenderGroup::hashRecordState(core::renderer::RecordState &state, const uint8_t &frameInFlightIndex,
+                                      const uint64_t &frameIndex)
+{
+    for (auto &group : this->groups)
+    {
+        group.baseObject.object->hashRecordState(state, frameInFlightIndex, frameIndex);
+        for (auto &obj : group.objects)
+        {
+            obj.object->hashRecordState(state, frameInFlightIndex, frameIndex);
+        }
+    }
+}
+
+void StarRenderGroup::collectDraws(DrawList &drawList, const uint8_t &frameInFlightIndex)
 {
     for (auto &group : this->groups)
     {
-        group.baseObject.object->recordRenderPassCommands(mainDrawBuffer, m_pipelineLayout, frameInFlightIndex,
-                                                          frameIndex);
+        group.baseObject.object->collectDraws(drawList, m_pipelineLayout, frameInFlightIndex);
         for (auto &obj : group.objects)
         {
-            // record commands for each object
-            obj.object->recordRenderPassCommands(mainDrawBuffer, m_pipelineLayout, frameInFlightIndex, frameIndex);
+            obj.object->collectDraws(drawList, m_pipelineLayout, frameInFlightIndex);
         }
     }
 }
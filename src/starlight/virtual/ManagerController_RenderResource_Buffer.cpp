@@ -1,2 +1,53 @@
 #include "ManagerController_RenderResource_Buffer.hpp"
 
+#include "logging/LoggingFactory.hpp"
+
+void star::ManagerController::RenderResource::Buffer::prepRender(core::device::DeviceContext &context,
+                                                                 const uint8_t &numFramesInFlight)
+{
+    if (m_resourceHandles.size() != 0)
+    {
+        return;
+    }
+
+    m_resourceHandles.resize(numFramesInFlight);
+    m_isWrittenByHost.resize(numFramesInFlight, false);
+
+    for (uint8_t i = 0; i < numFramesInFlight; i++)
+    {
+        auto request = createTransferRequest(context, i);
+
+        auto handle = context.getManagerRenderResource().addHostWrittenRequest(context.getDeviceID(), i, *request);
+        if (handle.has_value())
+        {
+            m_resourceHandles[i] = handle.value();
+            m_isWrittenByHost[i] = true;
+        }
+        else
+        {
+            m_resourceHandles[i] =
+                context.getManagerRenderResource().addRequest(context.getDeviceID(), std::move(request), nullptr, true);
+        }
+    }
+}
+
+bool star::ManagerController::RenderResource::Buffer::isWrittenByHost(const uint8_t &frameInFlightIndex) const
+{
+    return frameInFlightIndex < m_isWrittenByHost.size() && m_isWrittenByHost[frameInFlightIndex];
+}
+
+bool star::ManagerController::RenderResource::Buffer::writeFromHost(core::device::DeviceContext &context,
+                                                                    const size_t &frameInFlightIndex,
+                                                                    const TransferRequest::Buffer &request)
+{
+    if (context.getManagerRenderResource().writeFromHost(context.getDeviceID(), request,
+                                                         m_resourceHandles[frameInFlightIndex]))
+    {
+        return true;
+    }
+
+    // data outgrew its slot in the ring, this frame in flight moves to device local memory for good
+    core::logging::info("Render resource outgrew the host visible frame ring. Falling back to transfer queue uploads");
+    m_isWrittenByHost[frameInFlightIndex] = false;
+    return false;
+}
@@ -18,11 +18,21 @@ void star::StarMaterial::bind(vk::CommandBuffer &commandBuffer, vk::PipelineLayo
                               int swapChainImageIndex)
 {
     // bind the descriptor sets for the given image index
-    auto descriptors = this->shaderInfo->getDescriptors(swapChainImageIndex);
+    auto descriptors = getDescriptorSets(static_cast<uint8_t>(swapChainImageIndex));
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0, descriptors.size(),
                                      descriptors.data(), 0, nullptr);
 }
 
+std::vector<vk::DescriptorSet> star::StarMaterial::getDescriptorSets(const uint8_t &frameInFlightIndex)
+{
+    return this->shaderInfo->getDescriptors(frameInFlightIndex);
+}
+
+size_t star::StarMaterial::getNumDescriptorWrites(const uint8_t &frameInFlightIndex) const
+{
+    return this->shaderInfo->getNumWrites(frameInFlightIndex);
+}
+
 bool star::StarMaterial::isKnownToBeReady(const uint8_t &frameInFlightIndex)
 {
     return this->shaderInfo->isReady(frameInFlightIndex);
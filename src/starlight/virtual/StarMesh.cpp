@@ -1,5 +1,7 @@
 #include "StarMesh.hpp"
 
+#include "VulkanVertex.hpp"
+
 namespace star
 {
 static void CalcBoundingBox(const std::vector<star::Vertex> &verts, glm::vec3 &upperBoundingBoxCoord,
@@ -29,17 +31,19 @@ static void CalcBoundingBox(const std::vector<star::Vertex> &verts, glm::vec3 &u
     upperBoundingBoxCoord = max;
 }
 
-StarMesh::StarMesh(const Handle &vertBuffer, const Handle &indBuffer, std::vector<Vertex> &vertices,
-                   std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material, bool hasAdjacenciesPacked)
+StarMesh::StarMesh(const Handle &vertBuffer, const Handle &indBuffer, const std::vector<Vertex> &vertices,
+                   const std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material,
+                   bool hasAdjacenciesPacked, vk::IndexType indexType, Vertex_Layout vertexLayout)
     : material(std::move(material)), hasAdjacenciesPacked(hasAdjacenciesPacked), triangular(indices.size() % 3 == 0),
       numVerts(star::common::casts::size_t_to_unsigned_int(vertices.size())),
-      numInds(star::common::casts::size_t_to_unsigned_int(indices.size())), vertBuffer(vertBuffer), indBuffer(indBuffer)
+      numInds(star::common::casts::size_t_to_unsigned_int(indices.size())), vertBuffer(vertBuffer), indBuffer(indBuffer),
+      m_indexType(indexType), m_vertexLayout(vertexLayout)
 {
     CalcBoundingBox(vertices, this->aaboundingBoxBounds[1], this->aaboundingBoxBounds[0]);
 }
 
-StarMesh::StarMesh(const Handle &vertBuffer, const Handle &indBuffer, std::vector<Vertex> &vertices,
-                   std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material,
+StarMesh::StarMesh(const Handle &vertBuffer, const Handle &indBuffer, const std::vector<Vertex> &vertices,
+                   const std::vector<uint32_t> &indices, std::shared_ptr<StarMaterial> material,
                    const glm::vec3 &boundBoxMinCoord, const glm::vec3 &boundBoxMaxCoord, bool packAdjacencies)
     : material(std::move(material)), hasAdjacenciesPacked(packAdjacencies), triangular(indices.size() % 3 == 0),
       aaboundingBoxBounds{boundBoxMinCoord, boundBoxMaxCoord},
@@ -71,17 +75,45 @@ bool star::StarMesh::isKnownToBeReady(const uint8_t &frameInFlightIndex)
     return false;
 }
 
-void star::StarMesh::recordRenderPassCommands(vk::CommandBuffer &commandBuffer, vk::PipelineLayout &pipelineLayout,
-                                              const uint8_t &frameInFlightIndex, const uint32_t &instanceCount)
+void star::StarMesh::bindVertexBuffers(vk::CommandBuffer &commandBuffer) const
 {
+    bindVertexBuffers(commandBuffer, getVertexBuffer());
+}
 
-    this->material->bind(commandBuffer, pipelineLayout, frameInFlightIndex);
-
+void star::StarMesh::bindVertexBuffers(vk::CommandBuffer &commandBuffer, const vk::Buffer &vertexBuffer) const
+{
     vk::DeviceSize offset{0};
-    auto &vBuff = ManagerRenderResource::getBuffer(m_deviceID, this->vertBuffer);
-    auto &iBuff = ManagerRenderResource::getBuffer(m_deviceID, this->indBuffer);
-    commandBuffer.bindVertexBuffers(0, vBuff.getVulkanBuffer(), offset);
-    commandBuffer.bindIndexBuffer(iBuff.getVulkanBuffer(), offset, vk::IndexType::eUint32);
-    commandBuffer.drawIndexed(this->numInds, instanceCount, 0, 0, 0);
+    if (m_vertexLayout == Vertex_Layout::compact)
+    {
+        // material constants live at the end of the same buffer and are read through the second binding
+        const std::array<vk::Buffer, 2> buffers{vertexBuffer, vertexBuffer};
+        const std::array<vk::DeviceSize, 2> offsets{offset,
+                                                    VertexInputDescription::GetMaterialConstantsOffset(this->numVerts)};
+        commandBuffer.bindVertexBuffers(0, buffers, offsets);
+    }
+    else
+    {
+        commandBuffer.bindVertexBuffers(0, vertexBuffer, offset);
+    }
+}
+
+void star::StarMesh::bindIndexBuffer(vk::CommandBuffer &commandBuffer) const
+{
+    bindIndexBuffer(commandBuffer, getIndexBuffer());
+}
+
+void star::StarMesh::bindIndexBuffer(vk::CommandBuffer &commandBuffer, const vk::Buffer &indexBuffer) const
+{
+    commandBuffer.bindIndexBuffer(indexBuffer, 0, m_indexType);
+}
+
+vk::Buffer star::StarMesh::getVertexBuffer() const
+{
+    return ManagerRenderResource::getBuffer(m_deviceID, this->vertBuffer).getVulkanBuffer();
+}
+
+vk::Buffer star::StarMesh::getIndexBuffer() const
+{
+    return ManagerRenderResource::getBuffer(m_deviceID, this->indBuffer).getVulkanBuffer();
 }
 } // namespace star
\ No newline at end of file
@@ -1,5 +1,16 @@
 #include "StarPipeline.hpp"
 
+#include <type_traits>
+
+namespace
+{
+template <typename T> void AppendState(std::string &key, const T &value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be appended to a state key");
+    key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+} // namespace
+
 vk::ShaderModule star::StarPipeline::CreateShaderModule(vk::Device &device, const std::vector<uint32_t> &sourceCode)
 {
     vk::ShaderModuleCreateInfo createInfo{};
@@ -93,17 +104,17 @@ vk::Pipeline star::StarPipeline::BuildGraphicsPipeline(vk::Device &device, const
         shaderStages.push_back(geomShaderStageInfo);
     }
 
-    auto attributeDescriptions = VulkanVertex::getAttributeDescriptions();
+    const auto vertexInput = VertexInputDescription::FromLayout(pipelineSettings.vertexLayout);
 
     GraphicsPipelineConfigSettings defaultConfig = GraphicsPipelineConfigSettings();
     DefaultGraphicsPipelineConfigInfo(defaultConfig, depdencies.swapChainExtent, depdencies.renderingTargetInfo);
 
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = vk::StructureType::ePipelineVertexInputStateCreateInfo;
-    vertexInputInfo.vertexBindingDescriptionCount = defaultConfig.vertInputBindingDescription.size();
-    vertexInputInfo.pVertexBindingDescriptions = defaultConfig.vertInputBindingDescription.data();
-    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexInput.bindings.size());
+    vertexInputInfo.pVertexBindingDescriptions = vertexInput.bindings.data();
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInput.attributes.size());
+    vertexInputInfo.pVertexAttributeDescriptions = vertexInput.attributes.data();
 
     vk::PipelineRenderingCreateInfoKHR renderingCreateInfo{};
     renderingCreateInfo.pNext = VK_NULL_HANDLE;
@@ -161,10 +172,9 @@ vk::Pipeline star::StarPipeline::BuildGraphicsPipeline(vk::Device &device, const
     pipelineInfo.pNext = &renderingCreateInfo;
 
     // finally creating the pipeline -- this call has the capability of creating multiple pipelines in one call
-    // 2nd arg is set to null -> normally for graphics pipeline cache (can be used to store and reuse data relevant to
-    // pipeline creation across multiple calls to vkCreateGraphicsPipeline)
+    // 1st arg is the pipeline cache, which lets the driver reuse work from earlier builds and previous runs
 
-    auto result = device.createGraphicsPipelines(VK_NULL_HANDLE, pipelineInfo);
+    auto result = device.createGraphicsPipelines(depdencies.pipelineCache, pipelineInfo);
     if (result.result != vk::Result::eSuccess)
     {
         throw std::runtime_error("failed to create graphics pipeline");
@@ -207,7 +217,7 @@ vk::Pipeline star::StarPipeline::BuildComputePipeline(vk::Device &device, const
     createInfo.layout = pipelineLayout;
     createInfo.stage = compShaderStageInfo;
 
-    auto result = device.createComputePipeline(VK_NULL_HANDLE, createInfo);
+    auto result = device.createComputePipeline(deps.pipelineCache, createInfo);
     if (result.result != vk::Result::eSuccess)
     {
         throw std::runtime_error("failed to create compute pipeline");
@@ -234,6 +244,92 @@ vk::Pipeline star::StarPipeline::buildPipeline(vk::Device &device, const RenderR
     }
 }
 
+std::string star::StarPipeline::getStateKey(const vk::Extent2D &resolution,
+                                            const core::renderer::RenderingTargetInfo &renderingInfo) const
+{
+    std::string key;
+
+    AppendState(key, m_isGraphicsPipeline);
+    AppendState(key, static_cast<VkPipelineLayout>(m_pipelineLayout));
+
+    // the shader manager hands out one handle per distinct shader, so the handles stand in for the code
+    AppendState(key, m_shaders.size());
+    for (const auto &shader : m_shaders)
+    {
+        AppendState(key, shader.getType());
+        AppendState(key, shader.getID());
+    }
+
+    if (!m_isGraphicsPipeline)
+    {
+        return key;
+    }
+
+    AppendState(key, resolution);
+    AppendState(key, renderingInfo.colorAttachmentFormats.size());
+    for (const auto &format : renderingInfo.colorAttachmentFormats)
+    {
+        AppendState(key, format);
+    }
+    AppendState(key, renderingInfo.depthAttachmentFormat.value_or(vk::Format::eUndefined));
+    AppendState(key, renderingInfo.stencilAttachmentFormat.value_or(vk::Format::eUndefined));
+
+    // all of the fixed function state in the config is part of the key, not only the parts the build reads today, so
+    // honoring more of it later can not merge pipelines which differ
+    const auto &config = std::get<GraphicsPipelineConfigSettings>(m_configSettings);
+    AppendState(key, config.vertexLayout);
+    AppendState(key, config.subpass);
+
+    AppendState(key, config.inputAssemblyInfo.topology);
+    AppendState(key, config.inputAssemblyInfo.primitiveRestartEnable);
+
+    const auto &rasterization = config.rasterizationInfo;
+    AppendState(key, rasterization.depthClampEnable);
+    AppendState(key, rasterization.rasterizerDiscardEnable);
+    AppendState(key, rasterization.polygonMode);
+    AppendState(key, rasterization.cullMode);
+    AppendState(key, rasterization.frontFace);
+    AppendState(key, rasterization.depthBiasEnable);
+    AppendState(key, rasterization.depthBiasConstantFactor);
+    AppendState(key, rasterization.depthBiasClamp);
+    AppendState(key, rasterization.depthBiasSlopeFactor);
+    AppendState(key, rasterization.lineWidth);
+
+    const auto &multisample = config.multisampleInfo;
+    AppendState(key, multisample.rasterizationSamples);
+    AppendState(key, multisample.sampleShadingEnable);
+    AppendState(key, multisample.minSampleShading);
+    AppendState(key, multisample.alphaToCoverageEnable);
+    AppendState(key, multisample.alphaToOneEnable);
+
+    AppendState(key, config.colorBlendAttachment);
+    AppendState(key, config.colorBlendInfo.logicOpEnable);
+    AppendState(key, config.colorBlendInfo.logicOp);
+    for (const float &constant : config.colorBlendInfo.blendConstants)
+    {
+        AppendState(key, constant);
+    }
+
+    const auto &depthStencil = config.depthStencilInfo;
+    AppendState(key, depthStencil.depthTestEnable);
+    AppendState(key, depthStencil.depthWriteEnable);
+    AppendState(key, depthStencil.depthCompareOp);
+    AppendState(key, depthStencil.depthBoundsTestEnable);
+    AppendState(key, depthStencil.stencilTestEnable);
+    AppendState(key, depthStencil.front);
+    AppendState(key, depthStencil.back);
+    AppendState(key, depthStencil.minDepthBounds);
+    AppendState(key, depthStencil.maxDepthBounds);
+
+    AppendState(key, config.dynamicStateEnables.size());
+    for (const auto &state : config.dynamicStateEnables)
+    {
+        AppendState(key, state);
+    }
+
+    return key;
+}
+
 bool star::StarPipeline::isSame(StarPipeline &compPipe)
 {
     return m_shaders.size() == compPipe.m_shaders.size() && hasSameShadersAs(compPipe);
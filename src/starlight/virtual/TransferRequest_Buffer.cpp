@@ -10,9 +10,28 @@ void star::TransferRequest::Buffer::DefaultCopy(StarBuffers::Buffer &srcBuffer,
                                                 vk::CommandBuffer &commandBuffer)
 {
     vk::BufferCopy copyRegion{};
-    copyRegion.srcOffset = 0;
-    copyRegion.dstOffset = 0;
+    copyRegion.srcOffset = srcBuffer.getRangeOffset();
+    copyRegion.dstOffset = dstBuffer.getRangeOffset();
     copyRegion.size = srcBuffer.getBufferSize();
 
     commandBuffer.copyBuffer(srcBuffer.getVulkanBuffer(), dstBuffer.getVulkanBuffer(), copyRegion);
-}
\ No newline at end of file
+}
+
+std::unique_ptr<star::StarBuffers::Buffer> star::TransferRequest::Buffer::CreateStagingBuffer(
+    VmaAllocator &allocator, const StagingLayout &layout, const std::string &name)
+{
+    return StarBuffers::Buffer::Builder(allocator)
+        .setAllocationCreateInfo(
+            Allocator::AllocationBuilder()
+                .setFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT)
+                .setUsage(VMA_MEMORY_USAGE_AUTO)
+                .build(),
+            vk::BufferCreateInfo()
+                .setSharingMode(vk::SharingMode::eExclusive)
+                .setSize(layout.size)
+                .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
+            name)
+        .setInstanceCount(layout.instanceCount)
+        .setInstanceSize(layout.instanceSize)
+        .buildUnique();
+}
@@ -28,6 +28,11 @@ void StarBuffers::Buffer::map(void **mapped) const
            "Called map on buffer before creation");
 
     vmaMapMemory(this->resources->allocator, this->resources->memory, mapped);
+
+    if (m_isView)
+    {
+        *mapped = static_cast<char *>(*mapped) + m_rangeOffset;
+    }
 }
 
 void StarBuffers::Buffer::unmap() const
@@ -54,19 +59,25 @@ void StarBuffers::Buffer::writeToBuffer(void *data, void *mapped, const vk::Devi
 
 vk::Result StarBuffers::Buffer::invalidate(const vk::DeviceSize &size, const vk::DeviceSize &offset) const
 {
-    auto result = vmaInvalidateAllocation(this->resources->allocator, this->resources->memory, offset, size);
+    const vk::DeviceSize rangeSize = m_isView && size == vk::WholeSize ? this->size : size;
+    auto result = vmaInvalidateAllocation(this->resources->allocator, this->resources->memory,
+                                          m_rangeOffset + offset, rangeSize);
     return vk::Result(result);
 }
 
 vk::Result StarBuffers::Buffer::flush(const vk::DeviceSize &size, const vk::DeviceSize &offset) const
 {
-    auto result = vmaFlushAllocation(this->resources->allocator, this->resources->memory, offset, size);
+    const vk::DeviceSize rangeSize = m_isView && size == vk::WholeSize ? this->size : size;
+    auto result =
+        vmaFlushAllocation(this->resources->allocator, this->resources->memory, m_rangeOffset + offset, rangeSize);
     return vk::Result(result);
 }
 
-vk::DescriptorBufferInfo StarBuffers::Buffer::descriptorInfo(const vk::DeviceSize &size, const vk::DeviceSize &offset)
+vk::DescriptorBufferInfo StarBuffers::Buffer::descriptorInfo(const vk::DeviceSize &size,
+                                                             const vk::DeviceSize &offset) const
 {
-    return vk::DescriptorBufferInfo{this->resources->buffer, offset, size};
+    const vk::DeviceSize rangeSize = m_isView && size == vk::WholeSize ? this->size : size;
+    return vk::DescriptorBufferInfo{this->resources->buffer, m_rangeOffset + offset, rangeSize};
 }
 
 void StarBuffers::Buffer::writeToIndex(void *data, void *mapped, const size_t &index)
@@ -79,7 +90,7 @@ vk::Result StarBuffers::Buffer::flushIndex(const size_t &index)
     return flush(m_alignmentSize, index * m_alignmentSize);
 }
 
-vk::DescriptorBufferInfo StarBuffers::Buffer::descriptorInfoForIndex(const size_t &index)
+vk::DescriptorBufferInfo StarBuffers::Buffer::descriptorInfoForIndex(const size_t &index) const
 {
     return descriptorInfo(m_alignmentSize, index * m_alignmentSize);
 }
@@ -99,6 +110,30 @@ StarBuffers::Buffer::Buffer(VmaAllocator &allocator, const uint32_t &requestedIn
     this->resources = CreateBuffer(allocator, allocCreateInfo, bufferCreateInfo, this->size, this->offset, allocName);
 }
 
+std::unique_ptr<StarBuffers::Buffer> StarBuffers::Buffer::CreateView(std::shared_ptr<Resources> resources,
+                                                                    const vk::BufferUsageFlags &usageFlags,
+                                                                    const vk::DeviceSize &rangeOffset,
+                                                                    const vk::DeviceSize &rangeSize,
+                                                                    const uint32_t &instanceCount,
+                                                                    const vk::DeviceSize &instanceSize,
+                                                                    const vk::DeviceSize &minOffsetAlignment)
+{
+    assert(resources && rangeSize != 0 && instanceCount != 0 && instanceSize != 0);
+
+    auto view = std::make_unique<StarBuffers::Buffer>();
+    view->resources = std::move(resources);
+    view->size = rangeSize;
+    view->offset = 0;
+    view->instanceSize = instanceSize;
+    view->instanceCount = instanceCount;
+    view->m_alignmentSize = GetAlignment(instanceSize, minOffsetAlignment);
+    view->usageFlags = usageFlags;
+    view->m_rangeOffset = rangeOffset;
+    view->m_isView = true;
+
+    return view;
+}
+
 std::string StarBuffers::Buffer::AllocationName(const std::string &allocationName)
 {
     return allocationName + "_BUFFER";
@@ -134,7 +169,12 @@ void StarBuffers::Buffer::cleanupRender(vk::Device &device)
 {
     (void)device;
 
-    if (resources)
+    if (m_isView)
+    {
+        // the owner of the full buffer is responsible for destroying it
+        resources.reset();
+    }
+    else if (resources)
     {
         resources->cleanupRender();
     }
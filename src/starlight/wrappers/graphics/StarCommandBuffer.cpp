@@ -2,6 +2,19 @@
 
 #include <star_common/helper/CastHelpers.hpp>
 
+namespace
+{
+vk::PipelineStageFlags2 ToStageFlags2(const vk::PipelineStageFlags &stages)
+{
+    // the original stage bits keep their values in the extended flags, an empty wait stage waits on nothing
+    if (!stages)
+    {
+        return vk::PipelineStageFlagBits2::eAllCommands;
+    }
+    return vk::PipelineStageFlags2(static_cast<VkPipelineStageFlags2>(static_cast<VkPipelineStageFlags>(stages)));
+}
+} // namespace
+
 star::StarCommandBuffer::StarCommandBuffer(vk::Device device, int numBuffersToCreate, const StarCommandPool *parentPool,
                                            const Queue_Type type, bool initFences, bool initSemaphores)
     : vulkanDevice(device), parentPool(parentPool), type(type)
@@ -13,6 +26,8 @@ void star::StarCommandBuffer::prepRender(vk::Device vulkanDevice, const StarComm
                                          int numBuffersToCreate, bool initFences, bool initSemaphores)
 {
     this->waitSemaphores.resize(numBuffersToCreate);
+    m_recordedStates.assign(numBuffersToCreate, std::nullopt);
+    m_submissionFences.assign(numBuffersToCreate, std::nullopt);
     vk::CommandBufferAllocateInfo allocateInfo = vk::CommandBufferAllocateInfo()
                                                      .setCommandPool(parentPool->getVulkanCommandPool())
                                                      .setLevel(vk::CommandBufferLevel::ePrimary)
@@ -63,6 +78,8 @@ void star::StarCommandBuffer::begin(int buffIndex)
     if (this->readyFence.size() > 0)
         wait(buffIndex);
 
+    m_recordedStates[buffIndex] = std::nullopt;
+
     vk::CommandBufferBeginInfo beginInfo{};
     beginInfo.sType = vk::StructureType::eCommandBufferBeginInfo;
 
@@ -92,6 +109,7 @@ void star::StarCommandBuffer::begin(const int buffIndex, const vk::CommandBuffer
         wait(buffIndex);
 
     this->recorded = true;
+    m_recordedStates[buffIndex] = std::nullopt;
 
     // create begin
     this->commandBuffers[buffIndex].begin(beginInfo);
@@ -130,20 +148,24 @@ void star::StarCommandBuffer::reset(int bufferIndex)
     assert(bufferIndex < this->commandBuffers.size() && "Requested buffer does not exist");
 
     // wait for fence before reset
-    {
-        auto result = this->vulkanDevice.waitForFences(this->readyFence[bufferIndex], VK_TRUE, UINT64_MAX);
-        if (result != vk::Result::eSuccess)
-        {
-            throw std::runtime_error("Failed to wait for fence");
-        }
-    }
+    waitForLastSubmission(bufferIndex);
 
     // reset vulkan buffers
     this->commandBuffers.at(bufferIndex).reset();
+    m_recordedStates[bufferIndex] = std::nullopt;
 
     this->recorded = false;
 }
 
+void star::StarCommandBuffer::reuse(const int &bufferIndex)
+{
+    assert(bufferIndex < this->commandBuffers.size() && "Requested buffer does not exist");
+    assert(m_recordedStates[bufferIndex].has_value() && "Buffer has no recorded commands to reuse");
+
+    if (this->readyFence.size() > 0)
+        wait(bufferIndex);
+}
+
 void star::StarCommandBuffer::submit(int bufferIndex, vk::Queue &targetQueue,
                                      std::vector<std::pair<vk::Semaphore, vk::PipelineStageFlags>> *overrideWait,
                                      std::vector<std::optional<uint64_t>> *additionalWaitsSignaledValues,
@@ -224,6 +246,7 @@ void star::StarCommandBuffer::submit(int bufferIndex, vk::Queue &targetQueue,
     else if (this->readyFence.size() > 0)
     {
         targetQueue.submit(submitInfo, this->readyFence.at(bufferIndex));
+        m_isFenceAwaitingSubmit[bufferIndex] = false;
     }
     else
     {
@@ -231,8 +254,60 @@ void star::StarCommandBuffer::submit(int bufferIndex, vk::Queue &targetQueue,
     }
 }
 
+void star::StarCommandBuffer::appendSubmitInfo(
+    const int &bufferIndex, const std::vector<std::pair<vk::Semaphore, vk::PipelineStageFlags>> *additionalWaits,
+    const std::vector<std::optional<uint64_t>> *additionalWaitsSignaledValues,
+    std::vector<vk::SemaphoreSubmitInfo> &waits, std::vector<vk::SemaphoreSubmitInfo> &signals) const
+{
+    if (additionalWaits != nullptr)
+    {
+        for (size_t i{0}; i < additionalWaits->size(); i++)
+        {
+            // the value is ignored for binary semaphores
+            const auto &value = additionalWaitsSignaledValues->at(i);
+            waits.push_back(vk::SemaphoreSubmitInfo()
+                                .setSemaphore(additionalWaits->at(i).first)
+                                .setValue(value.has_value() ? value.value() : 0)
+                                .setStageMask(ToStageFlags2(additionalWaits->at(i).second)));
+        }
+    }
+
+    for (const auto &waitInfo : this->waitSemaphores.at(bufferIndex))
+    {
+        waits.push_back(
+            vk::SemaphoreSubmitInfo().setSemaphore(waitInfo.first).setStageMask(ToStageFlags2(waitInfo.second)));
+    }
+
+    if (this->completeSemaphores.size() > 0)
+    {
+        signals.push_back(vk::SemaphoreSubmitInfo()
+                              .setSemaphore(this->completeSemaphores.at(bufferIndex))
+                              .setStageMask(vk::PipelineStageFlagBits2::eAllCommands));
+    }
+}
+
+void star::StarCommandBuffer::setSubmissionFence(const int &bufferIndex, const vk::Fence &fence)
+{
+    m_submissionFences.at(bufferIndex) = fence;
+}
+
+void star::StarCommandBuffer::releaseSubmissionFence(const int &bufferIndex, const vk::Fence &fence)
+{
+    auto &submissionFence = m_submissionFences.at(bufferIndex);
+    if (submissionFence.has_value() && submissionFence.value() == fence)
+    {
+        submissionFence = vk::Fence{VK_NULL_HANDLE};
+    }
+}
+
 bool star::StarCommandBuffer::isFenceReady(const int &bufferIndex)
 {
+    if (m_submissionFences[bufferIndex].has_value())
+    {
+        const vk::Fence &fence = m_submissionFences[bufferIndex].value();
+        return !fence || this->vulkanDevice.getFenceStatus(fence) == vk::Result::eSuccess;
+    }
+
     assert(this->readyFence.size() > 0 && "No fences created");
 
     const auto result = this->vulkanDevice.getFenceStatus(this->readyFence.at(bufferIndex));
@@ -251,6 +326,18 @@ std::vector<vk::Semaphore> &star::StarCommandBuffer::getCompleteSemaphores()
 
 void star::StarCommandBuffer::wait(int bufferIndex)
 {
+    if (m_submissionFences[bufferIndex].has_value())
+    {
+        // the ready fence was already reset by the begin before that submission
+        const vk::Fence fence = m_submissionFences[bufferIndex].value();
+        if (fence && this->vulkanDevice.waitForFences(fence, VK_TRUE, UINT64_MAX) != vk::Result::eSuccess)
+        {
+            throw std::runtime_error("Failed to wait for fence");
+        }
+        m_submissionFences[bufferIndex] = std::nullopt;
+        return;
+    }
+
     if (this->readyFence.size() > 0)
     {
         auto result = this->vulkanDevice.waitForFences(this->readyFence.at(bufferIndex), VK_TRUE, UINT64_MAX);
@@ -261,6 +348,31 @@ void star::StarCommandBuffer::wait(int bufferIndex)
         }
 
         this->vulkanDevice.resetFences(this->readyFence[bufferIndex]);
+        m_isFenceAwaitingSubmit[bufferIndex] = true;
+    }
+}
+
+void star::StarCommandBuffer::waitForLastSubmission(const int &bufferIndex)
+{
+    if (m_submissionFences[bufferIndex].has_value())
+    {
+        const vk::Fence &fence = m_submissionFences[bufferIndex].value();
+        if (fence && this->vulkanDevice.waitForFences(fence, VK_TRUE, UINT64_MAX) != vk::Result::eSuccess)
+        {
+            throw std::runtime_error("Failed to wait for fence");
+        }
+        return;
+    }
+
+    if (this->readyFence.size() == 0 || m_isFenceAwaitingSubmit[bufferIndex])
+    {
+        return;
+    }
+
+    auto result = this->vulkanDevice.waitForFences(this->readyFence.at(bufferIndex), VK_TRUE, UINT64_MAX);
+    if (result != vk::Result::eSuccess)
+    {
+        throw std::runtime_error("Failed to wait for fence");
     }
 }
 
@@ -286,6 +398,7 @@ void star::StarCommandBuffer::createTracking()
 void star::StarCommandBuffer::createFences()
 {
     this->readyFence.resize(this->commandBuffers.size());
+    m_isFenceAwaitingSubmit.assign(this->commandBuffers.size(), false);
 
     vk::FenceCreateInfo fenceInfo{};
     fenceInfo.sType = vk::StructureType::eFenceCreateInfo;
@@ -45,13 +45,13 @@ void star::StarShaderInfo::ShaderInfoSet::buildIndex(const star::Handle &deviceI
             }
             const auto &buffer = ManagerRenderResource::getBuffer(deviceID, info.handle.value());
 
-            auto bufferInfo = vk::DescriptorBufferInfo{buffer.getVulkanBuffer(), 0, buffer.getBufferSize()};
+            // buffers placed in shared memory only own a range of the underlying vulkan buffer
+            auto bufferInfo = buffer.descriptorInfo(buffer.getBufferSize());
             this->descriptorWriter->writeBuffer(index, bufferInfo);
         }
         else if (info.buffer.has_value())
         {
-            auto bufferInfo = vk::DescriptorBufferInfo{info.buffer.value()->getVulkanBuffer(), 0,
-                                                       info.buffer.value()->getBufferSize()};
+            auto bufferInfo = info.buffer.value()->descriptorInfo(info.buffer.value()->getBufferSize());
             this->descriptorWriter->writeBuffer(index, bufferInfo);
         }
         else
@@ -87,6 +87,9 @@ void star::StarShaderInfo::ShaderInfoSet::buildIndex(const star::Handle &deviceI
 
         this->descriptorWriter->writeImage(index, textureInfo);
     }
+
+    // the set is overwritten in place, so the new binding only reaches the gpu through a rebuild
+    this->setNeedsRebuild = true;
 }
 
 void star::StarShaderInfo::ShaderInfoSet::build(const star::Handle &deviceID)
@@ -110,6 +113,7 @@ void star::StarShaderInfo::ShaderInfoSet::rebuildSet()
 
     this->descriptorSet = std::make_shared<vk::DescriptorSet>(this->descriptorWriter->build());
     this->setNeedsRebuild = false;
+    this->m_numWrites++;
 }
 
 bool star::StarShaderInfo::isReady(uint8_t frameInFlight)
@@ -161,6 +165,20 @@ void star::StarShaderInfo::cleanupRender(core::device::StarDevice &device)
     }
 }
 
+size_t star::StarShaderInfo::getNumWrites(uint8_t frameInFlight) const
+{
+    assert(static_cast<size_t>(frameInFlight) < shaderInfoSets.size() &&
+           "Requested frameInFlight is beyond size of createdSets");
+
+    size_t numWrites = 0;
+    for (const auto &set : this->shaderInfoSets[static_cast<size_t>(frameInFlight)])
+    {
+        numWrites += set->getNumWrites();
+    }
+
+    return numWrites;
+}
+
 std::vector<vk::DescriptorSet> star::StarShaderInfo::getDescriptors(uint8_t frameInFlight)
 {
     assert(static_cast<size_t>(frameInFlight) < shaderInfoSets.size() &&
@@ -174,15 +192,15 @@ std::vector<vk::DescriptorSet> star::StarShaderInfo::getDescriptors(uint8_t fram
         {
             for (size_t i{0}; i < set->shaderInfos.size(); i++)
             {
-                if (set->shaderInfos[0].bufferInfo.has_value() &&
-                    set->shaderInfos[0].bufferInfo.value().handle.has_value())
+                if (set->shaderInfos[i].bufferInfo.has_value() &&
+                    set->shaderInfos[i].bufferInfo.value().handle.has_value())
                 {
                     // check if buffer has changed
-                    auto &info = set->shaderInfos[0].bufferInfo.value();
-                    auto &handle = set->shaderInfos[0].bufferInfo.value().handle.value();
+                    auto &info = set->shaderInfos[i].bufferInfo.value();
+                    auto &handle = set->shaderInfos[i].bufferInfo.value().handle.value();
 
                     const auto &buffer = ManagerRenderResource::getBuffer(m_deviceID, handle).getVulkanBuffer();
-                    if (info.currentBuffer != VK_NULL_HANDLE || info.currentBuffer != buffer)
+                    if (info.currentBuffer != buffer)
                     {
                         info.currentBuffer = buffer;
                         set->buildIndex(m_deviceID, i);